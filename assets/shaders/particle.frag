@@ -0,0 +1,13 @@
+#version 330 core
+out vec4 FragColor;
+
+uniform vec3 particleColor;
+uniform float opacity;
+
+void main() {
+    // Round, soft-edged points
+    vec2 d = gl_PointCoord * 2.0 - 1.0;
+    float r2 = dot(d, d);
+    if (r2 > 1.0) discard;
+    FragColor = vec4(particleColor, opacity * (1.0 - r2));
+}
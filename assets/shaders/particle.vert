@@ -0,0 +1,51 @@
+#version 330 core
+layout (location = 0) in vec4 aElements0;   // a, e, i, period
+layout (location = 1) in vec4 aElements1;   // M0, node, argument of periapsis, size
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform vec3 center;        // Parent body position (unscaled)
+uniform float time;         // Simulation time in years
+uniform float pointSize;
+
+flat out uint vElementIndex;   // For the ID picking pass
+
+const float TWO_PI = 6.28318530718;
+
+void main() {
+    float a = aElements0.x;
+    float e = aElements0.y;
+    float inc = aElements0.z;
+    float period = aElements0.w;
+
+    // Mean anomaly, then a few Newton steps on Kepler's equation
+    // (populations are near-circular, so this converges quickly)
+    float M = mod(aElements1.x + TWO_PI * time / period, TWO_PI);
+    float E = M + e * sin(M);
+    for (int k = 0; k < 4; ++k) {
+        E -= (E - e * sin(E) - M) / (1.0 - e * cos(E));
+    }
+
+    // Position in the orbital plane, periapsis along +x
+    float xo = a * (cos(E) - e);
+    float yo = a * sqrt(1.0 - e * e) * sin(E);
+
+    // Rotate to the argument of latitude, then by inclination and node
+    // (same convention as OrbitModel::calculatePosition)
+    float cw = cos(aElements1.z), sw = sin(aElements1.z);
+    float cO = cos(aElements1.y), sO = sin(aElements1.y);
+    float ci = cos(inc), si = sin(inc);
+    float xu = xo * cw - yo * sw;
+    float yu = xo * sw + yo * cw;
+
+    float x = cO * xu - sO * yu * ci;
+    float y = sO * xu + cO * yu * ci;
+    float z = si * yu;
+
+    // World space is Y-up
+    vec3 pos = center + vec3(x, z, y);
+    gl_Position = projection * view * model * vec4(pos, 1.0);
+    gl_PointSize = pointSize * aElements1.w;
+    vElementIndex = uint(gl_VertexID);
+}
@@ -0,0 +1,8 @@
+#version 330 core
+layout (location = 0) out uvec2 FragId;   // Object ID, element index
+
+uniform uint objectId;
+
+void main() {
+    FragId = uvec2(objectId, 0u);
+}
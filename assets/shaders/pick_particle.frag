@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) out uvec2 FragId;   // Population ID, element index
+
+flat in uint vElementIndex;
+
+uniform uint populationId;   // PickingPass::populationId(population)
+
+void main() {
+    FragId = uvec2(populationId, vElementIndex);
+}
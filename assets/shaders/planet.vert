@@ -1,6 +1,6 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
-layout (location = 2) in vec3 aNormal;
+layout (location = 2) in vec2 aNormalOct;   // Octahedral-encoded, only for meshes with normals
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -10,10 +10,20 @@ uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
 uniform vec3 viewPos;
+uniform bool octNormals;   // false: unit-sphere mesh, the normal is the position
+
+vec3 decodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
 
 void main() {
+    vec3 normal = octNormals ? decodeOctahedral(aNormalOct) : aPos;
     FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = mat3(transpose(inverse(model))) * normal;
     ViewDir = normalize(viewPos - FragPos);
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
@@ -0,0 +1,18 @@
+#version 330 core
+layout (location = 0) in vec4 aPosition;    // xyz, w = 1 while alive
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+uniform float pointSize;
+
+void main() {
+    if (aPosition.w == 0.0) {
+        // Absorbed: place outside the clip volume
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        gl_PointSize = 0.0;
+        return;
+    }
+    gl_Position = projection * view * model * vec4(aPosition.xyz, 1.0);
+    gl_PointSize = pointSize;
+}
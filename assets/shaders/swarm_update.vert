@@ -0,0 +1,44 @@
+#version 330 core
+// Test-particle integration step, captured by transform feedback
+layout (location = 0) in vec4 inPosition;   // xyz, w = 1 while alive
+layout (location = 1) in vec4 inVelocity;
+
+layout (std140) uniform Attractors {
+    vec4 bodies[64];        // xyz = position, w = G * mass
+    int bodyCount;
+};
+
+uniform float dt;
+uniform float softeningSq;
+uniform vec3 captureCenter;
+uniform float captureRadiusSq;
+
+out vec4 outPosition;
+out vec4 outVelocity;
+
+void main() {
+    outPosition = inPosition;
+    outVelocity = inVelocity;
+    if (inPosition.w == 0.0) return;   // Already absorbed
+
+    // Same force law as PhysicsSimulator::update
+    vec3 p = inPosition.xyz;
+    vec3 acc = vec3(0.0);
+    for (int i = 0; i < bodyCount; ++i) {
+        vec3 r = bodies[i].xyz - p;
+        float distSq = dot(r, r);
+        float dist = sqrt(distSq);
+        if (dist < 0.0001) continue;
+        acc += (r / dist) * (bodies[i].w / (distSq + softeningSq));
+    }
+
+    // Semi-implicit Euler, matching the CPU integrator
+    vec3 v = inVelocity.xyz + acc * dt;
+    p += v * dt;
+
+    vec3 toCenter = p - captureCenter;
+    float alive = dot(toCenter, toCenter) < captureRadiusSq ? 0.0 : 1.0;
+
+    outPosition = vec4(p, alive);
+    outVelocity = vec4(v, 0.0);
+}
@@ -0,0 +1,9 @@
+#version 330 core
+in vec4 vColor;
+out vec4 FragColor;
+
+uniform float opacity;
+
+void main() {
+    FragColor = vec4(vColor.rgb, vColor.a * opacity);
+}
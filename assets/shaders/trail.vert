@@ -0,0 +1,26 @@
+#version 330 core
+
+// Ring of body positions laid out as [sample][body]
+uniform samplerBuffer trailPositions;
+uniform samplerBuffer trailColors;
+uniform int head;          // Next row to be written
+uniform int capacity;      // Rows in the ring
+uniform int bodyCount;
+uniform int sampleCount;   // Vertices per strip
+
+uniform mat4 model;
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec4 vColor;
+
+void main() {
+    // Vertex 0 is the oldest sample, the last vertex the newest
+    int row = (head - sampleCount + gl_VertexID + capacity) % capacity;
+    vec3 pos = texelFetch(trailPositions, row * bodyCount + gl_InstanceID).xyz;
+
+    float age = float(gl_VertexID + 1) / float(sampleCount);
+    vColor = vec4(texelFetch(trailColors, gl_InstanceID).rgb, age * age);
+
+    gl_Position = projection * view * model * vec4(pos, 1.0);
+}
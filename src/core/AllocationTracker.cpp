@@ -0,0 +1,120 @@
+#include "AllocationTracker.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace Core {
+
+namespace {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(AllocationTag::Count);
+
+constexpr const char* TAG_NAMES[TAG_COUNT] = {"other", "loader", "physics", "renderer", "UI"};
+
+// Constant-initialized, so allocations made during static initialization are counted safely
+std::array<std::atomic<uint64_t>, TAG_COUNT> g_allocations{};
+std::array<std::atomic<uint64_t>, TAG_COUNT> g_bytes{};
+std::atomic<uint64_t> g_liveBytes{0};
+
+// Per thread, so loader and worker threads don't show up in the main thread's frames
+thread_local uint64_t t_allocationCount = 0;
+
+[[maybe_unused]] void recordAllocation(void* data, size_t size) {
+    size_t tag = static_cast<size_t>(AllocationScope::getCurrent());
+    ++t_allocationCount;
+    g_allocations[tag].fetch_add(1, std::memory_order_relaxed);
+    g_bytes[tag].fetch_add(size, std::memory_order_relaxed);
+    g_liveBytes.fetch_add(malloc_usable_size(data), std::memory_order_relaxed);
+}
+
+[[maybe_unused]] void recordFree(void* data) {
+    if (data) {
+        g_liveBytes.fetch_sub(malloc_usable_size(data), std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+AllocationCounts AllocationSnapshot::getTotal() const {
+    AllocationCounts total;
+    for (const AllocationCounts& counts : tags) {
+        total.allocations += counts.allocations;
+        total.bytes += counts.bytes;
+    }
+    return total;
+}
+
+AllocationSnapshot AllocationSnapshot::since(const AllocationSnapshot& earlier) const {
+    AllocationSnapshot delta;
+    for (size_t tag = 0; tag < TAG_COUNT; ++tag) {
+        delta.tags[tag].allocations = tags[tag].allocations - earlier.tags[tag].allocations;
+        delta.tags[tag].bytes = tags[tag].bytes - earlier.tags[tag].bytes;
+    }
+    delta.liveBytes = liveBytes;
+    return delta;
+}
+
+AllocationSnapshot AllocationTracker::getSnapshot() {
+    AllocationSnapshot snapshot;
+    for (size_t tag = 0; tag < TAG_COUNT; ++tag) {
+        snapshot.tags[tag].allocations = g_allocations[tag].load(std::memory_order_relaxed);
+        snapshot.tags[tag].bytes = g_bytes[tag].load(std::memory_order_relaxed);
+    }
+    snapshot.liveBytes = g_liveBytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+uint64_t AllocationTracker::getThreadCount() {
+    return t_allocationCount;
+}
+
+const char* AllocationTracker::getTagName(AllocationTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return index < TAG_COUNT ? TAG_NAMES[index] : "?";
+}
+
+} // namespace Core
+
+#ifdef SPACE_SIM_ALLOCATION_TRACKING
+
+// The array, nothrow and sized forms of the standard library forward to these
+
+void* operator new(std::size_t size) {
+    void* data = std::malloc(size ? size : 1);
+    if (!data) throw std::bad_alloc();
+    Core::recordAllocation(data, size);
+    return data;
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    // aligned_alloc wants the size to be a multiple of the alignment
+    size_t align = static_cast<size_t>(alignment);
+    size_t bytes = size ? (size + align - 1) / align * align : align;
+    void* data = std::aligned_alloc(align, bytes);
+    if (!data) throw std::bad_alloc();
+    Core::recordAllocation(data, size);
+    return data;
+}
+
+void operator delete(void* data) noexcept {
+    Core::recordFree(data);
+    std::free(data);
+}
+
+void operator delete(void* data, std::size_t) noexcept {
+    Core::recordFree(data);
+    std::free(data);
+}
+
+void operator delete(void* data, std::align_val_t) noexcept {
+    Core::recordFree(data);
+    std::free(data);
+}
+
+void operator delete(void* data, std::size_t, std::align_val_t) noexcept {
+    Core::recordFree(data);
+    std::free(data);
+}
+
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+/// Subsystem charged for heap allocations made while an AllocationScope is active
+enum class AllocationTag : uint8_t {
+    Other = 0,
+    Loader,
+    Physics,
+    Renderer,
+    UI,
+    Count
+};
+
+/// Allocation count and requested bytes
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+/// Cumulative counters for every tag, across all threads
+struct AllocationSnapshot {
+    std::array<AllocationCounts, static_cast<size_t>(AllocationTag::Count)> tags{};
+    uint64_t liveBytes = 0;     // Heap in use at the time of the snapshot
+
+    const AllocationCounts& operator[](AllocationTag tag) const { return tags[static_cast<size_t>(tag)]; }
+    AllocationCounts getTotal() const;
+
+    /// Counts made between `earlier` and this snapshot (liveBytes stays this snapshot's)
+    AllocationSnapshot since(const AllocationSnapshot& earlier) const;
+};
+
+/// Opt-in heap allocation tracking. Global operator new/delete are only
+/// replaced with -DSPACE_SIM_ALLOCATION_TRACKING=ON; otherwise every count stays 0.
+class AllocationTracker {
+public:
+#ifdef SPACE_SIM_ALLOCATION_TRACKING
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    static AllocationSnapshot getSnapshot();
+
+    /// Heap allocations made so far by the calling thread
+    static uint64_t getThreadCount();
+
+    static const char* getTagName(AllocationTag tag);
+};
+
+/// Charges the calling thread's allocations to `tag` until destroyed.
+/// Header-only, so code shared with the command-line tools can be tagged too.
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocationTag tag) : m_previous(s_current) { s_current = tag; }
+    ~AllocationScope() { s_current = m_previous; }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    static AllocationTag getCurrent() { return s_current; }
+
+private:
+    static inline thread_local AllocationTag s_current = AllocationTag::Other;
+    AllocationTag m_previous;
+};
+
+} // namespace Core
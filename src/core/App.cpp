@@ -1,10 +1,20 @@
 #include "App.hpp"
 #include "render/GLRenderer.hpp"
+#include "CPUBodyPicker.hpp"
+#include "GPUBodyPicker.hpp"
+#include "AllocationTracker.hpp"
+#include "FrameArena.hpp"
+#include "platform/SDLWindow.hpp"
+#include "platform/HeadlessWindow.hpp"
 #include "Logger.hpp"
 #include "imgui.h"
 #include <SDL3/SDL.h>
+#include <cassert>
 #include <chrono>
 #include <atomic>
+#include <fstream>
+#include <algorithm>
+#include <numeric>
 
 namespace {
     // Global shutdown flag for signal handling
@@ -23,19 +33,26 @@ void requestGlobalShutdown() {
     g_shutdownRequested.store(true, std::memory_order_relaxed);
 }
 
-App::App() {
+App::App(const AppOptions& options)
+    : m_options(options) {
     LOG_INFO("App", "Initializing application...");
     
-    // Create window
-    m_window = std::make_unique<Platform::SDLWindow>("Solar System Simulator", 1280, 720);
-    m_window->createGLContext();
+    // Create window (or offscreen target)
+    Platform::SDLWindow* sdlWindow = nullptr;
+    if (m_options.headless) {
+        auto window = std::make_unique<Platform::HeadlessWindow>(m_options.width, m_options.height);
+        window->createGLContext();
+        m_window = std::move(window);
+    } else {
+        auto window = std::make_unique<Platform::SDLWindow>("Solar System Simulator", m_options.width, m_options.height);
+        window->createGLContext();
+        sdlWindow = window.get();
+        m_window = std::move(window);
+    }
     
     // Create input manager
     m_inputManager = std::make_unique<InputManager>();
     
-    // Create body picker (SRP - extracted from App)
-    m_bodyPicker = std::make_unique<BodyPicker>(*m_window);
-    
     // Get initial window size
     int width, height;
     m_window->getSize(width, height);
@@ -46,21 +63,40 @@ App::App() {
     // Create renderer
     m_renderer = std::make_unique<Render::GLRenderer>(*m_window);
     
+    // Create body picker (SRP - extracted from App)
+    if (m_options.gpuPicking) {
+        m_bodyPicker = std::make_unique<GPUBodyPicker>(*m_renderer);
+    } else {
+        m_bodyPicker = std::make_unique<CPUBodyPicker>(*m_window);
+    }
+    
     // Create simulation UI (SRP - extracted from App)
     m_simulationUI = std::make_unique<Render::SimulationUI>(*m_window);
     
     // Set up raw event forwarding to ImGui
-    m_window->setRawEventCallback([this](const SDL_Event& event) {
-        m_renderer->processEvent(event);
-    });
+    if (sdlWindow) {
+        sdlWindow->setRawEventCallback([this](const SDL_Event& event) {
+            m_renderer->processEvent(event);
+            m_redrawRequested = true;   // Exposure, focus and ImGui input all need a fresh frame
+        });
+    }
     
     // Create time manager
     m_time = std::make_unique<Time>();
     m_time->setTimeScale(1.0 / 365.25);  // 1 real second = 1 simulated day
     
+    m_framePacer = std::make_unique<FramePacer>(m_options.headless ? 0 : m_options.maxFps);
+    
     // Create solar system
     m_solarSystem = std::make_unique<Simulation::SolarSystem>();
-    m_solarSystem->init();
+    m_solarSystem->getCache().setBudget(static_cast<size_t>(std::max(m_options.systemCacheMb, 0)) * 1024 * 1024);
+    for (const auto& directory : m_options.systemDirectories) {
+        m_solarSystem->getRegistry().addDirectory(directory);
+    }
+    m_solarSystem->init(m_options.startupSystem);
+    if (m_options.warmSystemCache) {
+        m_solarSystem->warmCache(m_solarSystem->getRegistry().getSystemNames());
+    }
     
     LOG_INFO("App", "Application initialized successfully");
 }
@@ -80,9 +116,9 @@ void App::shutdown() {
     m_lockedBody = nullptr;
     m_solarSystem.reset();
     m_simulationUI.reset();
+    m_bodyPicker.reset();   // May reference the renderer
     m_renderer.reset();
     m_camera.reset();
-    m_bodyPicker.reset();
     m_time.reset();
     m_inputManager.reset();
     // Window is destroyed last (destructor handles it)
@@ -93,18 +129,50 @@ void App::shutdown() {
 void App::run() {
     m_isRunning = true;
     
+    if (!m_options.captureDirectory.empty()) {
+        toggleCapture();
+    }
+    
     auto lastTime = std::chrono::high_resolution_clock::now();
+    if (m_options.maxFrames > 0) {
+        m_frameTimesMs.reserve(static_cast<size_t>(m_options.maxFrames));
+    }
+    
+    // Headless runs exist to render every frame
+    const bool onDemand = m_options.renderOnDemand && !m_options.headless;
     
     while (m_isRunning && !m_window->shouldClose() && !isShutdownRequested()) {
+        if (onDemand && m_idle) {
+            // Nothing is moving: sleep until input arrives instead of spinning
+            m_window->waitForEvent(IDLE_WAIT_MS);
+            lastTime = std::chrono::high_resolution_clock::now();
+            m_framePacer->reset();
+        }
+        
+        const uint64_t allocationsAtStart = AllocationTracker::getThreadCount();
+        const AllocationSnapshot frameStart = AllocationTracker::getSnapshot();
+        
         // Calculate delta time
         auto currentTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
+        m_renderer->beginFrame();
+        
+        // Headless runs advance by a fixed step so every run renders the same frames
+        if (m_options.headless) {
+            deltaTime = HEADLESS_FRAME_DT;
+        }
+        // Captures advance by exactly one video frame, however long rendering takes
+        if (m_options.captureFps > 0 && m_renderer->isCapturing()) {
+            deltaTime = 1.0f / static_cast<float>(m_options.captureFps);
+        }
         
         // Process events
         m_window->pollEvents([this](const Platform::WindowEvent& event) {
             // Forward to input manager
             m_inputManager->processEvent(event);
+            m_redrawRequested = true;
+            m_frameHadEvents = true;
             
             // Handle window-specific events
             if (event.type == Platform::WindowEventType::Quit) {
@@ -135,15 +203,142 @@ void App::run() {
         update(deltaTime);
         
         // Render
-        render();
+        bool draw = !onDemand || needsRedraw();
+        if (draw) {
+            render();
+        }
+        m_idle = !draw;
         
         // End input frame
         m_inputManager->endFrame();
+        
+        if (draw) {
+            m_framePacer->waitForNextFrame();
+        }
+        
+        if (m_options.maxFrames > 0) {
+            auto frameEnd = std::chrono::high_resolution_clock::now();
+            m_frameTimesMs.push_back(std::chrono::duration<float, std::milli>(frameEnd - currentTime).count());
+            if (static_cast<int>(m_frameTimesMs.size()) >= m_options.maxFrames) {
+                m_isRunning = false;
+            }
+        }
+        
+        // Checked before the report, whose periodic log line allocates
+        checkFrameAllocations(AllocationTracker::getThreadCount() - allocationsAtStart);
+        updateMemoryReport(frameStart);
+        
+        // Everything allocated from frame scratch is dead by now
+        FrameArena::get().reset();
+    }
+    
+    if (m_options.maxFrames > 0) {
+        reportFrameTimes();
+        logMemoryReport("end of run");
+        dumpProfile(PROFILE_DUMP_PATH);
     }
     
+    // Flush frames still in flight
+    m_renderer->stopCapture();
+    
     m_isRunning = false;
 }
 
+void App::checkFrameAllocations(uint64_t allocations) {
+    bool quiet = !m_frameHadEvents && !m_solarSystem->isLoading() && !m_renderer->isCapturing();
+    m_frameHadEvents = false;
+    if (!AllocationTracker::ENABLED) return;
+    
+    // Input, loads and captures allocate legitimately; give caches and
+    // amortized containers time to settle after them
+    if (!quiet) {
+        m_steadyFrames = 0;
+        return;
+    }
+    if (m_steadyFrames < STEADY_WARMUP_FRAMES) {
+        ++m_steadyFrames;
+        return;
+    }
+    if (allocations > 0) {
+        LOG_ERROR("App", allocations, " heap allocation(s) in a steady-state frame");
+        assert(allocations == 0 && "steady-state frames must not touch the heap");
+    }
+}
+
+void App::updateMemoryReport(const AllocationSnapshot& frameStart) {
+    AllocationSnapshot snapshot = AllocationTracker::getSnapshot();
+    m_memoryReport.frame = snapshot.since(frameStart);
+    m_memoryReport.total = snapshot;
+    
+    if (++m_framesSinceMemorySample >= MEMORY_SAMPLE_FRAMES) {
+        m_framesSinceMemorySample = 0;
+        sampleMemory();
+    }
+    
+    if (!AllocationTracker::ENABLED && m_options.memoryBudgetMb <= 0) return;
+    auto now = std::chrono::high_resolution_clock::now();
+    if (std::chrono::duration<float>(now - m_lastMemoryLog).count() >= MEMORY_LOG_INTERVAL_S) {
+        logMemoryReport("periodic");
+    }
+}
+
+void App::sampleMemory() {
+    m_memoryReport.rssBytes = MemoryStats::getCurrentRss();
+    m_memoryReport.peakRssBytes = MemoryStats::getPeakRss();
+    m_memoryReport.gpuBufferBytes = m_renderer->getFrameStats().gpuBufferBytes;
+    m_memoryReport.pooledBodyBytes = Simulation::BodyArena::getPooledBytes();
+    m_memoryReport.budgetBytes = static_cast<size_t>(std::max(0, m_options.memoryBudgetMb)) * 1024 * 1024;
+    
+    // Peak RSS only grows, so warn once
+    if (!m_overMemoryBudget && m_memoryReport.budgetBytes > 0 &&
+        m_memoryReport.peakRssBytes > m_memoryReport.budgetBytes) {
+        m_overMemoryBudget = true;
+        LOG_WARN("App", "Peak resident memory ", m_memoryReport.peakRssBytes / (1024 * 1024),
+                 " MB exceeds the budget of ", m_options.memoryBudgetMb, " MB (system '",
+                 m_solarSystem->getCurrentSystemName(), "')");
+    }
+}
+
+void App::logMemoryReport(std::string_view context) {
+    sampleMemory();
+    const MemoryReport& report = m_memoryReport;
+    LOG_INFO("Memory", context, ": '", m_solarSystem->getCurrentSystemName(), "', RSS ",
+             report.rssBytes / (1024 * 1024), " MB (peak ", report.peakRssBytes / (1024 * 1024), " MB), GPU buffers ",
+             report.gpuBufferBytes / (1024 * 1024), " MB, pooled body blocks ",
+             report.pooledBodyBytes / (1024 * 1024), " MB");
+    
+    if (AllocationTracker::ENABLED) {
+        AllocationSnapshot interval = report.total.since(m_lastLoggedAllocations);
+        AllocationCounts total = interval.getTotal();
+        LOG_INFO("Memory", "Heap ", report.total.liveBytes / (1024 * 1024), " MB in use; ",
+                 total.allocations, " allocations (", total.bytes / 1024, " KB) since the last report: loader ",
+                 interval[AllocationTag::Loader].allocations, ", physics ", interval[AllocationTag::Physics].allocations,
+                 ", renderer ", interval[AllocationTag::Renderer].allocations, ", UI ", interval[AllocationTag::UI].allocations,
+                 ", other ", interval[AllocationTag::Other].allocations);
+        m_lastLoggedAllocations = report.total;
+    }
+    m_lastMemoryLog = std::chrono::high_resolution_clock::now();
+}
+
+void App::reportFrameTimes() const {
+    // Skip warm-up frames (shader compilation, first uploads)
+    size_t warmup = std::min<size_t>(10, m_frameTimesMs.size() / 10);
+    std::vector<float> samples(m_frameTimesMs.begin() + warmup, m_frameTimesMs.end());
+    if (samples.empty()) return;
+    
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) {
+        size_t index = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+        return samples[index];
+    };
+    double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+    
+    LOG_INFO("App", "Frame times over ", samples.size(), " frames (", warmup, " warm-up skipped): ",
+             "mean ", mean, " ms (", 1000.0 / mean, " fps), ",
+             "p50 ", percentile(0.50), " ms, p95 ", percentile(0.95), " ms, p99 ", percentile(0.99), " ms, ",
+             "min ", samples.front(), " ms, max ", samples.back(), " ms");
+}
+
 void App::processInput(float deltaTime) {
     // Handle toggle actions first
     if (m_inputManager->wasActionTriggered(InputAction::TogglePause)) {
@@ -153,10 +348,17 @@ void App::processInput(float deltaTime) {
         m_camera->transitionToTarget(glm::vec3(0.0f), 30.0f, 0.5f);
         m_lockedBody = nullptr;
         m_selectedBody = nullptr;
+        m_selectedParticle = {};
     }
     if (m_inputManager->wasActionTriggered(InputAction::Quit)) {
         m_isRunning = false;
     }
+    if (m_inputManager->wasActionTriggered(InputAction::DumpProfile)) {
+        dumpProfile(PROFILE_DUMP_PATH);
+    }
+    if (m_inputManager->wasActionTriggered(InputAction::ToggleCapture)) {
+        toggleCapture();
+    }
     if (m_inputManager->wasActionTriggered(InputAction::ToggleCameraMode)) {
         m_camera->toggleMode();
         if (m_camera->getMode() == Render::CameraMode::FreeFly) {
@@ -170,7 +372,8 @@ void App::processInput(float deltaTime) {
         m_inputManager->getMousePosition(mx, my);
         const Simulation::CelestialBody* clicked = m_bodyPicker->pickBody(
             mx, my, *m_solarSystem, *m_camera, 
-            m_time->getSimulationTime(), m_simulationUI->isShowLabels()
+            m_time->getSimulationTime(),
+            m_simulationUI->isShowLabels() ? &m_simulationUI->getLabelLayout() : nullptr
         );
         
         float currentTime = static_cast<float>(SDL_GetTicks()) / 1000.0f;
@@ -180,6 +383,7 @@ void App::processInput(float deltaTime) {
         } else {
             // Single click - Select
             m_selectedBody = clicked;
+            m_selectedParticle = m_bodyPicker->getParticle();
         }
         m_clickTime = currentTime;
     }
@@ -240,12 +444,20 @@ void App::processInput(float deltaTime) {
 }
 
 void App::update(float deltaTime) {
+    // Background loads are swapped in here, before anything reads the bodies this frame
+    if (m_solarSystem->applyPendingLoad()) {
+        onSystemLoaded();
+    }
+    
     if (m_solarSystem->isPhysicsEnabled()) {
         // Run physics multiple steps per frame for stability
         const int steps = 4;
         float subDt = deltaTime / steps;
+        AllocationScope allocationScope(AllocationTag::Physics);
         for (int i = 0; i < steps; ++i) {
             m_solarSystem->updatePhysics(subDt);
+            // Test particles feel the bodies at every sub-step (dispatched when the frame is drawn)
+            m_renderer->queueTestParticleStep(*m_solarSystem, subDt);
         }
     } else {
         m_time->update(deltaTime);
@@ -272,12 +484,55 @@ void App::update(float deltaTime) {
     }
 }
 
+bool App::needsRedraw() {
+    SceneSignature signature;
+    signature.simulationTime = m_time->getSimulationTime();
+    signature.physicsSteps = m_solarSystem->getPhysicsStepCount();
+    signature.stateGeneration = m_solarSystem->getStateGeneration();
+    signature.loadProgress = m_solarSystem->getLoadProgress();
+    signature.view = m_camera->getViewMatrix();
+    signature.projection = m_camera->getProjectionMatrix();
+    signature.hovered = m_hoveredBody;
+    signature.selected = m_selectedBody;
+    signature.locked = m_lockedBody;
+    signature.hoveredParticle = m_hoveredParticle;
+    signature.selectedParticle = m_selectedParticle;
+    
+    bool changed = m_redrawRequested || signature != m_lastSignature;
+    m_redrawRequested = false;
+    m_lastSignature = signature;
+    
+    // Active widgets (text cursors, drags) and captures keep frames coming
+    const ImGuiIO& io = ImGui::GetIO();
+    if (changed || io.WantTextInput || ImGui::IsAnyItemActive() || m_renderer->isCapturing()) {
+        m_settleFrames = SETTLE_FRAMES;
+    }
+    if (m_settleFrames == 0) return false;
+    --m_settleFrames;
+    return true;
+}
+
 void App::render() {
     // Sync render options from SimulationUI to GLRenderer
     m_renderer->setShowOrbits(m_simulationUI->isShowOrbits());
     m_renderer->setShowLabels(m_simulationUI->isShowLabels());
-    
+    m_renderer->setShowTrails(m_simulationUI->isShowTrails());
+    m_renderer->setTrailLength(m_simulationUI->getTrailLength());
+    
+    // Headless and fixed-rate captures must render every frame at the same quality
+    bool fixedRate = m_options.headless || (m_renderer->isCapturing() && m_options.captureFps > 0);
+    Render::QualityGovernor& governor = m_renderer->getQualityGovernor();
+    governor.setEnabled(m_simulationUI->isAdaptiveQuality() && !fixedRate);
+    governor.setTargetFrameMs(1000.0f / static_cast<float>(m_simulationUI->getTargetFps()));
+    governor.setResolutionScalingAllowed(m_simulationUI->isResolutionScalingAllowed());
+    m_simulationUI->setLabelBudget(m_renderer->getQualitySettings().labelBudget);
+    m_simulationUI->setFrameStats(m_renderer->getFrameStats());
+    m_simulationUI->setMemoryReport(m_memoryReport);
+    
+    AllocationScope allocationScope(AllocationTag::Renderer);
     m_renderer->render(*m_solarSystem, *m_camera, m_time->getSimulationTime(), m_hoveredBody, [this]() {
+        AllocationScope uiScope(AllocationTag::UI);
+        
         // Set up callbacks for UI actions
         Render::UICallbacks callbacks;
         callbacks.onSystemSelected = [this](const std::string& name) {
@@ -312,12 +567,45 @@ void App::render() {
             infoBody, m_hoveredBody, m_selectedBody,
             mx, my, m_inputManager->uiWantsMouse()
         );
+        if (!infoBody) {
+            bool hovered = m_hoveredParticle.isValid();
+            m_simulationUI->renderParticleTooltip(
+                *m_solarSystem, hovered ? m_hoveredParticle : m_selectedParticle, hovered,
+                mx, my, m_inputManager->uiWantsMouse()
+            );
+        }
     });
 }
 
+void App::dumpProfile(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        LOG_ERROR("App", "Failed to write GPU timings to ", path);
+        return;
+    }
+    m_renderer->getProfiler().writeJson(out);
+    LOG_INFO("App", "GPU timings written to ", path);
+}
+
+void App::toggleCapture() {
+    if (m_renderer->isCapturing()) {
+        m_renderer->stopCapture();
+        return;
+    }
+    
+    Render::CaptureSettings settings;
+    settings.directory = m_options.captureDirectory.empty() ? DEFAULT_CAPTURE_DIR : m_options.captureDirectory;
+    settings.format = m_options.captureFormat;
+    settings.includeUI = m_options.captureUI;
+    // With a fixed step nothing depends on wall-clock pacing, so never drop frames
+    settings.lossless = m_options.captureFps > 0 || m_options.headless;
+    m_renderer->startCapture(settings);
+}
+
 void App::updateHover() {
     if (m_inputManager->uiWantsMouse()) {
         m_hoveredBody = nullptr;
+        m_hoveredParticle = {};
         return;
     }
     
@@ -325,8 +613,10 @@ void App::updateHover() {
     m_inputManager->getMousePosition(mx, my);
     m_hoveredBody = m_bodyPicker->pickBody(
         mx, my, *m_solarSystem, *m_camera,
-        m_time->getSimulationTime(), m_simulationUI->isShowLabels()
+        m_time->getSimulationTime(),
+        m_simulationUI->isShowLabels() ? &m_simulationUI->getLabelLayout() : nullptr
     );
+    m_hoveredParticle = m_bodyPicker->getParticle();
 }
 
 void App::handleBodySelection(const Simulation::CelestialBody* body) {
@@ -348,14 +638,24 @@ void App::handleBodySelection(const Simulation::CelestialBody* body) {
 }
 
 void App::handleSystemChange(const std::string& systemName) {
-    m_solarSystem->loadSystem(systemName);
+    // The current system keeps running until the new one is ready
+    m_solarSystem->loadSystemAsync(systemName);
+}
+
+void App::onSystemLoaded() {
     m_lockedBody = nullptr;
     m_selectedBody = nullptr;
     m_hoveredBody = nullptr;
+    m_selectedParticle = {};
+    m_hoveredParticle = {};
+    m_simulationUI->clearLabels();
     
     // Use different zoom for special events
+    const std::string& systemName = m_solarSystem->getCurrentSystemName();
     float distance = (systemName == "Black Hole" || systemName == "Binary Star") ? 40.0f : 30.0f;
     m_camera->transitionToTarget(glm::vec3(0.0f), distance, 0.5f);
+    
+    logMemoryReport("system loaded");
 }
 
 } // namespace Core
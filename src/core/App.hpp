@@ -1,10 +1,18 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
-#include "platform/SDLWindow.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/glm.hpp>
+#include "platform/WindowInterface.hpp"
 #include "core/InputManager.hpp"
 #include "core/Time.hpp"
 #include "core/BodyPicker.hpp"
+#include "core/FramePacer.hpp"
+#include "core/MemoryStats.hpp"
 #include "simulation/SolarSystem.hpp"
 #include "render/Camera.hpp"
 #include "render/GLRenderer.hpp"
@@ -12,11 +20,39 @@
 
 namespace Core {
 
+/// Startup options, normally parsed from the command line
+struct AppOptions {
+    bool headless = false;   // Render offscreen through EGL, no window or input
+    int maxFrames = 0;       // Stop after this many frames (0 = run until closed)
+    int width = 1280;
+    int height = 720;
+    
+    // Frame capture
+    std::string captureDirectory;   // Start capturing here at launch (empty = F12 only)
+    Render::CaptureFormat captureFormat = Render::CaptureFormat::Png;
+    int captureFps = 0;             // Fixed simulation rate while capturing (0 = wall clock)
+    bool captureUI = false;         // Include the ImGui overlay in captured frames
+    
+    // Frame pacing
+    bool renderOnDemand = false;    // Sleep until input when nothing on screen would change
+    int maxFps = 0;                 // Frame-rate cap (0 = uncapped / vsync)
+    
+    bool gpuPicking = false;        // Pick through the renderer's ID buffer instead of CPU ray casts
+    
+    // Systems
+    std::string startupSystem = "Solar System";
+    std::vector<std::string> systemDirectories;   // Scanned in addition to assets/systems and the user directory
+    bool warmSystemCache = false;   // Parse every available system in the background at startup
+    int systemCacheMb = 512;        // Budget for parsed systems kept after switching away (0 = off)
+    
+    int memoryBudgetMb = 0;         // Warn when peak resident memory exceeds this (0 = off)
+};
+
 /// Main application class - orchestrates all subsystems
 /// Refactored to delegate UI rendering and body picking to separate classes (SRP)
 class App {
 public:
-    App();
+    explicit App(const AppOptions& options = AppOptions{});
     ~App();
 
     /// Run the main application loop
@@ -27,6 +63,9 @@ public:
     
     /// Check if external shutdown was requested (e.g., signal)
     static bool isShutdownRequested();
+    
+    /// Peak resident memory went over AppOptions::memoryBudgetMb at some point
+    bool exceededMemoryBudget() const { return m_overMemoryBudget; }
 
 private:
     void processInput(float deltaTime);
@@ -34,14 +73,58 @@ private:
     void render();
     void shutdown();
     
+    /// Log frame-time statistics for a fixed-length run
+    void reportFrameTimes() const;
+    
+    /// With SPACE_SIM_ALLOCATION_TRACKING, flag heap allocations in frames where nothing changed
+    void checkFrameAllocations(uint64_t allocations);
+    
+    /// Refresh the memory report after a frame; logs it periodically in tracking or budgeted runs
+    void updateMemoryReport(const AllocationSnapshot& frameStart);
+    
+    /// Re-read resident and GPU buffer memory, warning the first time the budget is exceeded
+    void sampleMemory();
+    
+    void logMemoryReport(std::string_view context);
+    
     // Interaction helpers
     void updateHover();
     void handleBodySelection(const Simulation::CelestialBody* body);
     void handleSystemChange(const std::string& systemName);
+    
+    /// Reset selection and move the camera once a requested system is live
+    void onSystemLoaded();
+    
+    /// Write GPU pass timings as JSON
+    void dumpProfile(const std::string& path) const;
+    
+    /// Start or stop writing frames to an image sequence
+    void toggleCapture();
+    
+    /// Everything that changes the rendered image without an input event
+    struct SceneSignature {
+        double simulationTime = 0.0;
+        uint64_t physicsSteps = 0;
+        uint64_t stateGeneration = 0;
+        float loadProgress = 1.0f;
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        const Simulation::CelestialBody* hovered = nullptr;
+        const Simulation::CelestialBody* selected = nullptr;
+        const Simulation::CelestialBody* locked = nullptr;
+        Simulation::ParticleRef hoveredParticle;
+        Simulation::ParticleRef selectedParticle;
+        
+        bool operator==(const SceneSignature& other) const = default;
+    };
+    
+    /// Render-on-demand: true if this frame must be drawn
+    bool needsRedraw();
 
-    // Core systems - using SDLWindow concrete type for now due to GL context needs
-    // Note: Ideally would use WindowInterface* but GLRenderer needs SDL-specific features
-    std::unique_ptr<Platform::SDLWindow> m_window;
+    AppOptions m_options;
+    
+    // Core systems - SDL window, or an EGL offscreen target in headless mode
+    std::unique_ptr<Platform::WindowInterface> m_window;
     std::unique_ptr<InputManager> m_inputManager;
     std::unique_ptr<Time> m_time;
     std::unique_ptr<BodyPicker> m_bodyPicker;
@@ -58,11 +141,42 @@ private:
     const Simulation::CelestialBody* m_lockedBody = nullptr;
     const Simulation::CelestialBody* m_hoveredBody = nullptr;
     const Simulation::CelestialBody* m_selectedBody = nullptr;
+    Simulation::ParticleRef m_hoveredParticle;      // Only set while no body is hovered
+    Simulation::ParticleRef m_selectedParticle;     // Only set while no body is selected
     
     float m_clickTime = 0.0f;
     const float DOUBLE_CLICK_TIME = 0.3f;
+    static constexpr const char* PROFILE_DUMP_PATH = "gpu_profile.json";
+    static constexpr const char* DEFAULT_CAPTURE_DIR = "capture";
     
     bool m_isRunning = false;
+    
+    // Render on demand
+    std::unique_ptr<FramePacer> m_framePacer;
+    SceneSignature m_lastSignature;
+    bool m_redrawRequested = true;   // Set by any window or input event
+    int m_settleFrames = 0;          // Frames still to draw after the last change
+    bool m_idle = false;             // Last frame was skipped; block for events next
+    static constexpr int SETTLE_FRAMES = 3;   // Lets ImGui hover/animation state catch up
+    static constexpr int IDLE_WAIT_MS = 100;  // Upper bound so signals are still noticed
+    
+    // Steady-state allocation check (SPACE_SIM_ALLOCATION_TRACKING builds)
+    bool m_frameHadEvents = false;
+    int m_steadyFrames = 0;
+    static constexpr int STEADY_WARMUP_FRAMES = 120;
+    
+    // Memory instrumentation
+    MemoryReport m_memoryReport;
+    AllocationSnapshot m_lastLoggedAllocations;
+    std::chrono::high_resolution_clock::time_point m_lastMemoryLog = std::chrono::high_resolution_clock::now();
+    int m_framesSinceMemorySample = 0;
+    bool m_overMemoryBudget = false;
+    static constexpr int MEMORY_SAMPLE_FRAMES = 30;        // RSS is read from /proc, so not every frame
+    static constexpr float MEMORY_LOG_INTERVAL_S = 10.0f;
+    
+    // Fixed-length runs record every frame's wall time
+    std::vector<float> m_frameTimesMs;
+    static constexpr float HEADLESS_FRAME_DT = 1.0f / 60.0f;
 };
 
 } // namespace Core
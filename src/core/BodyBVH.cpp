@@ -0,0 +1,186 @@
+#include "BodyBVH.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Core {
+
+void BodyBVH::update(std::vector<Sphere>& spheres, uint64_t generation) {
+    bool sameSet = m_hasGeneration && generation == m_generation && spheres.size() == m_spheres.size();
+    
+    // Swap rather than copy; the caller refills its (now recycled) vector next frame
+    m_spheres.swap(spheres);
+    
+    if (!sameSet) {
+        m_generation = generation;
+        m_hasGeneration = true;
+        rebuild();
+        return;
+    }
+    
+    refit();
+    if (internalSurfaceArea() > m_builtArea * REBUILD_GROWTH) {
+        rebuild();
+    }
+}
+
+void BodyBVH::sphereBounds(int begin, int end, glm::vec3& outMin, glm::vec3& outMax) const {
+    outMin = glm::vec3(std::numeric_limits<float>::max());
+    outMax = glm::vec3(-std::numeric_limits<float>::max());
+    for (int i = begin; i < end; ++i) {
+        const Sphere& sphere = m_spheres[m_order[i]];
+        for (int axis = 0; axis < 3; ++axis) {
+            outMin[axis] = std::min(outMin[axis], sphere.center[axis] - sphere.radius);
+            outMax[axis] = std::max(outMax[axis], sphere.center[axis] + sphere.radius);
+        }
+    }
+}
+
+void BodyBVH::rebuild() {
+    m_nodes.clear();
+    m_order.resize(m_spheres.size());
+    for (size_t i = 0; i < m_order.size(); ++i) {
+        m_order[i] = static_cast<int>(i);
+    }
+    if (!m_spheres.empty()) {
+        m_nodes.reserve(2 * (m_spheres.size() / LEAF_SIZE + 1));
+        m_nodes.emplace_back();
+        build(0, 0, static_cast<int>(m_order.size()));
+    }
+    m_builtArea = internalSurfaceArea();
+    ++m_rebuilds;
+}
+
+void BodyBVH::build(int nodeIndex, int begin, int end) {
+    glm::vec3 min, max;
+    sphereBounds(begin, end, min, max);
+    m_nodes[nodeIndex].min = min;
+    m_nodes[nodeIndex].max = max;
+    
+    if (end - begin <= LEAF_SIZE) {
+        m_nodes[nodeIndex].first = begin;
+        m_nodes[nodeIndex].count = end - begin;
+        return;
+    }
+    
+    // Median split on the longest axis keeps the tree balanced
+    glm::vec3 extent = max - min;
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+    int mid = begin + (end - begin) / 2;
+    std::nth_element(m_order.begin() + begin, m_order.begin() + mid, m_order.begin() + end,
+                     [this, axis](int a, int b) { return m_spheres[a].center[axis] < m_spheres[b].center[axis]; });
+    
+    // Siblings are allocated together, after their parent (refit relies on this)
+    int left = static_cast<int>(m_nodes.size());
+    m_nodes.emplace_back();
+    m_nodes.emplace_back();
+    m_nodes[nodeIndex].first = left;
+    m_nodes[nodeIndex].count = 0;
+    
+    build(left, begin, mid);
+    build(left + 1, mid, end);
+}
+
+void BodyBVH::refit() {
+    for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; --i) {
+        Node& node = m_nodes[i];
+        if (node.count > 0) {
+            sphereBounds(node.first, node.first + node.count, node.min, node.max);
+        } else {
+            const Node& left = m_nodes[node.first];
+            const Node& right = m_nodes[node.first + 1];
+            node.min = glm::vec3(std::min(left.min.x, right.min.x), std::min(left.min.y, right.min.y),
+                                 std::min(left.min.z, right.min.z));
+            node.max = glm::vec3(std::max(left.max.x, right.max.x), std::max(left.max.y, right.max.y),
+                                 std::max(left.max.z, right.max.z));
+        }
+    }
+}
+
+float BodyBVH::internalSurfaceArea() const {
+    float area = 0.0f;
+    for (const Node& node : m_nodes) {
+        if (node.count > 0) continue;
+        glm::vec3 e = node.max - node.min;
+        area += e.x * e.y + e.y * e.z + e.z * e.x;
+    }
+    return area;
+}
+
+bool BodyBVH::intersectBox(const Node& node, const glm::vec3& origin, const glm::vec3& invDir,
+                           float maxT, float& outNear) {
+    float tNear = -std::numeric_limits<float>::max();
+    float tFar = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; ++axis) {
+        float t0 = (node.min[axis] - origin[axis]) * invDir[axis];
+        float t1 = (node.max[axis] - origin[axis]) * invDir[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        tNear = std::max(tNear, t0);
+        tFar = std::min(tFar, t1);
+    }
+    outNear = tNear;
+    return tNear <= tFar && tFar >= 0.0f && tNear <= maxT;
+}
+
+const Simulation::CelestialBody* BodyBVH::raycast(const glm::vec3& origin, const glm::vec3& direction,
+                                                  float& outT) const {
+    outT = std::numeric_limits<float>::max();
+    if (m_nodes.empty()) return nullptr;
+    
+    // Zero components would give inf * 0 = NaN in the slab test
+    glm::vec3 invDir;
+    for (int axis = 0; axis < 3; ++axis) {
+        float d = direction[axis];
+        invDir[axis] = 1.0f / (std::abs(d) > 1e-12f ? d : 1e-12f);
+    }
+    
+    const Simulation::CelestialBody* hit = nullptr;
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+        float tNear;
+        if (!intersectBox(node, origin, invDir, outT, tNear)) continue;
+        
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; ++i) {
+                const Sphere& sphere = m_spheres[m_order[i]];
+                glm::vec3 L = sphere.center - origin;
+                float tca = glm::dot(L, direction);
+                if (tca < 0.0f) continue;
+                float d2 = glm::dot(L, L) - tca * tca;
+                float r2 = sphere.radius * sphere.radius;
+                if (d2 > r2) continue;
+                float t0 = tca - std::sqrt(r2 - d2);
+                if (t0 < outT) {
+                    outT = t0;
+                    hit = sphere.body;
+                }
+            }
+            continue;
+        }
+        
+        // Visit the nearer child first so its hit prunes the farther one
+        float tLeft, tRight;
+        const Node& left = m_nodes[node.first];
+        const Node& right = m_nodes[node.first + 1];
+        bool hitLeft = intersectBox(left, origin, invDir, outT, tLeft);
+        bool hitRight = intersectBox(right, origin, invDir, outT, tRight);
+        if (hitLeft && hitRight) {
+            bool leftFirst = tLeft <= tRight;
+            stack[top++] = leftFirst ? node.first + 1 : node.first;
+            stack[top++] = leftFirst ? node.first : node.first + 1;
+        } else if (hitLeft) {
+            stack[top++] = node.first;
+        } else if (hitRight) {
+            stack[top++] = node.first + 1;
+        }
+    }
+    return hit;
+}
+
+} // namespace Core
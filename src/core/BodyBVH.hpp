@@ -0,0 +1,68 @@
+#pragma once
+
+#include "simulation/CelestialBody.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace Core {
+
+/// Bounding-volume hierarchy over body pick spheres.
+///
+/// Bodies move every frame but their set rarely changes, so the tree topology is
+/// kept and only the node boxes are refit (one reverse pass, children always sit
+/// after their parent). The tree is rebuilt when the body set changes or when
+/// refitting has inflated the boxes past REBUILD_GROWTH times their surface area
+/// at build time - orbits eventually scramble any spatial split.
+class BodyBVH {
+public:
+    /// Pick sphere for one body, in world space
+    struct Sphere {
+        const Simulation::CelestialBody* body = nullptr;
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+    };
+
+    static constexpr int LEAF_SIZE = 4;
+    static constexpr float REBUILD_GROWTH = 2.0f;
+
+    /// Take this frame's spheres. `generation` identifies the body set
+    /// (SolarSystem::getSystemGeneration); a change forces a rebuild.
+    void update(std::vector<Sphere>& spheres, uint64_t generation);
+
+    /// Nearest sphere hit along the ray (sphere centre in front of the origin),
+    /// or nullptr. outT receives the entry distance.
+    const Simulation::CelestialBody* raycast(const glm::vec3& origin, const glm::vec3& direction,
+                                             float& outT) const;
+
+    size_t getNodeCount() const { return m_nodes.size(); }
+    uint64_t getRebuildCount() const { return m_rebuilds; }
+
+private:
+    struct Node {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+        int first = 0;   // Leaf: first index into m_order; internal: left child (right = first + 1)
+        int count = 0;   // Leaf primitive count, 0 for internal nodes
+    };
+
+    void rebuild();
+    void build(int nodeIndex, int begin, int end);
+    void refit();
+    float internalSurfaceArea() const;
+    void sphereBounds(int begin, int end, glm::vec3& outMin, glm::vec3& outMax) const;
+
+    /// Slab test; returns false on a miss or when the box starts beyond maxT
+    static bool intersectBox(const Node& node, const glm::vec3& origin, const glm::vec3& invDir,
+                             float maxT, float& outNear);
+
+    std::vector<Sphere> m_spheres;
+    std::vector<int> m_order;    // Leaf ranges index m_spheres through this
+    std::vector<Node> m_nodes;
+    uint64_t m_generation = 0;
+    bool m_hasGeneration = false;
+    float m_builtArea = 0.0f;
+    uint64_t m_rebuilds = 0;
+};
+
+} // namespace Core
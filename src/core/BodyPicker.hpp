@@ -2,28 +2,34 @@
 
 #include "simulation/SolarSystem.hpp"
 #include "render/Camera.hpp"
-#include "platform/WindowInterface.hpp"
+#include "render/LabelLayout.hpp"
 
 namespace Core {
 
-/// Handles raycasting and body picking logic
+/// Body picking strategy (hover and click).
 /// Extracted from App to follow Single Responsibility Principle
 class BodyPicker {
 public:
-    BodyPicker(Platform::WindowInterface& window);
+    virtual ~BodyPicker() = default;
     
     /// Pick a body at the given screen coordinates
-    /// Returns nullptr if no body was hit
-    const Simulation::CelestialBody* pickBody(
+    /// Returns nullptr if no body was hit. Labels placed in `labels` (last
+    /// frame's layout, or nullptr when labels are hidden) are clickable too.
+    virtual const Simulation::CelestialBody* pickBody(
         float mouseX, float mouseY,
         const Simulation::SolarSystem& solarSystem,
         const Render::Camera& camera,
         double simulationTime,
-        bool showLabels
-    );
+        const Render::LabelLayout* labels
+    ) = 0;
     
-private:
-    Platform::WindowInterface& m_window;
+    /// Particle hit by the last pickBody call when it returned no body
+    /// (invalid for pickers that cannot see particles)
+    virtual Simulation::ParticleRef getParticle() const { return {}; }
+    
+protected:
+    /// Label hits apply when no sphere was hit within this distance of the camera
+    static constexpr float LABEL_PRIORITY_DISTANCE = 100.0f;
 };
 
 } // namespace Core
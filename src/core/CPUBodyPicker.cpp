@@ -0,0 +1,95 @@
+#include "CPUBodyPicker.hpp"
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Core {
+
+CPUBodyPicker::CPUBodyPicker(Platform::WindowInterface& window)
+    : m_window(window) {
+}
+
+void CPUBodyPicker::collectSpheres(const Simulation::CelestialBody& body, glm::vec3 parentPos,
+                                   const Simulation::SolarSystem& solarSystem, double simulationTime) {
+    float sysScale = solarSystem.getSystemScale();
+    glm::vec3 worldPos;
+    if (solarSystem.isPhysicsEnabled()) {
+        worldPos = body.getPhysicsPosition() * sysScale;
+    } else {
+        worldPos = parentPos + body.getPosition(simulationTime) * sysScale;
+    }
+    
+    float radius = static_cast<float>(body.getRadius());
+    
+    // Use body type instead of string matching (OCP compliance)
+    if (body.isStar()) {
+        radius = 1.5f; 
+    } else {
+        radius *= solarSystem.getPlanetScale();
+    }
+    
+    m_spheres.push_back(BodyBVH::Sphere{&body, worldPos, std::max(radius, 0.15f)});
+    
+    for (const auto& child : body.getChildren()) {
+        collectSpheres(*child, worldPos, solarSystem, simulationTime);
+    }
+}
+
+const Simulation::CelestialBody* CPUBodyPicker::pickBody(
+    float mouseX, float mouseY,
+    const Simulation::SolarSystem& solarSystem,
+    const Render::Camera& camera,
+    double simulationTime,
+    const Render::LabelLayout* labels
+) {
+    int w, h;
+    m_window.getSize(w, h);
+    
+    PickQuery query;
+    query.mouseX = mouseX;
+    query.mouseY = mouseY;
+    query.width = w;
+    query.height = h;
+    query.view = camera.getViewMatrix();
+    query.projection = camera.getProjectionMatrix();
+    query.simulationTime = simulationTime;
+    query.physicsSteps = solarSystem.getPhysicsStepCount();
+    query.stateGeneration = solarSystem.getStateGeneration();
+    query.labels = labels;
+    query.labelGeneration = labels ? labels->getGeneration() : 0;
+    if (m_hasLastQuery && query == m_lastQuery) {
+        return m_lastResult;
+    }
+    
+    float sw = static_cast<float>(w);
+    float sh = static_cast<float>(h);
+    glm::vec3 rayDir = camera.getRayDirection(mouseX, mouseY, sw, sh);
+    glm::vec3 rayOrigin = camera.getPosition();
+    
+    // Refit the hierarchy to this frame's positions and cast against it
+    m_spheres.clear();
+    for (const auto& body : solarSystem.getBodies()) {
+        collectSpheres(*body, glm::vec3(0.0f), solarSystem, simulationTime);
+    }
+    m_bvh.update(m_spheres, solarSystem.getSystemGeneration());
+    
+    float minDist = 1e10f;
+    const Simulation::CelestialBody* bestBody = m_bvh.raycast(rayOrigin, rayDir, minDist);
+    if (!bestBody) {
+        minDist = 1e10f;
+    }
+    
+    // Label-based picking: only labels that survived decluttering are clickable,
+    // and they lose to a sphere hit that is close to the camera
+    if (labels && minDist > LABEL_PRIORITY_DISTANCE) {
+        if (const Simulation::CelestialBody* labelBody = labels->hitTest(mouseX, mouseY)) {
+            bestBody = labelBody;
+        }
+    }
+    
+    m_lastQuery = query;
+    m_lastResult = bestBody;
+    m_hasLastQuery = true;
+    return bestBody;
+}
+
+} // namespace Core
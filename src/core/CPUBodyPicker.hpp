@@ -0,0 +1,61 @@
+#pragma once
+
+#include "BodyPicker.hpp"
+#include "BodyBVH.hpp"
+#include "platform/WindowInterface.hpp"
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace Core {
+
+/// Ray-cast picking against bodies' pick spheres through a BVH.
+/// Repeated queries with an unchanged mouse, camera and simulation state
+/// return the previous result without touching the bodies.
+class CPUBodyPicker : public BodyPicker {
+public:
+    explicit CPUBodyPicker(Platform::WindowInterface& window);
+    
+    const Simulation::CelestialBody* pickBody(
+        float mouseX, float mouseY,
+        const Simulation::SolarSystem& solarSystem,
+        const Render::Camera& camera,
+        double simulationTime,
+        const Render::LabelLayout* labels
+    ) override;
+    
+    /// Bodies' pick spheres, refit every frame a query runs
+    const BodyBVH& getBVH() const { return m_bvh; }
+    
+private:
+    /// Inputs that fully determine a pick result
+    struct PickQuery {
+        float mouseX = 0.0f;
+        float mouseY = 0.0f;
+        int width = 0;
+        int height = 0;
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        double simulationTime = 0.0;
+        uint64_t physicsSteps = 0;
+        uint64_t stateGeneration = 0;
+        const Render::LabelLayout* labels = nullptr;
+        uint64_t labelGeneration = 0;
+        
+        bool operator==(const PickQuery& other) const = default;
+    };
+    
+    /// Append world-space pick spheres for a body and its children
+    void collectSpheres(const Simulation::CelestialBody& body, glm::vec3 parentPos,
+                        const Simulation::SolarSystem& solarSystem, double simulationTime);
+    
+    Platform::WindowInterface& m_window;
+    BodyBVH m_bvh;
+    std::vector<BodyBVH::Sphere> m_spheres;   // Refilled per query (capacity recycled with the BVH)
+    
+    PickQuery m_lastQuery;
+    const Simulation::CelestialBody* m_lastResult = nullptr;
+    bool m_hasLastQuery = false;
+};
+
+} // namespace Core
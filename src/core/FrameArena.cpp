@@ -0,0 +1,70 @@
+#include "FrameArena.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <new>
+
+namespace Core {
+
+FrameArena::FrameArena(size_t capacity)
+    : m_buffer(static_cast<std::byte*>(::operator new(capacity)))
+    , m_capacity(capacity) {
+}
+
+FrameArena::~FrameArena() {
+    releaseSpills();
+    ::operator delete(m_buffer, m_capacity);
+}
+
+FrameArena& FrameArena::get() {
+    static FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    // Worst-case padding, so a frame whose total fits the capacity never spills
+    m_usedBytes += bytes + alignment - 1;
+
+    void* cursor = m_buffer + m_offset;
+    size_t space = m_capacity - m_offset;
+    if (std::align(alignment, bytes, cursor, space)) {
+        m_offset = static_cast<size_t>(static_cast<std::byte*>(cursor) - m_buffer) + bytes;
+        return cursor;
+    }
+
+    void* data = alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+        ? ::operator new(bytes, std::align_val_t(alignment))
+        : ::operator new(bytes);
+    m_spills.push_back(Spill{data, bytes, alignment});
+    return data;
+}
+
+void FrameArena::releaseSpills() {
+    for (const Spill& spill : m_spills) {
+        if (spill.alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(spill.data, spill.size, std::align_val_t(spill.alignment));
+        } else {
+            ::operator delete(spill.data, spill.size);
+        }
+    }
+    m_spills.clear();
+}
+
+void FrameArena::reset() {
+    m_peakBytes = std::max(m_peakBytes, m_usedBytes);
+    if (!m_spills.empty()) {
+        releaseSpills();
+
+        // Grow once to fit the whole frame rather than spilling again next frame
+        size_t capacity = std::bit_ceil(m_usedBytes);
+        ::operator delete(m_buffer, m_capacity);
+        m_buffer = static_cast<std::byte*>(::operator new(capacity));
+        LOG_DEBUG("FrameArena", "Grew from ", m_capacity / 1024, " KB to ", capacity / 1024, " KB");
+        m_capacity = capacity;
+    }
+    m_offset = 0;
+    m_usedBytes = 0;
+}
+
+} // namespace Core
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace Core {
+
+/// Linear scratch memory for containers that live for one frame.
+///
+/// Allocations bump an offset into a single buffer and are never freed
+/// individually; App::run releases everything at once with reset() at the end
+/// of each iteration. A frame that needs more than the buffer holds spills into
+/// separate heap allocations, and the following reset() grows the buffer to
+/// cover it, so once the working set is known frames make no heap allocations.
+/// Main thread only, and nothing allocated from it may outlive the frame.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t INITIAL_BYTES = 256 * 1024;
+
+    explicit FrameArena(size_t capacity = INITIAL_BYTES);
+    ~FrameArena() override;
+
+    // Non-copyable
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /// Release this frame's allocations, growing the buffer if the frame spilled
+    void reset();
+
+    size_t getCapacity() const { return m_capacity; }
+    /// Bytes requested this frame, including spills and alignment padding
+    size_t getUsedBytes() const { return m_usedBytes; }
+    /// Largest getUsedBytes() seen at a reset
+    size_t getPeakBytes() const { return m_peakBytes; }
+
+    /// The main thread's arena
+    static FrameArena& get();
+
+private:
+    struct Spill {
+        void* data;
+        size_t size;
+        size_t alignment;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}   // Released by reset()
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void releaseSpills();
+
+    std::byte* m_buffer = nullptr;
+    size_t m_capacity = 0;
+    size_t m_offset = 0;
+    size_t m_usedBytes = 0;
+    size_t m_peakBytes = 0;
+    std::vector<Spill> m_spills;
+};
+
+} // namespace Core
@@ -0,0 +1,46 @@
+#include "FramePacer.hpp"
+#include <thread>
+
+namespace Core {
+
+FramePacer::FramePacer(int maxFps) {
+    setMaxFps(maxFps);
+}
+
+void FramePacer::setMaxFps(int maxFps) {
+    m_maxFps = maxFps > 0 ? maxFps : 0;
+    m_period = m_maxFps > 0
+        ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_maxFps))
+        : Clock::duration::zero();
+    m_started = false;
+}
+
+void FramePacer::waitForNextFrame() {
+    if (m_maxFps == 0) return;
+    
+    Clock::time_point now = Clock::now();
+    if (!m_started) {
+        m_deadline = now + m_period;
+        m_started = true;
+        return;
+    }
+    
+    // Coarse sleep, then spin out the last stretch for sub-millisecond accuracy
+    if (m_deadline - now > SPIN_MARGIN) {
+        std::this_thread::sleep_for(m_deadline - now - SPIN_MARGIN);
+    }
+    while (Clock::now() < m_deadline) {
+        std::this_thread::yield();
+    }
+    
+    m_deadline += m_period;
+    
+    // More than a frame behind (a long frame or a stall): restart the cadence
+    // rather than rendering a burst of frames to catch up
+    now = Clock::now();
+    if (now > m_deadline) {
+        m_deadline = now + m_period;
+    }
+}
+
+} // namespace Core
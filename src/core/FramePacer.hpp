@@ -0,0 +1,38 @@
+#pragma once
+
+#include <chrono>
+
+namespace Core {
+
+/// Caps the main loop at a fixed frame rate.
+///
+/// The OS sleep granularity is coarse (often 1 ms or worse), so the pacer
+/// sleeps until SPIN_MARGIN before the deadline and yields in a loop for the
+/// remainder. Deadlines advance by exactly one period, so the average rate holds
+/// even when individual sleeps overshoot.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::microseconds SPIN_MARGIN{1500};
+
+    /// maxFps <= 0 disables the cap
+    explicit FramePacer(int maxFps = 0);
+
+    void setMaxFps(int maxFps);
+    int getMaxFps() const { return m_maxFps; }
+
+    /// Block until the next frame is due. Call once per presented frame.
+    void waitForNextFrame();
+
+    /// Forget the cadence (e.g. after an idle wait) so the next frame isn't rushed
+    void reset() { m_started = false; }
+
+private:
+    int m_maxFps = 0;
+    Clock::duration m_period{};
+    Clock::time_point m_deadline{};
+    bool m_started = false;
+};
+
+} // namespace Core
@@ -0,0 +1,37 @@
+#include "GPUBodyPicker.hpp"
+
+namespace Core {
+
+GPUBodyPicker::GPUBodyPicker(Render::GLRenderer& renderer)
+    : m_renderer(renderer) {
+}
+
+const Simulation::CelestialBody* GPUBodyPicker::pickBody(
+    float mouseX, float mouseY,
+    const Simulation::SolarSystem& solarSystem,
+    [[maybe_unused]] const Render::Camera& camera,
+    [[maybe_unused]] double simulationTime,
+    const Render::LabelLayout* labels
+) {
+    m_renderer.requestPick(mouseX, mouseY);
+    
+    // Bodies in a readback from before a system load no longer exist
+    const Render::PickResult& result = m_renderer.getPickResult();
+    const Simulation::CelestialBody* body = nullptr;
+    m_particle = {};
+    if (result.valid && result.systemGeneration == solarSystem.getSystemGeneration()) {
+        body = result.body;
+        m_particle = result.particle;
+    }
+    
+    // The ID pass carries no depth for labels; they win over particles but not spheres
+    if (!body && labels) {
+        body = labels->hitTest(mouseX, mouseY);
+    }
+    if (body) {
+        m_particle = {};
+    }
+    return body;
+}
+
+} // namespace Core
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "BodyPicker.hpp"
+#include "render/GLRenderer.hpp"
+
+namespace Core {
+
+/// Picking through the renderer's ID buffer.
+///
+/// Each query asks the renderer to draw an ID pass around the cursor and returns
+/// the most recent resolved readback, so results lag the cursor by a frame or
+/// two. Cost is independent of body and particle counts on the CPU side, and
+/// GPU-propagated particles are pickable (see GLRenderer::getPickResult).
+class GPUBodyPicker : public BodyPicker {
+public:
+    explicit GPUBodyPicker(Render::GLRenderer& renderer);
+    
+    const Simulation::CelestialBody* pickBody(
+        float mouseX, float mouseY,
+        const Simulation::SolarSystem& solarSystem,
+        const Render::Camera& camera,
+        double simulationTime,
+        const Render::LabelLayout* labels
+    ) override;
+    
+    Simulation::ParticleRef getParticle() const override { return m_particle; }
+    
+private:
+    Render::GLRenderer& m_renderer;
+    Simulation::ParticleRef m_particle;
+};
+
+} // namespace Core
@@ -28,6 +28,8 @@ void InputManager::setupDefaultBindings() {
     bindKey(SDL_SCANCODE_TAB, InputAction::ToggleCameraMode);
     bindKey(SDL_SCANCODE_O, InputAction::ResetCamera);
     bindKey(SDL_SCANCODE_ESCAPE, InputAction::Quit);
+    bindKey(SDL_SCANCODE_F9, InputAction::DumpProfile);
+    bindKey(SDL_SCANCODE_F12, InputAction::ToggleCapture);
 }
 
 void InputManager::processEvent(const Platform::WindowEvent& event) {
@@ -93,12 +95,12 @@ void InputManager::processEvent(const Platform::WindowEvent& event) {
     }
 }
 
-bool InputManager::isActionActive(const std::string& action) const {
+bool InputManager::isActionActive(std::string_view action) const {
     if (m_uiWantsKeyboard) return false;
     return m_activeActions.find(action) != m_activeActions.end();
 }
 
-bool InputManager::wasActionTriggered(const std::string& action) const {
+bool InputManager::wasActionTriggered(std::string_view action) const {
     if (m_uiWantsKeyboard) return false;
     return m_triggeredActions.find(action) != m_triggeredActions.end();
 }
@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "platform/WindowInterface.hpp"
 
@@ -25,6 +26,8 @@ namespace InputAction {
     constexpr const char* ToggleCameraMode = "toggle_camera_mode";
     constexpr const char* ResetCamera = "reset_camera";
     constexpr const char* Quit = "quit";
+    constexpr const char* DumpProfile = "dump_profile";
+    constexpr const char* ToggleCapture = "toggle_capture";
 }
 
 /// Manages input state and action bindings
@@ -36,10 +39,10 @@ public:
     void processEvent(const Platform::WindowEvent& event);
     
     /// Check if an action is currently active (key held down)
-    bool isActionActive(const std::string& action) const;
+    bool isActionActive(std::string_view action) const;
     
     /// Check if an action was just triggered this frame
-    bool wasActionTriggered(const std::string& action) const;
+    bool wasActionTriggered(std::string_view action) const;
     
     /// Get mouse position
     void getMousePosition(float& x, float& y) const;
@@ -66,16 +69,24 @@ public:
     bool uiWantsMouse() const { return m_uiWantsMouse; }
 
 private:
+    /// Lets the action sets be queried by string_view, without building a
+    /// std::string per lookup (longer names would be heap-allocated every frame)
+    struct ActionHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view action) const { return std::hash<std::string_view>{}(action); }
+    };
+    using ActionSet = std::unordered_set<std::string, ActionHash, std::equal_to<>>;
+    
     void setupDefaultBindings();
     
     // Key bindings: scancode -> action name
     std::unordered_map<int, std::string> m_keyBindings;
     
     // Currently active actions (keys held down)
-    std::unordered_set<std::string> m_activeActions;
+    ActionSet m_activeActions;
     
     // Actions triggered this frame (key just pressed)
-    std::unordered_set<std::string> m_triggeredActions;
+    ActionSet m_triggeredActions;
     
     // Mouse state
     float m_mouseX = 0.0f;
@@ -89,8 +89,11 @@ private:
         auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
             now.time_since_epoch()) % 1000;
         
+        // Loads log from background threads; localtime() shares a static buffer
+        std::tm local{};
+        localtime_r(&time, &local);
         std::ostringstream oss;
-        oss << std::put_time(std::localtime(&time), "%H:%M:%S");
+        oss << std::put_time(&local, "%H:%M:%S");
         oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
         return oss.str();
     }
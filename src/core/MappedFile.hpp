@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Core {
+
+/// Read-only memory mapping of a whole file.
+///
+/// The mapping stays valid for the lifetime of the object, so data structures
+/// laid out in the file can be read in place without copying. Pages are
+/// faulted in lazily by the OS and shared with the page cache.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Movable
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// Map `filePath`, replacing any previous mapping. Returns false on failure.
+    bool open(const std::string& filePath);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    /// Unique sibling of `filePath` to write before renaming it into place, so
+    /// writers on other threads or in other processes never share a temporary file
+    static std::string getTempPath(const std::string& filePath);
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+} // namespace Core
@@ -0,0 +1,27 @@
+#include "MemoryStats.hpp"
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace Core {
+
+size_t MemoryStats::getCurrentRss() {
+    // Second field of statm is the resident page count
+    std::FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+    unsigned long totalPages = 0;
+    unsigned long residentPages = 0;
+    int fields = std::fscanf(file, "%lu %lu", &totalPages, &residentPages);
+    std::fclose(file);
+    if (fields != 2) return 0;
+    return static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+size_t MemoryStats::getPeakRss() {
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    // Linux reports kilobytes
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+} // namespace Core
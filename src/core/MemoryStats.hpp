@@ -0,0 +1,29 @@
+#pragma once
+
+#include "AllocationTracker.hpp"
+#include <cstddef>
+
+namespace Core {
+
+/// Process-wide memory figures from the OS (0 where unavailable)
+class MemoryStats {
+public:
+    /// Resident set size right now, in bytes
+    static size_t getCurrentRss();
+
+    /// Highest resident set size since the process started, in bytes
+    static size_t getPeakRss();
+};
+
+/// Memory figures App samples for the debug panel and the periodic log line
+struct MemoryReport {
+    size_t rssBytes = 0;
+    size_t peakRssBytes = 0;
+    size_t gpuBufferBytes = 0;      // Buffer objects the renderer holds
+    size_t pooledBodyBytes = 0;     // Free body arena blocks kept for the next load
+    size_t budgetBytes = 0;         // --memory-budget-mb (0 = none)
+    AllocationSnapshot frame;       // Heap allocations during the last frame (tracking builds)
+    AllocationSnapshot total;       // Since startup
+};
+
+} // namespace Core
@@ -0,0 +1,83 @@
+#include "ThreadPool.hpp"
+#include "AllocationTracker.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace Core {
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        m_workers.emplace_back([this](std::stop_token stopToken) { workerLoop(stopToken); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    for (auto& worker : m_workers) {
+        worker.request_stop();
+    }
+    // jthread joins on destruction; clear before the queue and mutex go away
+    m_workers.clear();
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::workerLoop(std::stop_token stopToken) {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_condition.wait(lock, stopToken, [this]() { return !m_tasks.empty(); })) {
+                return;     // Stop requested
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0) return;
+    
+    std::atomic<size_t> next{0};
+    // Workers charge their allocations to whatever the caller is doing
+    const AllocationTag tag = AllocationScope::getCurrent();
+    auto worker = [&]() {
+        AllocationScope scope(tag);
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i);
+        }
+    };
+    
+    size_t taskCount = std::min<size_t>(count, m_workers.size());
+    std::vector<std::future<void>> futures;
+    futures.reserve(taskCount);
+    for (size_t t = 0; t < taskCount; ++t) {
+        futures.push_back(submit(worker));
+    }
+    
+    // Wait for every task before rethrowing, since they reference this frame
+    std::exception_ptr error;
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Core {
+
+/// Fixed set of worker threads consuming a FIFO task queue.
+/// Tasks still queued when the pool is destroyed are dropped (their futures
+/// report std::future_error); running tasks are finished first.
+class ThreadPool {
+public:
+    /// threadCount 0 uses the hardware concurrency
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    // Non-copyable
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Queue a task; the future yields its result or rethrows its exception
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& task) {
+        using Result = std::invoke_result_t<F>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    /// Run body(i) for i in [0, count) across the workers and wait for all of
+    /// them. Indices are handed out one at a time, so uneven items balance out.
+    /// The first exception thrown by `body` is rethrown here.
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    unsigned getThreadCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+private:
+    void enqueue(std::function<void()> task);
+    void workerLoop(std::stop_token stopToken);
+
+    std::mutex m_mutex;
+    std::condition_variable_any m_condition;
+    std::deque<std::function<void()>> m_tasks;
+    std::vector<std::jthread> m_workers;
+};
+
+} // namespace Core
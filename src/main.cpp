@@ -1,7 +1,13 @@
 #include "core/App.hpp"
 #include "core/Logger.hpp"
+#include <cerrno>
+#include <climits>
 #include <csignal>
 #include <exception>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 
 // Forward declaration from App.cpp
 namespace Core {
@@ -30,21 +36,146 @@ namespace {
         sigaction(SIGINT, &sa, nullptr);
         sigaction(SIGTERM, &sa, nullptr);
     }
+    
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "  --headless         Render offscreen via EGL (no window, no input)\n"
+                  << "  --frames N         Exit after N frames and report frame times\n"
+                  << "  --size WxH         Window / framebuffer size (default 1280x720)\n"
+                  << "  --capture DIR      Write every frame to DIR (F12 toggles capture)\n"
+                  << "  --capture-format F png (default) or raw (RGBA8, for ffmpeg rawvideo)\n"
+                  << "  --capture-fps N    Advance the simulation 1/N s per captured frame\n"
+                  << "  --capture-ui       Include the UI overlay in captured frames\n"
+                  << "  --on-demand        Only redraw when something changed (idle sleeps until input)\n"
+                  << "  --max-fps N        Cap the frame rate at N (sleep + spin pacing)\n"
+                  << "  --gpu-picking      Pick bodies and particles through a GPU ID buffer\n"
+                  << "  --system NAME      Start with this system (default \"Solar System\")\n"
+                  << "  --systems-dir DIR  Also list the systems in DIR (repeatable)\n"
+                  << "  --warm-cache       Parse all systems in the background for instant switching\n"
+                  << "  --system-cache-mb N  Memory budget for cached systems (default 512, 0 = off)\n"
+                  << "  --memory-budget-mb N Warn when peak resident memory exceeds N MB; --frames\n"
+                  << "                       runs then exit with an error (0 = off)\n"
+                  << "  --help             Show this message\n";
+    }
+    
+    /// Parse a whole decimal integer no smaller than `minValue`; false on
+    /// trailing garbage or out-of-range values
+    bool parseInt(const char* text, int minValue, int& out) {
+        char* end = nullptr;
+        errno = 0;
+        long value = std::strtol(text, &end, 10);
+        if (end == text || *end != '\0' || errno == ERANGE || value < minValue || value > INT_MAX) {
+            return false;
+        }
+        out = static_cast<int>(value);
+        return true;
+    }
+    
+    /// Parse command-line arguments; returns false if the program should exit
+    bool parseArguments(int argc, char* argv[], Core::AppOptions& options, int& exitCode) {
+        for (int i = 1; i < argc; ++i) {
+            const char* arg = argv[i];
+            bool hasValue = (i + 1 < argc);
+            
+            if (std::strcmp(arg, "--headless") == 0) {
+                options.headless = true;
+            } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+                if (!parseInt(argv[++i], 1, options.maxFrames)) {
+                    std::cerr << "Invalid frame count: " << argv[i] << "\n";
+                    exitCode = 1;
+                    return false;
+                }
+            } else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+                int w = 0, h = 0;
+                if (std::sscanf(argv[++i], "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0) {
+                    std::cerr << "Invalid size: " << argv[i] << "\n";
+                    exitCode = 1;
+                    return false;
+                }
+                options.width = w;
+                options.height = h;
+            } else if (std::strcmp(arg, "--capture") == 0 && hasValue) {
+                options.captureDirectory = argv[++i];
+            } else if (std::strcmp(arg, "--capture-format") == 0 && hasValue) {
+                const char* format = argv[++i];
+                if (std::strcmp(format, "png") == 0) {
+                    options.captureFormat = Render::CaptureFormat::Png;
+                } else if (std::strcmp(format, "raw") == 0) {
+                    options.captureFormat = Render::CaptureFormat::Raw;
+                } else {
+                    std::cerr << "Invalid capture format: " << format << "\n";
+                    exitCode = 1;
+                    return false;
+                }
+            } else if (std::strcmp(arg, "--capture-fps") == 0 && hasValue) {
+                if (!parseInt(argv[++i], 1, options.captureFps)) {
+                    std::cerr << "Invalid capture rate: " << argv[i] << "\n";
+                    exitCode = 1;
+                    return false;
+                }
+            } else if (std::strcmp(arg, "--capture-ui") == 0) {
+                options.captureUI = true;
+            } else if (std::strcmp(arg, "--gpu-picking") == 0) {
+                options.gpuPicking = true;
+            } else if (std::strcmp(arg, "--system") == 0 && hasValue) {
+                options.startupSystem = argv[++i];
+            } else if (std::strcmp(arg, "--systems-dir") == 0 && hasValue) {
+                options.systemDirectories.push_back(argv[++i]);
+            } else if (std::strcmp(arg, "--warm-cache") == 0) {
+                options.warmSystemCache = true;
+            } else if (std::strcmp(arg, "--system-cache-mb") == 0 && hasValue) {
+                if (!parseInt(argv[++i], 0, options.systemCacheMb)) {
+                    std::cerr << "Invalid system cache budget: " << argv[i] << "\n";
+                    exitCode = 1;
+                    return false;
+                }
+            } else if (std::strcmp(arg, "--memory-budget-mb") == 0 && hasValue) {
+                if (!parseInt(argv[++i], 0, options.memoryBudgetMb)) {
+                    std::cerr << "Invalid memory budget: " << argv[i] << "\n";
+                    exitCode = 1;
+                    return false;
+                }
+            } else if (std::strcmp(arg, "--on-demand") == 0) {
+                options.renderOnDemand = true;
+            } else if (std::strcmp(arg, "--max-fps") == 0 && hasValue) {
+                if (!parseInt(argv[++i], 0, options.maxFps)) {
+                    std::cerr << "Invalid frame-rate cap: " << argv[i] << "\n";
+                    exitCode = 1;
+                    return false;
+                }
+            } else if (std::strcmp(arg, "--help") == 0) {
+                printUsage(argv[0]);
+                exitCode = 0;
+                return false;
+            } else {
+                std::cerr << "Unknown or incomplete argument: " << arg << "\n";
+                printUsage(argv[0]);
+                exitCode = 1;
+                return false;
+            }
+        }
+        return true;
+    }
 }
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    Core::AppOptions options;
+    int exitCode = 0;
+    if (!parseArguments(argc, argv, options, exitCode)) {
+        return exitCode;
+    }
 
     setupSignalHandlers();
     LOG_INFO("Main", "Starting Solar System Simulator...");
 
-    int exitCode = 0;
-    
     try {
-        Core::App app;
+        Core::App app(options);
         app.run();
         LOG_INFO("Main", "Application exited normally");
+        if (options.maxFrames > 0 && app.exceededMemoryBudget()) {
+            LOG_ERROR("Main", "Run exceeded its memory budget of ", options.memoryBudgetMb, " MB");
+            exitCode = 1;
+        }
     } catch (const std::exception& e) {
         LOG_FATAL("Main", "Fatal error: ", e.what());
         exitCode = 1;
@@ -0,0 +1,190 @@
+#include "HeadlessWindow.hpp"
+#include "core/Logger.hpp"
+#include <stdexcept>
+#include <cstring>
+#include <GL/glew.h>
+
+#ifdef SPACE_SIM_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+namespace Platform {
+
+HeadlessWindow::HeadlessWindow(int width, int height)
+    : m_width(width)
+    , m_height(height) {
+#ifndef SPACE_SIM_HAS_EGL
+    throw std::runtime_error("Headless mode unavailable: built without EGL support");
+#endif
+}
+
+HeadlessWindow::~HeadlessWindow() {
+#ifdef SPACE_SIM_HAS_EGL
+    if (m_context) {
+        destroyFramebuffer();
+        EGLDisplay display = static_cast<EGLDisplay>(m_display);
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, static_cast<EGLContext>(m_context));
+    }
+    if (m_display) {
+        eglTerminate(static_cast<EGLDisplay>(m_display));
+    }
+    LOG_INFO("HeadlessWindow", "Headless context destroyed");
+#endif
+}
+
+void HeadlessWindow::createGLContext() {
+#ifdef SPACE_SIM_HAS_EGL
+    // Prefer Mesa's surfaceless platform: no window system needed at all
+    EGLDisplay display = EGL_NO_DISPLAY;
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (clientExtensions && std::strstr(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        throw std::runtime_error("Failed to get an EGL display");
+    }
+
+    EGLint major = 0, minor = 0;
+    if (!eglInitialize(display, &major, &minor)) {
+        throw std::runtime_error("Failed to initialize EGL");
+    }
+    m_display = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        throw std::runtime_error("EGL implementation does not support desktop OpenGL");
+    }
+
+    const char* displayExtensions = eglQueryString(display, EGL_EXTENSIONS);
+    if (!displayExtensions || !std::strstr(displayExtensions, "EGL_KHR_surfaceless_context")) {
+        throw std::runtime_error("EGL_KHR_surfaceless_context not supported");
+    }
+
+    // No surface is ever created, so any GL-renderable config will do
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    if (!std::strstr(displayExtensions, "EGL_KHR_no_config_context")) {
+        const EGLint configAttribs[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_NONE
+        };
+        EGLint numConfigs = 0;
+        if (!eglChooseConfig(display, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+            throw std::runtime_error("No EGL config supports desktop OpenGL");
+        }
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        throw std::runtime_error("Failed to create EGL OpenGL 3.3 core context");
+    }
+    m_context = context;
+
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        throw std::runtime_error("Failed to make EGL context current");
+    }
+
+    // Initialize GLEW. GLX-enabled GLEW builds report a missing X display after
+    // loading all GL entry points; that is expected without a window system.
+    glewExperimental = GL_TRUE;
+    GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY) {
+        err = GLEW_OK;
+    }
+#endif
+    if (GLEW_OK != err) {
+        throw std::runtime_error("Failed to initialize GLEW: " + std::string((const char*)glewGetErrorString(err)));
+    }
+
+    createFramebuffer();
+
+    LOG_INFO("HeadlessWindow", "EGL ", major, ".", minor, " headless context created - Version: ",
+             (const char*)glGetString(GL_VERSION), ", Renderer: ", (const char*)glGetString(GL_RENDERER));
+#endif
+}
+
+void HeadlessWindow::createFramebuffer() {
+    glGenRenderbuffers(1, &m_colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_width, m_height);
+
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("Headless framebuffer is incomplete");
+    }
+
+    // Leave the FBO bound: it stands in for the default framebuffer
+    glViewport(0, 0, m_width, m_height);
+}
+
+void HeadlessWindow::destroyFramebuffer() {
+    if (m_framebuffer) {
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    if (m_colorBuffer) {
+        glDeleteRenderbuffers(1, &m_colorBuffer);
+        m_colorBuffer = 0;
+    }
+    if (m_depthBuffer) {
+        glDeleteRenderbuffers(1, &m_depthBuffer);
+        m_depthBuffer = 0;
+    }
+}
+
+void HeadlessWindow::getSize(int& width, int& height) const {
+    width = m_width;
+    height = m_height;
+}
+
+void HeadlessWindow::setTitle(const std::string& title) {
+    (void)title;
+}
+
+void HeadlessWindow::swapBuffers() {
+    // No presentation; finish so per-frame timings include all GPU work
+    glFinish();
+}
+
+void HeadlessWindow::makeContextCurrent() {
+#ifdef SPACE_SIM_HAS_EGL
+    eglMakeCurrent(static_cast<EGLDisplay>(m_display), EGL_NO_SURFACE, EGL_NO_SURFACE,
+                   static_cast<EGLContext>(m_context));
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+#endif
+}
+
+void HeadlessWindow::pollEvents(EventCallback callback) {
+    (void)callback;  // No input sources without a window
+}
+
+bool HeadlessWindow::waitForEvent(int timeoutMs) {
+    (void)timeoutMs;  // Nothing will ever arrive; never block
+    return false;
+}
+
+} // namespace Platform
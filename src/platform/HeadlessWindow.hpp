@@ -0,0 +1,56 @@
+#pragma once
+
+#include "WindowInterface.hpp"
+#include <string>
+
+namespace Platform {
+
+/// Windowless backend for benchmark and capture runs on display-less machines.
+///
+/// Creates a core 3.3 OpenGL context through EGL on Mesa's surfaceless platform
+/// (falling back to the default EGL display) and renders into an offscreen FBO
+/// that stays bound as the draw framebuffer. Works with Mesa's llvmpipe software
+/// rasterizer, so no GPU or X/Wayland server is required.
+class HeadlessWindow : public WindowInterface {
+public:
+    HeadlessWindow(int width, int height);
+    ~HeadlessWindow() override;
+
+    // Non-copyable
+    HeadlessWindow(const HeadlessWindow&) = delete;
+    HeadlessWindow& operator=(const HeadlessWindow&) = delete;
+
+    // WindowInterface implementation
+    bool shouldClose() const override { return m_shouldClose; }
+    void getSize(int& width, int& height) const override;
+    void* getNativeHandle() const override { return nullptr; }
+    void* getGLContext() const override { return m_context; }
+    void setTitle(const std::string& title) override;
+    void swapBuffers() override;
+    void makeContextCurrent() override;
+    void pollEvents(EventCallback callback) override;
+    bool waitForEvent(int timeoutMs) override;
+
+    /// Create the EGL context and offscreen framebuffer (call after construction)
+    void createGLContext();
+
+    /// Offscreen framebuffer that receives all rendering
+    unsigned int getFramebuffer() const { return m_framebuffer; }
+
+private:
+    void createFramebuffer();
+    void destroyFramebuffer();
+
+    int m_width;
+    int m_height;
+    bool m_shouldClose = false;
+
+    void* m_display = nullptr;   // EGLDisplay
+    void* m_context = nullptr;   // EGLContext
+
+    unsigned int m_framebuffer = 0;
+    unsigned int m_colorBuffer = 0;
+    unsigned int m_depthBuffer = 0;
+};
+
+} // namespace Platform
@@ -83,6 +83,11 @@ void SDLWindow::makeContextCurrent() {
     SDL_GL_MakeCurrent(m_window, m_glContext);
 }
 
+bool SDLWindow::waitForEvent(int timeoutMs) {
+    // A null event leaves it in the queue for pollEvents
+    return SDL_WaitEventTimeout(nullptr, timeoutMs);
+}
+
 void SDLWindow::pollEvents(EventCallback callback) {
     SDL_Event sdlEvent;
     while (SDL_PollEvent(&sdlEvent)) {
@@ -20,13 +20,12 @@ public:
     bool shouldClose() const override { return m_shouldClose; }
     void getSize(int& width, int& height) const override;
     void* getNativeHandle() const override { return m_window; }
+    void* getGLContext() const override { return m_glContext; }
     void setTitle(const std::string& title) override;
     void swapBuffers() override;
     void makeContextCurrent() override;
     void pollEvents(EventCallback callback) override;
-    
-    /// Get the OpenGL context
-    SDL_GLContext getGLContext() const { return m_glContext; }
+    bool waitForEvent(int timeoutMs) override;
     
     /// Create OpenGL context (call after construction)
     void createGLContext();
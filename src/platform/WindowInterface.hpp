@@ -47,9 +47,12 @@ public:
     /// Get window dimensions
     virtual void getSize(int& width, int& height) const = 0;
     
-    /// Get native window handle (platform-specific)
+    /// Get native window handle (platform-specific, nullptr for headless backends)
     virtual void* getNativeHandle() const = 0;
     
+    /// Get the OpenGL context handle (platform-specific)
+    virtual void* getGLContext() const = 0;
+    
     /// Set window title
     virtual void setTitle(const std::string& title) = 0;
     
@@ -62,6 +65,10 @@ public:
     /// Process window events and return them via callback
     using EventCallback = std::function<void(const WindowEvent&)>;
     virtual void pollEvents(EventCallback callback) = 0;
+    
+    /// Block until an event is pending or timeoutMs elapses, without consuming it.
+    /// Returns true if an event is waiting (follow with pollEvents).
+    virtual bool waitForEvent(int timeoutMs) = 0;
 };
 
 } // namespace Platform
@@ -23,6 +23,8 @@ public:
     const glm::mat4& getProjectionMatrix() const { return m_projectionMatrix; }
     glm::vec3 getPosition() const { return m_position; }
     CameraMode getMode() const { return m_mode; }
+    float getNearPlane() const { return m_nearPlane; }
+    float getFarPlane() const { return m_farPlane; }
 
     // Input handling - call these based on user input
     void handleMouseDrag(float deltaX, float deltaY);
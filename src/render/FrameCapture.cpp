@@ -0,0 +1,348 @@
+#include "FrameCapture.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Render {
+
+namespace {
+
+/// CRC-32 (ISO 3309) as required for PNG chunks
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1u) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void writeChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> header;
+    putU32(header, static_cast<uint32_t>(data.size()));
+    header.insert(header.end(), type, type + 4);
+
+    uint32_t crc = crc32Update(0, header.data() + 4, 4);
+    crc = crc32Update(crc, data.data(), data.size());
+
+    std::vector<uint8_t> trailer;
+    putU32(trailer, crc);
+
+    file.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    file.write(reinterpret_cast<const char*>(trailer.data()), static_cast<std::streamsize>(trailer.size()));
+}
+
+/// Write an RGBA8 PNG using stored (uncompressed) deflate blocks.
+/// Encoding is a straight copy plus checksums, so the encoder thread keeps up
+/// with real-time capture; recompress offline if file size matters.
+bool writePng(const std::filesystem::path& path, int width, int height, const uint8_t* bottomUpPixels) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<uint8_t> ihdr;
+    putU32(ihdr, static_cast<uint32_t>(width));
+    putU32(ihdr, static_cast<uint32_t>(height));
+    ihdr.push_back(8);  // Bit depth
+    ihdr.push_back(6);  // Colour type: RGBA
+    ihdr.push_back(0);  // Compression
+    ihdr.push_back(0);  // Filter
+    ihdr.push_back(0);  // Interlace
+    writeChunk(file, "IHDR", ihdr);
+
+    // Filtered scanlines: a zero filter byte before each top-down row
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    const size_t rawSize = (rowBytes + 1) * static_cast<size_t>(height);
+    constexpr size_t MAX_STORED_BLOCK = 65535;
+    const size_t blockCount = (rawSize + MAX_STORED_BLOCK - 1) / MAX_STORED_BLOCK;
+
+    std::vector<uint8_t> idat;
+    idat.reserve(2 + rawSize + blockCount * 5 + 4);
+    idat.push_back(0x78);  // zlib header: deflate, 32K window
+    idat.push_back(0x01);  // No preset dictionary, fastest level
+
+    uint32_t adlerA = 1;
+    uint32_t adlerB = 0;
+    size_t remaining = rawSize;
+    size_t blockFill = 0;
+
+    auto appendRaw = [&](const uint8_t* data, size_t length) {
+        while (length > 0) {
+            if (blockFill == 0) {
+                size_t blockSize = std::min(remaining, MAX_STORED_BLOCK);
+                remaining -= blockSize;
+                idat.push_back(remaining == 0 ? 1 : 0);  // BFINAL, BTYPE=00
+                idat.push_back(static_cast<uint8_t>(blockSize));
+                idat.push_back(static_cast<uint8_t>(blockSize >> 8));
+                idat.push_back(static_cast<uint8_t>(~blockSize));
+                idat.push_back(static_cast<uint8_t>(~blockSize >> 8));
+                blockFill = blockSize;
+            }
+            size_t n = std::min(length, blockFill);
+            idat.insert(idat.end(), data, data + n);
+            for (size_t i = 0; i < n; ++i) {
+                adlerA = (adlerA + data[i]) % 65521u;
+                adlerB = (adlerB + adlerA) % 65521u;
+            }
+            data += n;
+            length -= n;
+            blockFill -= n;
+        }
+    };
+
+    const uint8_t filterNone = 0;
+    for (int y = height - 1; y >= 0; --y) {
+        appendRaw(&filterNone, 1);
+        appendRaw(bottomUpPixels + static_cast<size_t>(y) * rowBytes, rowBytes);
+    }
+    putU32(idat, (adlerB << 16) | adlerA);
+    writeChunk(file, "IDAT", idat);
+    writeChunk(file, "IEND", {});
+
+    return static_cast<bool>(file);
+}
+
+/// Write top-down RGBA8 with no header (ffmpeg -f rawvideo -pix_fmt rgba)
+bool writeRaw(const std::filesystem::path& path, int width, int height, const uint8_t* bottomUpPixels) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (int y = height - 1; y >= 0; --y) {
+        file.write(reinterpret_cast<const char*>(bottomUpPixels + static_cast<size_t>(y) * rowBytes),
+                   static_cast<std::streamsize>(rowBytes));
+    }
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+FrameCapture::FrameCapture() = default;
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+bool FrameCapture::start(const CaptureSettings& settings, int width, int height) {
+    if (m_active) {
+        stop();
+    }
+    if (width <= 0 || height <= 0) {
+        LOG_ERROR("FrameCapture", "Invalid capture size ", width, "x", height);
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(settings.directory, ec);
+    if (ec) {
+        LOG_ERROR("FrameCapture", "Cannot create capture directory ", settings.directory, ": ", ec.message());
+        return false;
+    }
+
+    m_settings = settings;
+    m_width = width;
+    m_height = height;
+    m_nextSlot = 0;
+    m_frameIndex = 0;
+    m_framesCaptured = 0;
+    m_framesDropped = 0;
+
+    createBuffers();
+
+    m_stopEncoder = false;
+    m_encoder = std::thread(&FrameCapture::encoderLoop, this);
+    m_active = true;
+
+    LOG_INFO("FrameCapture", "Capturing ", width, "x", height, " ",
+             settings.format == CaptureFormat::Png ? "PNG" : "raw RGBA",
+             " frames to ", settings.directory);
+    return true;
+}
+
+void FrameCapture::stop() {
+    if (!m_active) return;
+
+    // Resolve outstanding readbacks oldest first so the sequence stays ordered
+    for (int i = 0; i < PBO_COUNT; ++i) {
+        Slot& slot = m_slots[(m_nextSlot + i) % PBO_COUNT];
+        if (slot.pending) {
+            resolveSlot(slot);
+        }
+    }
+    destroyBuffers();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopEncoder = true;
+    }
+    m_queueChanged.notify_all();
+    if (m_encoder.joinable()) {
+        m_encoder.join();
+    }
+    m_queue.clear();
+    m_freeBuffers.clear();
+    m_active = false;
+
+    LOG_INFO("FrameCapture", "Capture stopped: ", m_framesCaptured, " frames captured, ",
+             m_framesDropped, " dropped");
+}
+
+void FrameCapture::createBuffers() {
+    const GLsizeiptr frameBytes = static_cast<GLsizeiptr>(m_width) * m_height * 4;
+    for (Slot& slot : m_slots) {
+        glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+        slot.fence = nullptr;
+        slot.pending = false;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void FrameCapture::destroyBuffers() {
+    for (Slot& slot : m_slots) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        if (slot.pbo) {
+            glDeleteBuffers(1, &slot.pbo);
+            slot.pbo = 0;
+        }
+        slot.pending = false;
+    }
+}
+
+void FrameCapture::captureFrame() {
+    if (!m_active) return;
+
+    // The slot we are about to reuse was filled PBO_COUNT frames ago and is
+    // almost always complete by now; the wait below is then a no-op
+    Slot& slot = m_slots[m_nextSlot];
+    if (slot.pending) {
+        resolveSlot(slot);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.frameIndex = m_frameIndex++;
+    slot.pending = true;
+
+    m_nextSlot = (m_nextSlot + 1) % PBO_COUNT;
+}
+
+void FrameCapture::resolveSlot(Slot& slot) {
+    slot.pending = false;
+    if (slot.fence) {
+        glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+    }
+
+    // Reserve space in the encoder queue before paying for the copy
+    std::vector<uint8_t> pixels;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_queue.size() >= MAX_QUEUED_FRAMES) {
+            if (!m_settings.lossless) {
+                // Real-time capture: keep the frame rate, lose the frame
+                ++m_framesDropped;
+                return;
+            }
+            m_queueChanged.wait(lock, [this] { return m_queue.size() < MAX_QUEUED_FRAMES; });
+        }
+        if (!m_freeBuffers.empty()) {
+            pixels = std::move(m_freeBuffers.back());
+            m_freeBuffers.pop_back();
+        }
+    }
+
+    const size_t frameBytes = static_cast<size_t>(m_width) * m_height * 4;
+    pixels.resize(frameBytes);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(frameBytes), GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(pixels.data(), mapped, frameBytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!mapped) {
+        LOG_WARN("FrameCapture", "Failed to map readback buffer for frame ", slot.frameIndex);
+        ++m_framesDropped;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(EncodedFrame{slot.frameIndex, std::move(pixels)});
+    }
+    m_queueChanged.notify_all();
+    ++m_framesCaptured;
+}
+
+void FrameCapture::encoderLoop() {
+    for (;;) {
+        EncodedFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queueChanged.wait(lock, [this] { return m_stopEncoder || !m_queue.empty(); });
+            if (m_queue.empty()) {
+                return;  // Stop requested and everything written
+            }
+            frame = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        m_queueChanged.notify_all();
+
+        if (!writeFrame(frame)) {
+            LOG_ERROR("FrameCapture", "Failed to write frame ", frame.frameIndex);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_freeBuffers.push_back(std::move(frame.pixels));
+    }
+}
+
+bool FrameCapture::writeFrame(const EncodedFrame& frame) const {
+    const bool png = m_settings.format == CaptureFormat::Png;
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06llu.%s",
+                  static_cast<unsigned long long>(frame.frameIndex), png ? "png" : "rgba");
+
+    std::filesystem::path path = std::filesystem::path(m_settings.directory) / name;
+    return png ? writePng(path, m_width, m_height, frame.pixels.data())
+               : writeRaw(path, m_width, m_height, frame.pixels.data());
+}
+
+} // namespace Render
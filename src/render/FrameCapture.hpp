@@ -0,0 +1,106 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Render {
+
+/// Output format for captured frames
+enum class CaptureFormat {
+    Png,    // Uncompressed (stored-deflate) PNG per frame
+    Raw     // Tightly packed top-down RGBA8 per frame
+};
+
+/// Capture configuration
+struct CaptureSettings {
+    std::string directory = "capture";
+    CaptureFormat format = CaptureFormat::Png;
+    bool includeUI = false;   // Capture after the ImGui pass instead of before it
+    bool lossless = false;    // Block instead of dropping frames when the encoder falls behind
+};
+
+/// Asynchronous frame capture to an image sequence.
+///
+/// Each captured frame is read into one of PBO_COUNT pixel buffer objects with
+/// glReadPixels (which returns immediately when a PBO is bound). The buffer is
+/// mapped PBO_COUNT frames later, once its fence has signaled, and the pixels are
+/// handed to a background encoder thread that writes the files. The render loop
+/// never waits on the GPU or on disk unless the encoder falls far behind.
+class FrameCapture {
+public:
+    static constexpr int PBO_COUNT = 3;
+    static constexpr size_t MAX_QUEUED_FRAMES = 8;
+
+    FrameCapture();
+    ~FrameCapture();
+
+    // Non-copyable
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /// Begin capturing frames of the given size into settings.directory
+    bool start(const CaptureSettings& settings, int width, int height);
+
+    /// Flush in-flight readbacks, finish writing queued frames and stop
+    void stop();
+
+    /// Queue an asynchronous readback of the currently bound read framebuffer
+    void captureFrame();
+
+    bool isActive() const { return m_active; }
+    const CaptureSettings& getSettings() const { return m_settings; }
+    uint64_t getFramesCaptured() const { return m_framesCaptured; }
+    uint64_t getFramesDropped() const { return m_framesDropped; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        uint64_t frameIndex = 0;
+        bool pending = false;
+    };
+
+    struct EncodedFrame {
+        uint64_t frameIndex = 0;
+        std::vector<uint8_t> pixels;   // Bottom-up RGBA8 as returned by GL
+    };
+
+    void createBuffers();
+    void destroyBuffers();
+
+    /// Map a pending slot and queue its pixels for encoding
+    void resolveSlot(Slot& slot);
+
+    void encoderLoop();
+    bool writeFrame(const EncodedFrame& frame) const;
+
+    CaptureSettings m_settings;
+    int m_width = 0;
+    int m_height = 0;
+    bool m_active = false;
+
+    std::array<Slot, PBO_COUNT> m_slots{};
+    int m_nextSlot = 0;
+    uint64_t m_frameIndex = 0;
+    uint64_t m_framesCaptured = 0;
+    uint64_t m_framesDropped = 0;
+
+    // Encoder thread state (guarded by m_mutex)
+    std::thread m_encoder;
+    std::mutex m_mutex;
+    std::condition_variable m_queueChanged;
+    std::deque<EncodedFrame> m_queue;
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+    bool m_stopEncoder = false;
+};
+
+} // namespace Render
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Render {
+
+/// Render passes measured by the GPU profiler
+enum class ProfilePass : int {
+    Bodies = 0,
+    Orbits,
+    Trails,
+    Particles,
+    UI,
+    Capture,
+    Picking,
+    Count
+};
+
+/// Rolling timing statistics for one pass, in milliseconds
+struct PassTiming {
+    const char* name = "";
+    double lastMs = 0.0;
+    double avgMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+/// Per-frame renderer statistics handed to the UI
+struct FrameStats {
+    std::array<PassTiming, static_cast<int>(ProfilePass::Count)> gpuPasses{};
+    double gpuTotalMs = 0.0;
+    bool gpuTimingSupported = false;
+    
+    // Particle populations
+    size_t particlesDrawn = 0;
+    size_t particlesTotal = 0;
+    
+    // Frame capture progress
+    bool capturing = false;
+    uint64_t capturedFrames = 0;
+    uint64_t droppedFrames = 0;
+    
+    // Adaptive quality (-1 when the governor is disabled)
+    int qualityLevel = -1;
+    float renderScale = 1.0f;
+    float cpuFrameMs = 0.0f;
+    
+    // Buffer objects held for meshes, streaming, trails and particles
+    size_t gpuBufferBytes = 0;
+};
+
+} // namespace Render
@@ -4,61 +4,60 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
-#include <functional>
+#include <algorithm>
 
 namespace Render {
 
-void GLRenderer::drawOrbit(const Simulation::CelestialBody& body,
-                           const glm::mat4& parentTransform,
-                           const glm::mat4& view,
-                           const glm::mat4& proj,
-                           float visualDistanceScale,
-                           const glm::vec3& color,
-                           float opacity,
-                           int segments) {
-    GLuint orbitShader = m_shaderManager->getShader(SHADER_ORBIT);
-    glUseProgram(orbitShader);
-    
+void GLRenderer::drawOrbit(const DrawCommand& command) {
+    GLuint orbitShader = command.shader;
     GLint oModelLoc = m_shaderManager->getUniformLocation(orbitShader, "model");
-    GLint oViewLoc = m_shaderManager->getUniformLocation(orbitShader, "view");
-    GLint oProjLoc = m_shaderManager->getUniformLocation(orbitShader, "projection");
     GLint oColorLoc = m_shaderManager->getUniformLocation(orbitShader, "orbitColor");
     GLint oOpacityLoc = m_shaderManager->getUniformLocation(orbitShader, "opacity");
     
-    glUniformMatrix4fv(oViewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(oProjLoc, 1, GL_FALSE, glm::value_ptr(proj));
-    glUniformMatrix4fv(oModelLoc, 1, GL_FALSE, glm::value_ptr(parentTransform));
-    glUniform3fv(oColorLoc, 1, glm::value_ptr(color));
-    glUniform1f(oOpacityLoc, opacity);
+    glUniformMatrix4fv(oModelLoc, 1, GL_FALSE, glm::value_ptr(command.model));
+    glUniform3fv(oColorLoc, 1, glm::value_ptr(command.color));
+    glUniform1f(oOpacityLoc, command.opacity);
     
-    // Generate orbit points
-    std::vector<glm::vec3> points;
-    points.reserve(segments);
+    // Write orbit points straight into the streaming buffer
+    // (the distance scale is folded into the model matrix)
+    StreamingBuffer::Allocation alloc = m_streamingBuffer->allocate(
+        static_cast<GLsizeiptr>(command.segments * sizeof(glm::vec3)), sizeof(glm::vec3));
+    if (!alloc) {
+        return;  // Out of streaming space this frame; the ring grows next frame
+    }
     
-    Simulation::OrbitalParams params = body.getOrbitalParams();
-    for (int i = 0; i < segments; ++i) {
-        double meanAnomaly = (static_cast<double>(i) / segments) * 2.0 * glm::pi<double>();
-        Simulation::OrbitalParams p = params;
-        p.meanAnomaly0 = meanAnomaly;
-        points.push_back(Simulation::OrbitModel::calculatePosition(p, 0.0) * visualDistanceScale);
+    // Uniform steps in eccentric anomaly trace the ellipse without a Kepler solve per point.
+    // Cached paths are decimated to the requested segment count.
+    auto* points = static_cast<glm::vec3*>(alloc.data);
+    std::span<const glm::vec3> path = command.body->getOrbitPath();
+    size_t segments = static_cast<size_t>(command.segments);
+    if (!path.empty() && segments <= path.size()) {
+        for (size_t i = 0; i < segments; ++i) {
+            points[i] = path[i * path.size() / segments];
+        }
+    } else {
+        const Simulation::OrbitalParams& params = command.body->getOrbitalParams();
+        for (size_t i = 0; i < segments; ++i) {
+            double eccentricAnomaly = (static_cast<double>(i) / segments) * 2.0 * glm::pi<double>();
+            points[i] = Simulation::OrbitModel::positionAtEccentricAnomaly(params, eccentricAnomaly);
+        }
     }
+    m_streamingBuffer->commit(alloc);
     
-    // Use static VAO/VBO for efficiency
-    static GLuint vao = 0, vbo = 0;
-    if (vao == 0) {
-        glGenVertexArrays(1, &vao);
-        glGenBuffers(1, &vbo);
+    glBindVertexArray(m_orbitVao);
+    if (m_orbitVaoGeneration != m_streamingBuffer->getGeneration()) {
+        // Buffer is recreated when the ring grows, possibly under the same name
+        glBindBuffer(GL_ARRAY_BUFFER, alloc.buffer);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+        glEnableVertexAttribArray(0);
+        m_orbitVaoGeneration = m_streamingBuffer->getGeneration();
     }
     
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, points.size() * sizeof(glm::vec3), points.data(), GL_STREAM_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
-    glEnableVertexAttribArray(0);
-    glDrawArrays(GL_LINE_LOOP, 0, static_cast<GLsizei>(points.size()));
+    GLint first = static_cast<GLint>(alloc.offset / static_cast<GLintptr>(sizeof(glm::vec3)));
+    glDrawArrays(GL_LINE_LOOP, first, command.segments);
 }
 
-GLRenderer::GLRenderer(Platform::SDLWindow& window) 
+GLRenderer::GLRenderer(Platform::WindowInterface& window) 
     : m_window(window) {
     
     initGL();
@@ -66,6 +65,11 @@ GLRenderer::GLRenderer(Platform::SDLWindow& window)
     // Create managers
     m_shaderManager = std::make_unique<ShaderManager>();
     m_uiManager = std::make_unique<UIManager>(window, window.getGLContext());
+    m_profiler = std::make_unique<GPUProfiler>();
+    m_frameCapture = std::make_unique<FrameCapture>();
+    m_qualityGovernor = std::make_unique<QualityGovernor>();
+    m_sceneTarget = std::make_unique<RenderTarget>();
+    m_pickingPass = std::make_unique<PickingPass>();
     
     loadShaders();
     createMeshes();
@@ -74,8 +78,19 @@ GLRenderer::GLRenderer(Platform::SDLWindow& window)
 }
 
 GLRenderer::~GLRenderer() {
-    m_sphereMesh.reset();
-    m_orbitMesh.reset();
+    if (m_orbitVao) {
+        glDeleteVertexArrays(1, &m_orbitVao);
+        m_orbitVao = 0;
+    }
+    m_frameCapture.reset();
+    m_pickingPass.reset();
+    m_trailRenderer.reset();
+    m_particleRenderer.reset();
+    m_testParticles.reset();
+    m_streamingBuffer.reset();
+    m_sceneTarget.reset();
+    m_meshCache.reset();
+    m_profiler.reset();
     m_uiManager.reset();
     m_shaderManager.reset();
     LOG_INFO("GLRenderer", "OpenGL renderer destroyed");
@@ -96,15 +111,44 @@ void GLRenderer::loadShaders() {
         m_shaderManager->loadFromFiles(SHADER_ORBIT, 
                                         "assets/shaders/orbit.vert",
                                         "assets/shaders/orbit.frag");
+        m_shaderManager->loadFromFiles(SHADER_TRAIL, 
+                                        "assets/shaders/trail.vert",
+                                        "assets/shaders/trail.frag");
+        m_shaderManager->loadFromFiles(SHADER_PARTICLE, 
+                                        "assets/shaders/particle.vert",
+                                        "assets/shaders/particle.frag");
+        m_shaderManager->loadFromFiles(SHADER_SWARM, 
+                                        "assets/shaders/swarm.vert",
+                                        "assets/shaders/particle.frag");
+        m_shaderManager->loadTransformFeedback(SHADER_SWARM_UPDATE,
+                                                "assets/shaders/swarm_update.vert",
+                                                {"outPosition", "outVelocity"});
+        m_shaderManager->loadFromFiles(SHADER_PICK, 
+                                        "assets/shaders/planet.vert",
+                                        "assets/shaders/pick.frag");
+        m_shaderManager->loadFromFiles(SHADER_PICK_PARTICLE, 
+                                        "assets/shaders/particle.vert",
+                                        "assets/shaders/pick_particle.frag");
     } catch (const std::exception& e) {
         LOG_WARN("GLRenderer", "Failed to load some shader files, some features may be missing: ", e.what());
     }
 }
 
 void GLRenderer::createMeshes() {
-    m_sphereMesh = MeshFactory::createSphere(48, 48);
-    m_orbitMesh = MeshFactory::createCircle(256);
-    LOG_INFO("GLRenderer", "Meshes created");
+    m_meshCache = std::make_unique<MeshCache>();
+    for (int i = 0; i < SPHERE_LOD_COUNT; ++i) {
+        m_sphereLods[i] = m_meshCache->getSphere(SPHERE_LOD_SEGMENTS[i], SPHERE_LOD_SEGMENTS[i]);
+    }
+    
+    // Orbit paths are regenerated every frame into the streaming ring
+    m_streamingBuffer = std::make_unique<StreamingBuffer>();
+    glGenVertexArrays(1, &m_orbitVao);
+    
+    m_trailRenderer = std::make_unique<TrailRenderer>();
+    m_particleRenderer = std::make_unique<ParticleRenderer>();
+    m_testParticles = std::make_unique<TestParticleSystem>();
+    LOG_INFO("GLRenderer", "Meshes created (", m_meshCache->getMeshCount(), " meshes, ",
+             m_meshCache->getMemoryBytes() / 1024, " KB)");
 }
 
 void GLRenderer::render(const Simulation::SolarSystem& solarSystem, 
@@ -112,115 +156,422 @@ void GLRenderer::render(const Simulation::SolarSystem& solarSystem,
                         double simulationTime, 
                         const Simulation::CelestialBody* hoveredBody,
                         std::function<void()> uiCallback) {
+    updateQuality();
+    m_pickingPass->resolve();
+    
+    // The scene goes to a reduced-resolution target when the governor asks for it;
+    // the UI is always drawn at full resolution on top of the upscaled result
+    int width = 0, height = 0;
+    m_window.getSize(width, height);
+    GLint windowFramebuffer = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &windowFramebuffer);
+    
+    int sceneHeight = height;
+    bool scaled = false;
+    if (m_quality.renderScale < 1.0f) {
+        int sceneWidth = std::max(1, static_cast<int>(static_cast<float>(width) * m_quality.renderScale));
+        sceneHeight = std::max(1, static_cast<int>(static_cast<float>(height) * m_quality.renderScale));
+        scaled = m_sceneTarget->resize(sceneWidth, sceneHeight);
+        if (scaled) {
+            m_sceneTarget->bind();
+        } else {
+            sceneHeight = height;
+        }
+    }
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
+    m_streamingBuffer->beginFrame();
+    m_profiler->beginFrame();
+    
     // 1. Begin UI frame
     m_uiManager->beginFrame();
     if (uiCallback) uiCallback();
     
-    // 2. Render Solar System
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    GLuint planetShader = m_shaderManager->getShader(SHADER_PLANET);
-    
-    m_shaderManager->useShader(planetShader);
-    GLint modelLoc = m_shaderManager->getUniformLocation(planetShader, "model");
-    GLint viewLoc = m_shaderManager->getUniformLocation(planetShader, "view");
-    GLint projLoc = m_shaderManager->getUniformLocation(planetShader, "projection");
-    GLint colorLoc = m_shaderManager->getUniformLocation(planetShader, "objectColor");
-    GLint isSunLoc = m_shaderManager->getUniformLocation(planetShader, "isSun");
-    GLint timeLoc = m_shaderManager->getUniformLocation(planetShader, "time");
-    GLint viewPosLoc = m_shaderManager->getUniformLocation(planetShader, "viewPos");
-    GLint highlightLoc = m_shaderManager->getUniformLocation(planetShader, "highlight");
-    
-    glm::mat4 view = camera.getViewMatrix();
-    glm::mat4 proj = camera.getProjectionMatrix();
+    // 2. Collect draw submissions for the Solar System
+    const glm::mat4& view = camera.getViewMatrix();
+    const glm::mat4& proj = camera.getProjectionMatrix();
     glm::vec3 viewPos = camera.getPosition();
     
-    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(projLoc, 1, GL_FALSE, glm::value_ptr(proj));
-    glUniform3fv(viewPosLoc, 1, glm::value_ptr(viewPos));
-    glUniform1f(timeLoc, static_cast<float>(simulationTime));
-    
-    const auto& bodies = solarSystem.getBodies();
-    float visualDistanceScale = solarSystem.getSystemScale();
-    float visualPlanetScale = solarSystem.getPlanetScale();
-    
-    // Recursive body rendering function
-    std::function<void(const Simulation::CelestialBody&, glm::mat4)> drawBodyRecursive;
-    drawBodyRecursive = [&](const Simulation::CelestialBody& body, glm::mat4 parentTransform) {
-        glm::vec3 localPos;
-        if (solarSystem.isPhysicsEnabled()) {
-            localPos = body.getPhysicsPosition();
-            // In physics mode, position is already in world space, but we follow the hierarchy in the loop.
-            // Actually, my physics integrator updates world space positions.
-            // So I should pass identity as parent transform or just use the physics position directly.
-        } else {
-            localPos = body.getPosition(simulationTime);
+    FrameParams frame{
+        solarSystem,
+        simulationTime,
+        hoveredBody,
+        viewPos,
+        solarSystem.getSystemScale(),
+        solarSystem.getPlanetScale(),
+        solarSystem.isPhysicsEnabled(),
+        proj[1][1] * 0.5f * static_cast<float>(sceneHeight)
+    };
+    
+    m_renderQueue.clear();
+    m_renderQueue.setDepthRange(camera.getNearPlane(), camera.getFarPlane());
+    
+    for (const auto& body : solarSystem.getBodies()) {
+        // Planet orbits (not for the sun)
+        if (m_showOrbits && body.get() != solarSystem.getSun()) {
+            submitOrbit(*body, glm::mat4(1.0f), glm::vec3(0.3f, 0.3f, 0.4f), 0.3f,
+                        m_quality.planetOrbitSegments, frame);
         }
-        
-        float visualRadiusScale = visualPlanetScale;
-        bool isSun = false;
-        
-        if (body.isStar()) {
-            visualRadiusScale = 1.5f / static_cast<float>(body.getRadius());
-            isSun = true;
+        submitBody(*body, glm::mat4(1.0f), frame);
+    }
+    
+    // 3. Sort once and draw in state-minimizing order
+    m_renderQueue.sort();
+    executeQueue(view, proj, viewPos, simulationTime);
+    m_streamingBuffer->endFrame();
+    
+    renderParticles(frame, view, proj);
+    renderTrails(frame, view, proj);
+    
+    if (scaled) {
+        m_sceneTarget->blitTo(static_cast<GLuint>(windowFramebuffer), width, height);
+    }
+    
+    if (m_pickingPass->hasRequest()) {
+        renderPickPass(frame, view, proj, width, height);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(windowFramebuffer));
+        glViewport(0, 0, width, height);
+    }
+    
+    // 4. Capture (before or after the UI) and present
+    bool captureUI = m_frameCapture->getSettings().includeUI;
+    if (m_frameCapture->isActive() && !captureUI) {
+        m_profiler->beginPass(ProfilePass::Capture);
+        m_frameCapture->captureFrame();
+    }
+    
+    m_profiler->beginPass(ProfilePass::UI);
+    m_uiManager->endFrame();
+    
+    if (m_frameCapture->isActive() && captureUI) {
+        m_profiler->beginPass(ProfilePass::Capture);
+        m_frameCapture->captureFrame();
+    }
+    m_profiler->endPass();
+    
+    // Vsync waits aren't load; keep them out of the governor's CPU time
+    if (m_hasFrameStart) {
+        m_cpuFrameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_frameStart).count();
+        m_hasFrameStart = false;
+        m_hasCpuTime = true;
+    }
+    m_window.swapBuffers();
+}
+
+void GLRenderer::beginFrame() {
+    m_frameStart = std::chrono::steady_clock::now();
+    m_hasFrameStart = true;
+}
+
+void GLRenderer::updateQuality() {
+    if (m_hasCpuTime) {
+        // Latest resolved timings rather than the rolling average, so the governor reacts promptly
+        float gpuMs = 0.0f;
+        for (int pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass) {
+            gpuMs += static_cast<float>(m_profiler->getTiming(static_cast<ProfilePass>(pass)).lastMs);
         }
-        
-        glm::mat4 posMatrix;
-        if (solarSystem.isPhysicsEnabled()) {
-             posMatrix = glm::translate(glm::mat4(1.0f), body.getPhysicsPosition() * visualDistanceScale);
-        } else {
-             posMatrix = glm::translate(parentTransform, localPos * visualDistanceScale);
+        m_qualityGovernor->update(m_cpuFrameMs, gpuMs);
+        m_hasCpuTime = false;
+    }
+    
+    m_quality = m_qualityGovernor->getSettings();
+    int trailLength = static_cast<int>(static_cast<float>(m_trailLength) * m_quality.trailScale);
+    m_trailRenderer->setTrailLength(trailLength);
+    m_particleRenderer->setDensity(m_particleDensity * m_quality.particleDensity);
+}
+
+const GLMesh* GLRenderer::selectSphereLod(float pixelRadius) const {
+    int lod = 0;
+    while (lod < SPHERE_LOD_COUNT - 1 && pixelRadius < SPHERE_LOD_PIXELS[lod]) {
+        ++lod;
+    }
+    lod = std::min(lod + m_quality.sphereLodBias, SPHERE_LOD_COUNT - 1);
+    return m_sphereLods[lod];
+}
+
+void GLRenderer::submitBody(const Simulation::CelestialBody& body,
+                            const glm::mat4& parentTransform,
+                            const FrameParams& frame) {
+    glm::mat4 posMatrix;
+    if (frame.physicsEnabled) {
+        // Physics positions are already in world space
+        posMatrix = glm::translate(glm::mat4(1.0f), body.getPhysicsPosition() * frame.visualDistanceScale);
+    } else {
+        posMatrix = glm::translate(parentTransform, body.getPosition(frame.simulationTime) * frame.visualDistanceScale);
+    }
+    
+    // Orbits for children (moons)
+    if (m_showOrbits && !frame.physicsEnabled) {
+        for (const auto& child : body.getChildren()) {
+            submitOrbit(*child, posMatrix, glm::vec3(0.4f, 0.4f, 0.5f), 0.2f,
+                        m_quality.moonOrbitSegments, frame);
         }
+    }
+    
+    float visualRadiusScale = frame.visualPlanetScale;
+    if (body.isStar()) {
+        visualRadiusScale = 1.5f / static_cast<float>(body.getRadius());
+    }
+    float scale = static_cast<float>(body.getRadius()) * visualRadiusScale;
+    
+    glm::vec3 worldPos(posMatrix[3]);
+    float distance = glm::length(worldPos - frame.viewPos);
+    float pixelRadius = distance > 0.0f ? scale * frame.pixelScale / distance : frame.pixelScale;
+    
+    DrawCommand command;
+    command.pass = RenderPass::Opaque;
+    command.shader = m_shaderManager->getShader(SHADER_PLANET);
+    command.mesh = selectSphereLod(pixelRadius);
+    command.body = &body;
+    command.model = glm::scale(posMatrix, glm::vec3(scale));
+    command.color = body.getColor();
+    command.highlight = (frame.hoveredBody == &body) ? 1.0f : 0.0f;
+    command.isSun = body.isStar();
+    
+    m_renderQueue.submit(command, distance);
+    
+    for (const auto& child : body.getChildren()) {
+        submitBody(*child, posMatrix, frame);
+    }
+}
+
+void GLRenderer::submitOrbit(const Simulation::CelestialBody& body,
+                             const glm::mat4& parentTransform,
+                             const glm::vec3& color,
+                             float opacity,
+                             int segments,
+                             const FrameParams& frame) {
+    DrawCommand command;
+    command.pass = RenderPass::Transparent;
+    command.shader = m_shaderManager->getShader(SHADER_ORBIT);
+    command.body = &body;
+    command.model = glm::scale(parentTransform, glm::vec3(frame.visualDistanceScale));
+    command.color = color;
+    command.opacity = opacity;
+    command.segments = segments;
+    
+    // Orbits are sorted by the distance to the body they circle
+    glm::vec3 center(parentTransform[3]);
+    m_renderQueue.submit(command, glm::length(center - frame.viewPos));
+}
+
+void GLRenderer::bindFrameUniforms(GLuint shader, const glm::mat4& view, const glm::mat4& proj,
+                                   const glm::vec3& viewPos, double simulationTime) {
+    // Unused uniforms resolve to -1 and are ignored by GL
+    glUniformMatrix4fv(m_shaderManager->getUniformLocation(shader, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(m_shaderManager->getUniformLocation(shader, "projection"), 1, GL_FALSE, glm::value_ptr(proj));
+    glUniform3fv(m_shaderManager->getUniformLocation(shader, "viewPos"), 1, glm::value_ptr(viewPos));
+    glUniform1f(m_shaderManager->getUniformLocation(shader, "time"), static_cast<float>(simulationTime));
+}
+
+void GLRenderer::executeQueue(const glm::mat4& view, const glm::mat4& proj,
+                              const glm::vec3& viewPos, double simulationTime) {
+    GLuint boundShader = 0;
+    GLuint boundVao = 0;
+    RenderPass currentPass = RenderPass::Opaque;
+    
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+    m_profiler->beginPass(ProfilePass::Bodies);
+    
+    for (size_t i = 0; i < m_renderQueue.size(); ++i) {
+        const DrawCommand& command = m_renderQueue[i];
         
-        // Draw Orbits for children (moons)
-        if (m_showOrbits && !solarSystem.isPhysicsEnabled()) {
-            for (const auto& child : body.getChildren()) {
-                drawOrbit(*child, posMatrix, view, proj, visualDistanceScale,
-                          glm::vec3(0.4f, 0.4f, 0.5f), 0.2f, 128);
+        if (command.pass != currentPass) {
+            currentPass = command.pass;
+            if (currentPass == RenderPass::Transparent) {
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                glDepthMask(GL_FALSE);
+                m_profiler->beginPass(ProfilePass::Orbits);
             }
-            glUseProgram(planetShader);
         }
-
-        // Draw Body
-        {
-            float scale = static_cast<float>(body.getRadius()) * visualRadiusScale;
-            glm::mat4 model = glm::scale(posMatrix, glm::vec3(scale));
-            
-            float highlight = (hoveredBody == &body) ? 1.0f : 0.0f;
-            glUniform1f(highlightLoc, highlight);
-            
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-            glUniform1i(isSunLoc, isSun ? 1 : 0);
-            glUniform3fv(colorLoc, 1, glm::value_ptr(body.getColor()));
-            m_sphereMesh->draw();
+        
+        if (command.shader != boundShader) {
+            m_shaderManager->useShader(command.shader);
+            bindFrameUniforms(command.shader, view, proj, viewPos, simulationTime);
+            boundShader = command.shader;
         }
         
-        for (const auto& child : body.getChildren()) {
-            drawBodyRecursive(*child, posMatrix);
+        if (!command.mesh) {
+            drawOrbit(command);
+            boundVao = 0;  // drawOrbit binds its own VAO
+            continue;
         }
-    };
-    
-    for (const auto& body : bodies) {
-        // Draw planet orbits (not for the sun)
-        if (m_showOrbits && body.get() != solarSystem.getSun()) {
-            drawOrbit(*body, glm::mat4(1.0f), view, proj, visualDistanceScale,
-                      glm::vec3(0.3f, 0.3f, 0.4f), 0.3f, 256);
-            glUseProgram(planetShader);
+        
+        if (command.mesh->getVertexArray() != boundVao) {
+            command.mesh->bind();
+            boundVao = command.mesh->getVertexArray();
         }
         
-        drawBodyRecursive(*body, glm::mat4(1.0f));
+        glUniformMatrix4fv(m_shaderManager->getUniformLocation(command.shader, "model"), 1, GL_FALSE, glm::value_ptr(command.model));
+        glUniform3fv(m_shaderManager->getUniformLocation(command.shader, "objectColor"), 1, glm::value_ptr(command.color));
+        glUniform1f(m_shaderManager->getUniformLocation(command.shader, "highlight"), command.highlight);
+        glUniform1i(m_shaderManager->getUniformLocation(command.shader, "isSun"), command.isSun ? 1 : 0);
+        glUniform1i(m_shaderManager->getUniformLocation(command.shader, "octNormals"), command.mesh->hasNormals() ? 1 : 0);
+        command.mesh->drawBound();
     }
     
+    m_profiler->endPass();
+    
     glDisable(GL_BLEND);
-    m_uiManager->endFrame();
-    m_window.swapBuffers();
+    glDepthMask(GL_TRUE);
+}
+
+void GLRenderer::renderTrails(const FrameParams& frame, const glm::mat4& view, const glm::mat4& proj) {
+    // Keeps sampling while hidden so toggling trails on shows the history
+    m_trailRenderer->update(frame.solarSystem, m_showTrails);
+    
+    m_profiler->beginPass(ProfilePass::Trails);
+    GLuint shader = m_shaderManager->getShader(SHADER_TRAIL);
+    if (m_showTrails && frame.physicsEnabled && shader) {
+        m_shaderManager->useShader(shader);
+        bindFrameUniforms(shader, view, proj, frame.viewPos, frame.simulationTime);
+        
+        // Physics positions are unscaled world space
+        glm::mat4 model = glm::scale(glm::mat4(1.0f), glm::vec3(frame.visualDistanceScale));
+        glUniformMatrix4fv(m_shaderManager->getUniformLocation(shader, "model"), 1, GL_FALSE, glm::value_ptr(model));
+        glUniform1f(m_shaderManager->getUniformLocation(shader, "opacity"), 0.6f);
+        
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDepthMask(GL_FALSE);
+        m_trailRenderer->draw(*m_shaderManager, shader);
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+    }
+    m_profiler->endPass();
+}
+
+void GLRenderer::renderParticles(const FrameParams& frame, const glm::mat4& view, const glm::mat4& proj) {
+    m_particleRenderer->update(frame.solarSystem);
+    
+    m_profiler->beginPass(ProfilePass::Particles);
+    m_testParticles->flush(frame.solarSystem, *m_shaderManager, m_shaderManager->getShader(SHADER_SWARM_UPDATE));
+    bool drawSwarms = frame.physicsEnabled && m_testParticles->getParticleCount() > 0;
+    if (m_particleRenderer->getTotalCount() == 0 && !drawSwarms) {
+        m_profiler->endPass();
+        return;
+    }
+    
+    // Positions are unscaled world space in both point passes
+    glm::mat4 model = glm::scale(glm::mat4(1.0f), glm::vec3(frame.visualDistanceScale));
+    
+    // Additive points: dense regions brighten instead of saturating to one color
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+    
+    GLuint shader = m_shaderManager->getShader(SHADER_PARTICLE);
+    if (shader && m_particleRenderer->getTotalCount() > 0) {
+        m_shaderManager->useShader(shader);
+        bindFrameUniforms(shader, view, proj, frame.viewPos, frame.simulationTime);
+        glUniformMatrix4fv(m_shaderManager->getUniformLocation(shader, "model"), 1, GL_FALSE, glm::value_ptr(model));
+        m_particleRenderer->draw(*m_shaderManager, shader, frame.simulationTime, frame.physicsEnabled);
+    }
+    
+    GLuint swarmShader = m_shaderManager->getShader(SHADER_SWARM);
+    if (swarmShader && drawSwarms) {
+        m_shaderManager->useShader(swarmShader);
+        bindFrameUniforms(swarmShader, view, proj, frame.viewPos, frame.simulationTime);
+        glUniformMatrix4fv(m_shaderManager->getUniformLocation(swarmShader, "model"), 1, GL_FALSE, glm::value_ptr(model));
+        m_testParticles->draw(*m_shaderManager, swarmShader);
+    }
+    
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+    m_profiler->endPass();
+}
+
+void GLRenderer::renderPickPass(const FrameParams& frame, const glm::mat4& view, const glm::mat4& proj,
+                                int width, int height) {
+    m_profiler->beginPass(ProfilePass::Picking);
+    glm::mat4 pickProj = m_pickingPass->getPickMatrix(width, height) * proj;
+    m_pickingPass->begin();
+    glDisable(GL_BLEND);
+    glDepthMask(GL_TRUE);
+    
+    GLuint shader = m_shaderManager->getShader(SHADER_PICK);
+    if (shader) {
+        m_shaderManager->useShader(shader);
+        bindFrameUniforms(shader, view, pickProj, frame.viewPos, frame.simulationTime);
+        GLint modelLoc = m_shaderManager->getUniformLocation(shader, "model");
+        GLint idLoc = m_shaderManager->getUniformLocation(shader, "objectId");
+        GLint octLoc = m_shaderManager->getUniformLocation(shader, "octNormals");
+        
+        // This frame's body submissions, already LOD-selected
+        for (size_t i = 0; i < m_renderQueue.size(); ++i) {
+            const DrawCommand& command = m_renderQueue[i];
+            if (command.pass != RenderPass::Opaque || !command.mesh) continue;
+            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(command.model));
+            glUniform1ui(idLoc, m_pickingPass->registerBody(command.body));
+            glUniform1i(octLoc, command.mesh->hasNormals() ? 1 : 0);
+            command.mesh->draw();
+        }
+    }
+    
+    GLuint particleShader = m_shaderManager->getShader(SHADER_PICK_PARTICLE);
+    if (particleShader && m_particleRenderer->getTotalCount() > 0) {
+        glEnable(GL_PROGRAM_POINT_SIZE);
+        m_shaderManager->useShader(particleShader);
+        bindFrameUniforms(particleShader, view, pickProj, frame.viewPos, frame.simulationTime);
+        glm::mat4 model = glm::scale(glm::mat4(1.0f), glm::vec3(frame.visualDistanceScale));
+        glUniformMatrix4fv(m_shaderManager->getUniformLocation(particleShader, "model"), 1, GL_FALSE, glm::value_ptr(model));
+        m_particleRenderer->draw(*m_shaderManager, particleShader, frame.simulationTime, frame.physicsEnabled);
+        glDisable(GL_PROGRAM_POINT_SIZE);
+    }
+    glBindVertexArray(0);
+    
+    m_pickingPass->end(frame.solarSystem.getSystemGeneration());
+    m_profiler->endPass();
+}
+
+void GLRenderer::queueTestParticleStep(const Simulation::SolarSystem& solarSystem, float dt) {
+    m_testParticles->queueStep(solarSystem, dt);
+}
+
+FrameStats GLRenderer::getFrameStats() const {
+    FrameStats stats;
+    stats.gpuTimingSupported = m_profiler->isSupported();
+    for (int pass = 0; pass < GPUProfiler::PASS_COUNT; ++pass) {
+        stats.gpuPasses[pass] = m_profiler->getTiming(static_cast<ProfilePass>(pass));
+    }
+    stats.gpuTotalMs = m_profiler->getTotalMs();
+    stats.particlesDrawn = m_particleRenderer->getDrawnCount() + m_testParticles->getParticleCount();
+    stats.particlesTotal = m_particleRenderer->getTotalCount() + m_testParticles->getParticleCount();
+    stats.capturing = m_frameCapture->isActive();
+    stats.capturedFrames = m_frameCapture->getFramesCaptured();
+    stats.droppedFrames = m_frameCapture->getFramesDropped();
+    stats.qualityLevel = m_qualityGovernor->isEnabled() ? m_qualityGovernor->getLevel() : -1;
+    stats.renderScale = m_quality.renderScale;
+    stats.cpuFrameMs = m_qualityGovernor->getCpuMs();
+    stats.gpuBufferBytes = m_meshCache->getMemoryBytes() + m_streamingBuffer->getMemoryBytes()
+        + m_trailRenderer->getMemoryBytes() + m_particleRenderer->getMemoryBytes()
+        + m_testParticles->getMemoryBytes();
+    return stats;
+}
+
+bool GLRenderer::startCapture(const CaptureSettings& settings) {
+    int width = 0, height = 0;
+    m_window.getSize(width, height);
+    return m_frameCapture->start(settings, width, height);
+}
+
+void GLRenderer::stopCapture() {
+    m_frameCapture->stop();
 }
 
 void GLRenderer::resize(int width, int height) {
     glViewport(0, 0, width, height);
+    
+    // Readback buffers are sized for the frame at capture start
+    if (m_frameCapture->isActive() &&
+        (width != m_frameCapture->getWidth() || height != m_frameCapture->getHeight())) {
+        LOG_WARN("GLRenderer", "Window resized during capture, stopping capture");
+        m_frameCapture->stop();
+    }
     LOG_DEBUG("GLRenderer", "Viewport resized to ", width, "x", height);
 }
 
@@ -4,7 +4,21 @@
 #include "ShaderManager.hpp"
 #include "MeshFactory.hpp"
 #include "UIManager.hpp"
-#include "platform/SDLWindow.hpp"
+#include "RenderQueue.hpp"
+#include "StreamingBuffer.hpp"
+#include "GPUProfiler.hpp"
+#include "FrameStats.hpp"
+#include "FrameCapture.hpp"
+#include "TrailRenderer.hpp"
+#include "ParticleRenderer.hpp"
+#include "TestParticleSystem.hpp"
+#include "QualityGovernor.hpp"
+#include "RenderTarget.hpp"
+#include "PickingPass.hpp"
+#include "platform/WindowInterface.hpp"
+#include <SDL3/SDL.h>
+#include <array>
+#include <chrono>
 #include <memory>
 #include <glm/glm.hpp>
 
@@ -13,7 +27,7 @@ namespace Render {
 /// OpenGL-based renderer implementation
 class GLRenderer : public RenderInterface {
 public:
-    explicit GLRenderer(Platform::SDLWindow& window);
+    explicit GLRenderer(Platform::WindowInterface& window);
     ~GLRenderer() override;
 
     void render(const Simulation::SolarSystem& solarSystem, 
@@ -23,6 +37,10 @@ public:
                 std::function<void()> uiCallback = nullptr);
     void resize(int width, int height) override;
     
+    /// Mark the start of a main-loop iteration. CPU frame time runs from here to
+    /// the buffer swap, so idle waits and frame pacing don't count as load.
+    void beginFrame();
+    
     /// Forward SDL event to ImGui
     void processEvent(const SDL_Event& event);
 
@@ -31,38 +49,149 @@ public:
     
     void setShowLabels(bool show) { m_showLabels = show; }
     bool isShowLabels() const { return m_showLabels; }
+    
+    /// Fading N-body position trails (physics mode only)
+    void setShowTrails(bool show) { m_showTrails = show; }
+    bool isShowTrails() const { return m_showTrails; }
+    /// User trail length; the quality governor may draw a shorter one
+    void setTrailLength(int samples) { m_trailLength = samples; }
+    
+    /// Fraction of particle-population points drawn (0..1), before quality scaling
+    void setParticleDensity(float density) { m_particleDensity = density; }
+    
+    /// Adaptive quality controller (frame-time target, resolution scaling)
+    QualityGovernor& getQualityGovernor() { return *m_qualityGovernor; }
+    const QualitySettings& getQualitySettings() const { return m_quality; }
+    
+    /// Queue one physics step for the GPU test-particle swarms (call after each
+    /// physics step); the next rendered frame dispatches the queued steps
+    void queueTestParticleStep(const Simulation::SolarSystem& solarSystem, float dt);
+    
+    /// GPU picking: render an ID buffer around (x, y) this frame; the result
+    /// arrives asynchronously in getPickResult() a frame or two later
+    void requestPick(float x, float y) { m_pickingPass->request(x, y); }
+    const PickResult& getPickResult() const { return m_pickingPass->getResult(); }
+    
+    /// Per-frame ring buffer for dynamic vertex data
+    StreamingBuffer& getStreamingBuffer() { return *m_streamingBuffer; }
+    
+    /// GPU pass timings
+    const GPUProfiler& getProfiler() const { return *m_profiler; }
+    FrameStats getFrameStats() const;
+    
+    /// Write rendered frames to an image sequence (asynchronous PBO readback)
+    bool startCapture(const CaptureSettings& settings);
+    void stopCapture();
+    bool isCapturing() const { return m_frameCapture->isActive(); }
 
 private:
     void initGL();
     void loadShaders();
     void createMeshes();
     
-    /// Draw an orbit path for a body
-    void drawOrbit(const Simulation::CelestialBody& body, 
-                   const glm::mat4& parentTransform,
-                   const glm::mat4& view, 
-                   const glm::mat4& proj,
-                   float visualDistanceScale,
-                   const glm::vec3& color,
-                   float opacity,
-                   int segments);
+    /// Per-frame values shared by all submissions
+    struct FrameParams {
+        const Simulation::SolarSystem& solarSystem;
+        double simulationTime;
+        const Simulation::CelestialBody* hoveredBody;
+        glm::vec3 viewPos;
+        float visualDistanceScale;
+        float visualPlanetScale;
+        bool physicsEnabled;
+        float pixelScale;        // Projected pixels per world unit at distance 1
+    };
+    
+    /// Sphere mesh for a body covering `pixelRadius` pixels on screen
+    const GLMesh* selectSphereLod(float pixelRadius) const;
+    
+    /// Feed last frame's CPU/GPU times to the governor and apply its settings
+    void updateQuality();
+    
+    /// Walk the body hierarchy and submit body and moon-orbit draws
+    void submitBody(const Simulation::CelestialBody& body,
+                    const glm::mat4& parentTransform,
+                    const FrameParams& frame);
+    
+    /// Submit an orbit path for a body
+    void submitOrbit(const Simulation::CelestialBody& body,
+                     const glm::mat4& parentTransform,
+                     const glm::vec3& color,
+                     float opacity,
+                     int segments,
+                     const FrameParams& frame);
+    
+    /// Execute the sorted render queue with minimal state changes
+    void executeQueue(const glm::mat4& view, const glm::mat4& proj,
+                      const glm::vec3& viewPos, double simulationTime);
+    
+    /// Set per-frame uniforms after a shader switch
+    void bindFrameUniforms(GLuint shader, const glm::mat4& view, const glm::mat4& proj,
+                           const glm::vec3& viewPos, double simulationTime);
+    
+    /// Draw an orbit path for a body (shader must be bound)
+    void drawOrbit(const DrawCommand& command);
+    
+    /// Sample physics positions into the trail ring and draw the trails
+    void renderTrails(const FrameParams& frame, const glm::mat4& view, const glm::mat4& proj);
+    
+    /// Draw asteroid belts and rings as GPU-propagated point clouds
+    void renderParticles(const FrameParams& frame, const glm::mat4& view, const glm::mat4& proj);
+    
+    /// Redraw bodies and particles as IDs into the picking target around the cursor
+    void renderPickPass(const FrameParams& frame, const glm::mat4& view, const glm::mat4& proj,
+                        int width, int height);
 
-    Platform::SDLWindow& m_window;
+    Platform::WindowInterface& m_window;
     
     // Managers
     std::unique_ptr<ShaderManager> m_shaderManager;
     std::unique_ptr<UIManager> m_uiManager;
+    std::unique_ptr<GPUProfiler> m_profiler;
+    std::unique_ptr<FrameCapture> m_frameCapture;
+    std::unique_ptr<QualityGovernor> m_qualityGovernor;
+    std::unique_ptr<PickingPass> m_pickingPass;
+    
+    // Meshes (sphere LODs from finest to coarsest)
+    static constexpr int SPHERE_LOD_COUNT = 4;
+    static constexpr std::array<int, SPHERE_LOD_COUNT> SPHERE_LOD_SEGMENTS = {48, 32, 20, 12};
+    static constexpr std::array<float, SPHERE_LOD_COUNT - 1> SPHERE_LOD_PIXELS = {48.0f, 16.0f, 5.0f};
+    std::unique_ptr<MeshCache> m_meshCache;
+    std::array<const GLMesh*, SPHERE_LOD_COUNT> m_sphereLods{};
     
-    // Meshes
-    std::unique_ptr<GLMesh> m_sphereMesh;
-    std::unique_ptr<GLMesh> m_orbitMesh;
+    // Per-frame draw submissions
+    RenderQueue m_renderQueue;
+    
+    // Dynamic geometry
+    std::unique_ptr<StreamingBuffer> m_streamingBuffer;
+    GLuint m_orbitVao = 0;
+    uint64_t m_orbitVaoGeneration = 0;  // Streaming buffer generation the orbit VAO's attribute sources (0 = none)
+    std::unique_ptr<TrailRenderer> m_trailRenderer;
+    std::unique_ptr<ParticleRenderer> m_particleRenderer;
+    std::unique_ptr<TestParticleSystem> m_testParticles;
     
     bool m_showOrbits = true;
     bool m_showLabels = true;
+    bool m_showTrails = true;
+    int m_trailLength = TrailRenderer::DEFAULT_TRAIL_LENGTH;
+    float m_particleDensity = 1.0f;
+    
+    // Adaptive quality
+    QualitySettings m_quality;
+    std::unique_ptr<RenderTarget> m_sceneTarget;  // Reduced-resolution scene when renderScale < 1
+    std::chrono::steady_clock::time_point m_frameStart;
+    bool m_hasFrameStart = false;
+    bool m_hasCpuTime = false;
+    float m_cpuFrameMs = 0.0f;
     
     // Shader names
     static constexpr const char* SHADER_PLANET = "planet";
     static constexpr const char* SHADER_ORBIT = "orbit";
+    static constexpr const char* SHADER_TRAIL = "trail";
+    static constexpr const char* SHADER_PARTICLE = "particle";
+    static constexpr const char* SHADER_SWARM = "swarm";
+    static constexpr const char* SHADER_SWARM_UPDATE = "swarm_update";
+    static constexpr const char* SHADER_PICK = "pick";
+    static constexpr const char* SHADER_PICK_PARTICLE = "pick_particle";
 };
 
 } // namespace Render
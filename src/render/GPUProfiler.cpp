@@ -0,0 +1,151 @@
+#include "GPUProfiler.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+
+namespace Render {
+
+GPUProfiler::GPUProfiler() {
+    m_supported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    if (!m_supported) {
+        LOG_WARN("GPUProfiler", "Timer queries not supported, GPU pass timings disabled");
+        return;
+    }
+
+    for (auto& set : m_queries) {
+        glGenQueries(PASS_COUNT, set.data());
+    }
+    LOG_INFO("GPUProfiler", "GPU timer queries enabled for ", PASS_COUNT, " passes");
+}
+
+GPUProfiler::~GPUProfiler() {
+    if (!m_supported) return;
+    for (auto& set : m_queries) {
+        glDeleteQueries(PASS_COUNT, set.data());
+    }
+}
+
+const char* GPUProfiler::getPassName(ProfilePass pass) {
+    switch (pass) {
+        case ProfilePass::Bodies: return "bodies";
+        case ProfilePass::Orbits: return "orbits";
+        case ProfilePass::Trails: return "trails";
+        case ProfilePass::Particles: return "particles";
+        case ProfilePass::UI:     return "ui";
+        case ProfilePass::Capture: return "capture";
+        case ProfilePass::Picking: return "picking";
+        case ProfilePass::Count:  break;
+    }
+    return "unknown";
+}
+
+void GPUProfiler::beginFrame() {
+    if (!m_supported) return;
+
+    m_querySet = (m_querySet + 1) % QUERY_FRAMES;
+    ++m_frameCount;
+
+    // Harvest the results of the frame that last used this set
+    auto& queries = m_queries[m_querySet];
+    auto& issued = m_issued[m_querySet];
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        if (!issued[pass]) {
+            // A pass skipped that frame (hidden orbits, idle picking, no capture) cost nothing
+            recordSample(pass, 0.0f);
+            continue;
+        }
+        issued[pass] = false;
+
+        GLint available = 0;
+        glGetQueryObjectiv(queries[pass], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            // Never wait: drop the sample and reuse the query
+            ++m_droppedSamples;
+            continue;
+        }
+
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(queries[pass], GL_QUERY_RESULT, &elapsedNs);
+        recordSample(pass, static_cast<float>(elapsedNs / 1.0e6));
+    }
+}
+
+void GPUProfiler::beginPass(ProfilePass pass) {
+    if (!m_supported) return;
+    if (m_activePass >= 0) {
+        endPass();
+    }
+
+    int index = static_cast<int>(pass);
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[m_querySet][index]);
+    m_issued[m_querySet][index] = true;
+    m_activePass = index;
+}
+
+void GPUProfiler::endPass() {
+    if (!m_supported || m_activePass < 0) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_activePass = -1;
+}
+
+void GPUProfiler::recordSample(int pass, float ms) {
+    History& history = m_history[pass];
+    history.samples[history.head] = ms;
+    history.head = (history.head + 1) % HISTORY_SIZE;
+    history.count = std::min(history.count + 1, HISTORY_SIZE);
+    history.last = ms;
+}
+
+PassTiming GPUProfiler::getTiming(ProfilePass pass) const {
+    PassTiming timing;
+    timing.name = getPassName(pass);
+
+    const History& history = m_history[static_cast<int>(pass)];
+    if (history.count == 0) return timing;
+
+    double sum = 0.0;
+    float minMs = history.samples[0];
+    float maxMs = history.samples[0];
+    for (int i = 0; i < history.count; ++i) {
+        float s = history.samples[i];
+        sum += s;
+        minMs = std::min(minMs, s);
+        maxMs = std::max(maxMs, s);
+    }
+
+    timing.lastMs = history.last;
+    timing.avgMs = sum / history.count;
+    timing.minMs = minMs;
+    timing.maxMs = maxMs;
+    return timing;
+}
+
+double GPUProfiler::getTotalMs() const {
+    double total = 0.0;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        total += getTiming(static_cast<ProfilePass>(pass)).avgMs;
+    }
+    return total;
+}
+
+void GPUProfiler::writeJson(std::ostream& out) const {
+    out << "{\n";
+    out << "  \"supported\": " << (m_supported ? "true" : "false") << ",\n";
+    out << "  \"frames\": " << m_frameCount << ",\n";
+    out << "  \"dropped_samples\": " << m_droppedSamples << ",\n";
+    out << "  \"window\": " << HISTORY_SIZE << ",\n";
+    out << "  \"total_avg_ms\": " << getTotalMs() << ",\n";
+    out << "  \"passes\": {\n";
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        PassTiming t = getTiming(static_cast<ProfilePass>(pass));
+        out << "    \"" << t.name << "\": {"
+            << "\"last_ms\": " << t.lastMs
+            << ", \"avg_ms\": " << t.avgMs
+            << ", \"min_ms\": " << t.minMs
+            << ", \"max_ms\": " << t.maxMs << "}"
+            << (pass + 1 < PASS_COUNT ? ",\n" : "\n");
+    }
+    out << "  }\n";
+    out << "}\n";
+}
+
+} // namespace Render
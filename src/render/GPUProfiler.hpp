@@ -0,0 +1,72 @@
+#pragma once
+
+#include "FrameStats.hpp"
+#include <GL/glew.h>
+#include <array>
+#include <ostream>
+
+namespace Render {
+
+/// Measures GPU time per render pass with GL_TIME_ELAPSED queries.
+///
+/// Query sets are double-buffered: results for a frame are collected when its
+/// set comes around again, and only if GL reports them available, so reading
+/// back never stalls the pipeline. Timer queries are core in GL 3.3 and
+/// supported by Mesa llvmpipe.
+class GPUProfiler {
+public:
+    static constexpr int QUERY_FRAMES = 2;
+    static constexpr int HISTORY_SIZE = 120;
+    static constexpr int PASS_COUNT = static_cast<int>(ProfilePass::Count);
+
+    GPUProfiler();
+    ~GPUProfiler();
+
+    // Non-copyable
+    GPUProfiler(const GPUProfiler&) = delete;
+    GPUProfiler& operator=(const GPUProfiler&) = delete;
+
+    /// Collect finished results from the query set this frame will reuse.
+    /// Passes that frame did not issue record 0 ms, so idle passes drop out of the totals.
+    void beginFrame();
+
+    /// Start timing a pass. Passes must not overlap; beginning a new pass ends the current one.
+    void beginPass(ProfilePass pass);
+    void endPass();
+
+    /// Get rolling statistics for a pass
+    PassTiming getTiming(ProfilePass pass) const;
+
+    /// Sum of the rolling averages of all passes
+    double getTotalMs() const;
+
+    bool isSupported() const { return m_supported; }
+    uint64_t getFrameCount() const { return m_frameCount; }
+    uint64_t getDroppedSamples() const { return m_droppedSamples; }
+
+    /// Write the current statistics as a JSON object
+    void writeJson(std::ostream& out) const;
+
+    static const char* getPassName(ProfilePass pass);
+
+private:
+    struct History {
+        std::array<float, HISTORY_SIZE> samples{};
+        int head = 0;
+        int count = 0;
+        float last = 0.0f;
+    };
+
+    void recordSample(int pass, float ms);
+
+    bool m_supported = false;
+    std::array<std::array<GLuint, PASS_COUNT>, QUERY_FRAMES> m_queries{};
+    std::array<std::array<bool, PASS_COUNT>, QUERY_FRAMES> m_issued{};
+    std::array<History, PASS_COUNT> m_history{};
+    int m_querySet = 0;
+    int m_activePass = -1;
+    uint64_t m_frameCount = 0;
+    uint64_t m_droppedSamples = 0;
+};
+
+} // namespace Render
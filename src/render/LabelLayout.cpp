@@ -0,0 +1,145 @@
+#include "LabelLayout.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Render {
+
+void LabelLayout::clear() {
+    ++m_generation;
+    m_candidates.clear();
+    m_candidateNext.clear();
+    m_placed.clear();
+    m_cellEntries.clear();
+    std::fill(m_cellHeads.begin(), m_cellHeads.end(), -1);
+}
+
+void LabelLayout::begin(float screenWidth, float screenHeight, int budget) {
+    m_columns = std::max(1, static_cast<int>(std::ceil(screenWidth / CELL_WIDTH)));
+    m_rows = std::max(1, static_cast<int>(std::ceil(screenHeight / CELL_HEIGHT)));
+    m_budget = std::max(0, budget);
+    ++m_generation;
+    
+    // Buffers keep their capacity between frames
+    m_cellHeads.assign(static_cast<size_t>(m_columns) * m_rows, -1);
+    m_bucketHeads.assign(PRIORITY_BUCKETS, -1);
+    m_candidates.clear();
+    m_candidateNext.clear();
+    m_placed.clear();
+    m_cellEntries.clear();
+}
+
+float LabelLayout::bodyPriority(const Simulation::CelestialBody& body) {
+    float base = 0.0f;
+    switch (body.getType()) {
+        case Simulation::BodyType::Star:
+        case Simulation::BodyType::BlackHole:   base = 0.75f; break;
+        case Simulation::BodyType::Planet:      base = 0.5f; break;
+        case Simulation::BodyType::DwarfPlanet: base = 0.375f; break;
+        case Simulation::BodyType::Moon:        base = 0.25f; break;
+        default:                                base = 0.0f; break;
+    }
+    
+    // Larger bodies first within a type: radius in Earth units, log-scaled into a
+    // quarter of the step between types, so size never reorders types
+    constexpr float TYPE_STEP = 0.125f;
+    float size = std::log10(1.0f + static_cast<float>(body.getRadius()));
+    return base + 0.25f * TYPE_STEP * std::clamp(size / 2.0f, 0.0f, 1.0f);
+}
+
+void LabelLayout::add(const Simulation::CelestialBody* body, glm::vec2 anchor, glm::vec2 textSize,
+                      float priority, bool highlighted) {
+    Candidate candidate;
+    candidate.label.body = body;
+    candidate.label.anchor = anchor;
+    candidate.label.min = anchor + glm::vec2(TEXT_OFFSET_X, TEXT_OFFSET_Y);
+    candidate.label.max = candidate.label.min + textSize;
+    candidate.highlighted = highlighted;
+    
+    int bucket = static_cast<int>(std::clamp(priority, 0.0f, 1.0f) * (PRIORITY_BUCKETS - 2));
+    candidate.bucket = highlighted ? PRIORITY_BUCKETS - 1 : bucket;
+    
+    int index = static_cast<int>(m_candidates.size());
+    m_candidates.push_back(candidate);
+    m_candidateNext.push_back(m_bucketHeads[candidate.bucket]);
+    m_bucketHeads[candidate.bucket] = index;
+}
+
+void LabelLayout::cellRange(glm::vec2 min, glm::vec2 max, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = std::clamp(static_cast<int>(std::floor(min.x / CELL_WIDTH)), 0, m_columns - 1);
+    y0 = std::clamp(static_cast<int>(std::floor(min.y / CELL_HEIGHT)), 0, m_rows - 1);
+    x1 = std::clamp(static_cast<int>(std::floor(max.x / CELL_WIDTH)), 0, m_columns - 1);
+    y1 = std::clamp(static_cast<int>(std::floor(max.y / CELL_HEIGHT)), 0, m_rows - 1);
+}
+
+bool LabelLayout::overlapsPlaced(const PlacedLabel& label) const {
+    int x0, y0, x1, y1;
+    cellRange(label.min, label.max, x0, y0, x1, y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            for (int entry = m_cellHeads[y * m_columns + x]; entry >= 0; entry = m_cellEntries[entry].next) {
+                const PlacedLabel& other = m_placed[m_cellEntries[entry].placedIndex];
+                if (label.min.x < other.max.x + PADDING && other.min.x < label.max.x + PADDING &&
+                    label.min.y < other.max.y + PADDING && other.min.y < label.max.y + PADDING) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void LabelLayout::insert(int placedIndex) {
+    const PlacedLabel& label = m_placed[placedIndex];
+    int x0, y0, x1, y1;
+    cellRange(label.min, label.max, x0, y0, x1, y1);
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            int cell = y * m_columns + x;
+            m_cellEntries.push_back(CellEntry{placedIndex, m_cellHeads[cell]});
+            m_cellHeads[cell] = static_cast<int>(m_cellEntries.size()) - 1;
+        }
+    }
+}
+
+void LabelLayout::resolve() {
+    int placedRegular = 0;
+    for (int bucket = PRIORITY_BUCKETS - 1; bucket >= 0; --bucket) {
+        for (int index = m_bucketHeads[bucket]; index >= 0; index = m_candidateNext[index]) {
+            const Candidate& candidate = m_candidates[index];
+            if (!candidate.highlighted) {
+                if (placedRegular >= m_budget) return;
+                if (overlapsPlaced(candidate.label)) continue;
+                ++placedRegular;
+            }
+            m_placed.push_back(candidate.label);
+            insert(static_cast<int>(m_placed.size()) - 1);
+        }
+    }
+}
+
+const Simulation::CelestialBody* LabelLayout::hitTest(float x, float y) const {
+    if (m_placed.empty()) return nullptr;
+    
+    // The clickable area spans the anchor and the text; it reaches at most one
+    // text offset outside the text rectangle, so probe the neighbouring cells too
+    int cx = static_cast<int>(std::floor(x / CELL_WIDTH));
+    int cy = static_cast<int>(std::floor(y / CELL_HEIGHT));
+    for (int gy = std::max(cy - 1, 0); gy <= std::min(cy + 1, m_rows - 1); ++gy) {
+        for (int gx = std::max(cx - 1, 0); gx <= std::min(cx + 1, m_columns - 1); ++gx) {
+            for (int entry = m_cellHeads[gy * m_columns + gx]; entry >= 0; entry = m_cellEntries[entry].next) {
+                const PlacedLabel& label = m_placed[m_cellEntries[entry].placedIndex];
+                const float margin = PADDING * 3.0f;
+                float minX = std::min(label.min.x, label.anchor.x) - margin;
+                float minY = std::min(label.min.y, label.anchor.y) - margin;
+                float maxX = std::max(label.max.x, label.anchor.x) + margin;
+                float maxY = std::max(label.max.y, label.anchor.y) + margin;
+                if (x >= minX && x <= maxX && y >= minY && y <= maxY) {
+                    return label.body;
+                }
+            }
+        }
+    }
+    return nullptr;
+}
+
+} // namespace Render
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "simulation/CelestialBody.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Render {
+
+/// A label that survived placement, in screen pixels
+struct PlacedLabel {
+    const Simulation::CelestialBody* body = nullptr;
+    glm::vec2 anchor{0.0f};     // Projected body position
+    glm::vec2 min{0.0f};        // Text rectangle
+    glm::vec2 max{0.0f};
+};
+
+/// Screen-space label declutter.
+///
+/// Candidates are bucketed by priority (no sort) and placed highest bucket first.
+/// Each placed rectangle is registered in a uniform grid of CELL_WIDTH x
+/// CELL_HEIGHT pixel cells, so an overlap test only looks at the few labels
+/// sharing its cells and the whole pass is O(N). Labels that would overlap an
+/// earlier one are dropped, as is everything past the per-frame budget.
+///
+/// The placed set doubles as the hit-test structure for label picking.
+class LabelLayout {
+public:
+    static constexpr int PRIORITY_BUCKETS = 16;
+    static constexpr float CELL_WIDTH = 64.0f;
+    static constexpr float CELL_HEIGHT = 16.0f;
+    static constexpr float TEXT_OFFSET_X = 10.0f;   // Text sits up and right of the anchor
+    static constexpr float TEXT_OFFSET_Y = -10.0f;
+    static constexpr float PADDING = 2.0f;
+
+    /// Start a new frame's layout
+    void begin(float screenWidth, float screenHeight, int budget);
+
+    /// Offer a label. Priority is clamped to [0, 1]; highlighted labels always win
+    /// and are never culled by the budget.
+    void add(const Simulation::CelestialBody* body, glm::vec2 anchor, glm::vec2 textSize,
+             float priority, bool highlighted);
+
+    /// Resolve overlaps; fills getPlaced()
+    void resolve();
+
+    /// Priority from body type and size (0..1)
+    static float bodyPriority(const Simulation::CelestialBody& body);
+
+    const std::vector<PlacedLabel>& getPlaced() const { return m_placed; }
+    size_t getCandidateCount() const { return m_candidates.size(); }
+
+    /// Body whose placed label (text or anchor) covers the point, or nullptr
+    const Simulation::CelestialBody* hitTest(float x, float y) const;
+
+    void clear();
+
+    /// Changes whenever the placed set is rebuilt or cleared (for caching hit tests)
+    uint64_t getGeneration() const { return m_generation; }
+
+private:
+    struct Candidate {
+        PlacedLabel label;
+        int bucket = 0;
+        bool highlighted = false;
+    };
+
+    /// Grid cells covered by a rectangle (clamped to the screen)
+    void cellRange(glm::vec2 min, glm::vec2 max, int& x0, int& y0, int& x1, int& y1) const;
+    bool overlapsPlaced(const PlacedLabel& label) const;
+    void insert(int placedIndex);
+
+    int m_columns = 0;
+    int m_rows = 0;
+    int m_budget = 0;
+    uint64_t m_generation = 0;
+
+    std::vector<Candidate> m_candidates;
+    std::vector<int> m_bucketHeads;     // First candidate per priority bucket (-1 = empty)
+    std::vector<int> m_candidateNext;   // Intrusive bucket lists
+
+    std::vector<PlacedLabel> m_placed;
+    std::vector<int> m_cellHeads;       // First grid entry per cell (-1 = empty)
+    struct CellEntry {
+        int placedIndex;
+        int next;
+    };
+    std::vector<CellEntry> m_cellEntries;
+};
+
+} // namespace Render
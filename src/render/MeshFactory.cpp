@@ -1,11 +1,23 @@
 #include "MeshFactory.hpp"
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 
 namespace Render {
 
 // GLMesh implementation
 GLMesh::GLMesh(const std::vector<GLVertex>& vertices, const std::vector<uint32_t>& indices) {
-    setupMesh(vertices, indices);
+    std::vector<PackedVertex> packed(vertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        packed[i].position = vertices[i].position;
+        MeshFactory::encodeOctahedral(vertices[i].normal, packed[i].normal);
+    }
+    setupMesh(VertexFormat::PositionOctNormal, packed.data(), packed.size(), indices);
+}
+
+GLMesh::GLMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+    setupMesh(VertexFormat::Position, positions.data(), positions.size(), indices);
 }
 
 GLMesh::~GLMesh() {
@@ -16,7 +28,10 @@ GLMesh::GLMesh(GLMesh&& other) noexcept
     : m_vao(other.m_vao)
     , m_vbo(other.m_vbo)
     , m_ebo(other.m_ebo)
-    , m_indexCount(other.m_indexCount) {
+    , m_indexCount(other.m_indexCount)
+    , m_indexType(other.m_indexType)
+    , m_format(other.m_format)
+    , m_memoryBytes(other.m_memoryBytes) {
     other.m_vao = 0;
     other.m_vbo = 0;
     other.m_ebo = 0;
@@ -30,6 +45,9 @@ GLMesh& GLMesh::operator=(GLMesh&& other) noexcept {
         m_vbo = other.m_vbo;
         m_ebo = other.m_ebo;
         m_indexCount = other.m_indexCount;
+        m_indexType = other.m_indexType;
+        m_format = other.m_format;
+        m_memoryBytes = other.m_memoryBytes;
         other.m_vao = 0;
         other.m_vbo = 0;
         other.m_ebo = 0;
@@ -38,9 +56,14 @@ GLMesh& GLMesh::operator=(GLMesh&& other) noexcept {
     return *this;
 }
 
-void GLMesh::setupMesh(const std::vector<GLVertex>& vertices, const std::vector<uint32_t>& indices) {
+void GLMesh::setupMesh(VertexFormat format, const void* vertexData, size_t vertexCount,
+                       const std::vector<uint32_t>& indices) {
+    m_format = format;
     m_indexCount = static_cast<uint32_t>(indices.size());
     
+    const size_t stride = (format == VertexFormat::Position) ? sizeof(glm::vec3) : sizeof(PackedVertex);
+    const size_t vertexBytes = vertexCount * stride;
+    
     glGenVertexArrays(1, &m_vao);
     glGenBuffers(1, &m_vbo);
     glGenBuffers(1, &m_ebo);
@@ -48,22 +71,33 @@ void GLMesh::setupMesh(const std::vector<GLVertex>& vertices, const std::vector<
     glBindVertexArray(m_vao);
     
     glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLVertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexBytes), vertexData, GL_STATIC_DRAW);
     
+    // 16-bit indices halve the index buffer for anything under 64k vertices
+    size_t indexBytes = 0;
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    if (vertexCount <= std::numeric_limits<uint16_t>::max() + size_t(1)) {
+        std::vector<uint16_t> shortIndices(indices.begin(), indices.end());
+        m_indexType = GL_UNSIGNED_SHORT;
+        indexBytes = shortIndices.size() * sizeof(uint16_t);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexBytes), shortIndices.data(), GL_STATIC_DRAW);
+    } else {
+        m_indexType = GL_UNSIGNED_INT;
+        indexBytes = indices.size() * sizeof(uint32_t);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indexBytes), indices.data(), GL_STATIC_DRAW);
+    }
+    m_memoryBytes = vertexBytes + indexBytes;
     
     // Position
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GLVertex), (void*)offsetof(GLVertex, position));
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, static_cast<GLsizei>(stride), (void*)0);
     glEnableVertexAttribArray(0);
     
-    // Color
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(GLVertex), (void*)offsetof(GLVertex, color));
-    glEnableVertexAttribArray(1);
-    
-    // Normal
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(GLVertex), (void*)offsetof(GLVertex, normal));
-    glEnableVertexAttribArray(2);
+    // Octahedral normal (normalized snorm16 -> [-1, 1])
+    if (format == VertexFormat::PositionOctNormal) {
+        glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, static_cast<GLsizei>(stride),
+                              (void*)offsetof(PackedVertex, normal));
+        glEnableVertexAttribArray(2);
+    }
     
     glBindVertexArray(0);
 }
@@ -93,16 +127,37 @@ void GLMesh::unbind() const {
 
 void GLMesh::draw(GLenum mode) const {
     glBindVertexArray(m_vao);
-    glDrawElements(mode, m_indexCount, GL_UNSIGNED_INT, 0);
+    glDrawElements(mode, m_indexCount, m_indexType, 0);
+}
+
+void GLMesh::drawBound(GLenum mode) const {
+    glDrawElements(mode, m_indexCount, m_indexType, 0);
 }
 
 // MeshFactory implementation
+void MeshFactory::encodeOctahedral(const glm::vec3& normal, int16_t out[2]) {
+    // Project onto the octahedron |x| + |y| + |z| = 1, then fold the lower half over the diagonals
+    float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    float x = l1 > 0.0f ? normal.x / l1 : 0.0f;
+    float y = l1 > 0.0f ? normal.y / l1 : 0.0f;
+    if (normal.z < 0.0f) {
+        float fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+    out[0] = static_cast<int16_t>(std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+    out[1] = static_cast<int16_t>(std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f));
+}
+
 std::unique_ptr<GLMesh> MeshFactory::createSphere(int sectorCount, int stackCount) {
-    std::vector<GLVertex> vertices;
+    // Unit sphere: the normal equals the position, so only positions are stored
+    std::vector<glm::vec3> vertices;
     std::vector<uint32_t> indices;
+    vertices.reserve(static_cast<size_t>(stackCount + 1) * (sectorCount + 1));
+    indices.reserve(static_cast<size_t>(stackCount) * sectorCount * 6);
     
     float x, y, z, xy;
-    float nx, ny, nz, lengthInv = 1.0f;
     
     float sectorStep = 2.0f * PI / sectorCount;
     float stackStep = PI / stackCount;
@@ -119,15 +174,7 @@ std::unique_ptr<GLMesh> MeshFactory::createSphere(int sectorCount, int stackCoun
             x = xy * std::cos(sectorAngle);
             y = xy * std::sin(sectorAngle);
             
-            nx = x * lengthInv;
-            ny = y * lengthInv;
-            nz = z * lengthInv;
-            
-            GLVertex vertex;
-            vertex.position = glm::vec3(x, z, y);  // Swap Y/Z for Y-up
-            vertex.color = glm::vec3(1.0f);
-            vertex.normal = glm::vec3(nx, nz, ny);
-            vertices.push_back(vertex);
+            vertices.push_back(glm::vec3(x, z, y));  // Swap Y/Z for Y-up
         }
     }
     
@@ -154,7 +201,7 @@ std::unique_ptr<GLMesh> MeshFactory::createSphere(int sectorCount, int stackCoun
 }
 
 std::unique_ptr<GLMesh> MeshFactory::createCircle(int segments) {
-    std::vector<GLVertex> vertices;
+    std::vector<glm::vec3> vertices;
     std::vector<uint32_t> indices;
     
     for (int i = 0; i <= segments; ++i) {
@@ -162,11 +209,7 @@ std::unique_ptr<GLMesh> MeshFactory::createCircle(int segments) {
         float x = std::cos(theta);
         float z = std::sin(theta);
         
-        GLVertex vertex;
-        vertex.position = glm::vec3(x, 0.0f, z);
-        vertex.color = glm::vec3(0.3f);
-        vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
-        vertices.push_back(vertex);
+        vertices.push_back(glm::vec3(x, 0.0f, z));
         
         if (i < segments) {
             indices.push_back(i);
@@ -206,4 +249,37 @@ std::unique_ptr<GLMesh> MeshFactory::createCube() {
     return std::make_unique<GLMesh>(vertices, indices);
 }
 
+// MeshCache implementation
+const GLMesh* MeshCache::getSphere(int sectorCount, int stackCount) {
+    auto& mesh = m_meshes[Key{Shape::Sphere, sectorCount, stackCount}];
+    if (!mesh) {
+        mesh = MeshFactory::createSphere(sectorCount, stackCount);
+    }
+    return mesh.get();
+}
+
+const GLMesh* MeshCache::getCircle(int segments) {
+    auto& mesh = m_meshes[Key{Shape::Circle, segments, 0}];
+    if (!mesh) {
+        mesh = MeshFactory::createCircle(segments);
+    }
+    return mesh.get();
+}
+
+const GLMesh* MeshCache::getCube() {
+    auto& mesh = m_meshes[Key{Shape::Cube, 0, 0}];
+    if (!mesh) {
+        mesh = MeshFactory::createCube();
+    }
+    return mesh.get();
+}
+
+size_t MeshCache::getMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& [key, mesh] : m_meshes) {
+        bytes += mesh->getMemoryBytes();
+    }
+    return bytes;
+}
+
 } // namespace Render
@@ -1,63 +1,118 @@
 #pragma once
 
-#include <vector>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <tuple>
+#include <vector>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
 namespace Render {
 
-/// Vertex data for OpenGL meshes
+/// Vertex data for authoring general meshes (packed on upload)
 struct GLVertex {
     glm::vec3 position;
     glm::vec3 color;
     glm::vec3 normal;
 };
 
-/// OpenGL mesh data - manages VAO, VBO, EBO
+/// Vertex layout as stored on the GPU
+enum class VertexFormat {
+    Position,            // 12 bytes: vec3 at location 0 (unit spheres: normal == position)
+    PositionOctNormal    // 16 bytes: vec3 + octahedral snorm16x2 normal at location 2
+};
+
+/// GPU vertex for VertexFormat::PositionOctNormal
+struct PackedVertex {
+    glm::vec3 position;
+    int16_t normal[2];   // Octahedral encoding, see MeshFactory::encodeOctahedral
+};
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must stay 16 bytes");
+
+/// OpenGL mesh data - manages VAO, VBO, EBO.
+/// Indices are stored as 16-bit whenever the vertex count allows it.
 class GLMesh {
 public:
+    /// General mesh: colors are dropped and normals octahedral-encoded
     GLMesh(const std::vector<GLVertex>& vertices, const std::vector<uint32_t>& indices);
+
+    /// Position-only mesh (normals, if needed, are derived in the shader)
+    GLMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
     ~GLMesh();
-    
+
     // Non-copyable
     GLMesh(const GLMesh&) = delete;
     GLMesh& operator=(const GLMesh&) = delete;
-    
+
     // Movable
     GLMesh(GLMesh&& other) noexcept;
     GLMesh& operator=(GLMesh&& other) noexcept;
-    
+
     void bind() const;
     void unbind() const;
     void draw(GLenum mode = GL_TRIANGLES) const;
-    
+
+    /// Issue the draw call assuming this mesh's VAO is already bound
+    void drawBound(GLenum mode = GL_TRIANGLES) const;
+
     uint32_t getIndexCount() const { return m_indexCount; }
+    GLuint getVertexArray() const { return m_vao; }
+    VertexFormat getFormat() const { return m_format; }
+    bool hasNormals() const { return m_format == VertexFormat::PositionOctNormal; }
+
+    /// Vertex plus index buffer size in bytes
+    size_t getMemoryBytes() const { return m_memoryBytes; }
 
 private:
-    void setupMesh(const std::vector<GLVertex>& vertices, const std::vector<uint32_t>& indices);
+    void setupMesh(VertexFormat format, const void* vertexData, size_t vertexCount,
+                   const std::vector<uint32_t>& indices);
     void cleanup();
-    
+
     GLuint m_vao = 0;
     GLuint m_vbo = 0;
     GLuint m_ebo = 0;
     uint32_t m_indexCount = 0;
+    GLenum m_indexType = GL_UNSIGNED_INT;
+    VertexFormat m_format = VertexFormat::Position;
+    size_t m_memoryBytes = 0;
 };
 
 /// Factory for creating common mesh shapes
 class MeshFactory {
 public:
-    /// Create a UV sphere
+    /// Create a unit UV sphere (position-only)
     static std::unique_ptr<GLMesh> createSphere(int sectorCount = 32, int stackCount = 32);
-    
-    /// Create a unit circle (for orbit lines)
+
+    /// Create a unit circle (for orbit lines, position-only)
     static std::unique_ptr<GLMesh> createCircle(int segments = 128);
-    
+
     /// Create a simple cube
     static std::unique_ptr<GLMesh> createCube();
 
+    /// Octahedral normal encoding into two snorm16 components
+    static void encodeOctahedral(const glm::vec3& normal, int16_t out[2]);
+
 private:
     static constexpr double PI = 3.14159265358979323846;
 };
 
+/// Shared meshes keyed by shape and parameters, so identical meshes are built once
+class MeshCache {
+public:
+    const GLMesh* getSphere(int sectorCount, int stackCount);
+    const GLMesh* getCircle(int segments);
+    const GLMesh* getCube();
+
+    void clear() { m_meshes.clear(); }
+    size_t getMeshCount() const { return m_meshes.size(); }
+    size_t getMemoryBytes() const;
+
+private:
+    enum class Shape { Sphere, Circle, Cube };
+    using Key = std::tuple<Shape, int, int>;
+
+    std::map<Key, std::unique_ptr<GLMesh>> m_meshes;
+};
+
 } // namespace Render
@@ -0,0 +1,142 @@
+#include "ParticleRenderer.hpp"
+#include "PickingPass.hpp"
+#include "core/Logger.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace Render {
+
+bool ParticleRenderer::detectSoftwareRasterizer() {
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    return renderer &&
+        (std::strstr(renderer, "llvmpipe") || std::strstr(renderer, "softpipe") || std::strstr(renderer, "SWR"));
+}
+
+ParticleRenderer::ParticleRenderer()
+    : m_softwareRenderer(detectSoftwareRasterizer()) {
+    if (m_softwareRenderer) {
+        LOG_INFO("ParticleRenderer", "Software rasterizer detected, limiting particles to ",
+                 SOFTWARE_PARTICLE_BUDGET, " per frame");
+    }
+}
+
+ParticleRenderer::~ParticleRenderer() {
+    release();
+}
+
+void ParticleRenderer::release() {
+    for (auto& population : m_populations) {
+        glDeleteVertexArrays(1, &population.vao);
+        glDeleteBuffers(1, &population.vbo);
+    }
+    m_populations.clear();
+    m_totalCount = 0;
+}
+
+void ParticleRenderer::setDensity(float density) {
+    m_density = std::clamp(density, 0.0f, 1.0f);
+}
+
+GLsizei ParticleRenderer::drawCount(const PopulationBuffers& population) const {
+    float fraction = m_density * m_budgetScale;
+    return static_cast<GLsizei>(static_cast<float>(population.count) * fraction);
+}
+
+size_t ParticleRenderer::getDrawnCount() const {
+    size_t drawn = 0;
+    for (const auto& population : m_populations) {
+        drawn += static_cast<size_t>(drawCount(population));
+    }
+    return drawn;
+}
+
+void ParticleRenderer::update(const Simulation::SolarSystem& solarSystem) {
+    if (m_hasGeneration && solarSystem.getSystemGeneration() == m_generation) return;
+    m_generation = solarSystem.getSystemGeneration();
+    m_hasGeneration = true;
+
+    release();
+
+    const auto& sources = solarSystem.getPopulations();
+    for (size_t index = 0; index < sources.size(); ++index) {
+        const auto& source = sources[index];
+        std::span<const Simulation::ParticleElements> elements = source.getElements();
+        if (elements.empty()) continue;
+
+        PopulationBuffers population;
+        population.sourceIndex = static_cast<uint32_t>(index);
+        population.count = static_cast<GLsizei>(elements.size());
+        population.color = source.color;
+        population.pointSize = source.pointSize;
+        population.opacity = source.opacity;
+        population.parent = source.parent;
+
+        glGenVertexArrays(1, &population.vao);
+        glGenBuffers(1, &population.vbo);
+        glBindVertexArray(population.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, population.vbo);
+        glBufferData(GL_ARRAY_BUFFER,
+                     static_cast<GLsizeiptr>(elements.size() * sizeof(Simulation::ParticleElements)),
+                     elements.data(), GL_STATIC_DRAW);
+
+        // Location 0: a, e, i, period - location 1: M0, node, argument of periapsis, size
+        const GLsizei stride = sizeof(Simulation::ParticleElements);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        glBindVertexArray(0);
+
+        m_totalCount += elements.size();
+        m_populations.push_back(population);
+    }
+
+    m_budgetScale = 1.0f;
+    if (m_softwareRenderer && m_totalCount > SOFTWARE_PARTICLE_BUDGET) {
+        m_budgetScale = static_cast<float>(SOFTWARE_PARTICLE_BUDGET) / static_cast<float>(m_totalCount);
+    }
+
+    if (m_totalCount > 0) {
+        LOG_INFO("ParticleRenderer", "Uploaded ", m_populations.size(), " populations (", m_totalCount,
+                 " particles, ", (m_totalCount * sizeof(Simulation::ParticleElements)) / (1024 * 1024), " MB)");
+    }
+}
+
+void ParticleRenderer::draw(ShaderManager& shaderManager, GLuint shader,
+                            double simulationTime, bool physicsEnabled) const {
+    if (m_populations.empty()) return;
+
+    GLint centerLoc = shaderManager.getUniformLocation(shader, "center");
+    GLint colorLoc = shaderManager.getUniformLocation(shader, "particleColor");
+    GLint opacityLoc = shaderManager.getUniformLocation(shader, "opacity");
+    GLint sizeLoc = shaderManager.getUniformLocation(shader, "pointSize");
+    GLint populationIdLoc = shaderManager.getUniformLocation(shader, "populationId");
+
+    for (const auto& population : m_populations) {
+        GLsizei count = drawCount(population);
+        if (count == 0) continue;
+
+        if (populationIdLoc >= 0) {
+            glUniform1ui(populationIdLoc, PickingPass::populationId(population.sourceIndex));
+        }
+
+        // Rings follow their planet; the elements are relative to it
+        glm::vec3 center(0.0f);
+        if (population.parent) {
+            center = physicsEnabled ? population.parent->getPhysicsPosition()
+                                    : population.parent->getWorldPosition(simulationTime);
+        }
+
+        glUniform3fv(centerLoc, 1, glm::value_ptr(center));
+        glUniform3fv(colorLoc, 1, glm::value_ptr(population.color));
+        glUniform1f(opacityLoc, population.opacity);
+        glUniform1f(sizeLoc, population.pointSize);
+
+        glBindVertexArray(population.vao);
+        glDrawArrays(GL_POINTS, 0, count);
+    }
+    glBindVertexArray(0);
+}
+
+} // namespace Render
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ShaderManager.hpp"
+#include "simulation/SolarSystem.hpp"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Render {
+
+/// Draws particle populations (asteroid belts, planetary rings) as point clouds.
+///
+/// Each population's packed orbital elements are uploaded once per system load
+/// into a static VBO. Positions are never computed on the CPU: the vertex shader
+/// solves Kepler's equation per point from the elements and the simulation time.
+class ParticleRenderer {
+public:
+    /// Total points drawn per frame on software rasterizers (llvmpipe)
+    static constexpr size_t SOFTWARE_PARTICLE_BUDGET = 150000;
+
+    ParticleRenderer();
+    ~ParticleRenderer();
+
+    // Non-copyable
+    ParticleRenderer(const ParticleRenderer&) = delete;
+    ParticleRenderer& operator=(const ParticleRenderer&) = delete;
+
+    /// Re-upload populations when a new system has been loaded
+    void update(const Simulation::SolarSystem& solarSystem);
+
+    /// Draw all populations. The particle shader must be bound with its frame uniforms set.
+    /// With the ID picking shader (which has an `populationId` uniform) each population
+    /// writes its PickingPass particle IDs.
+    void draw(ShaderManager& shaderManager, GLuint shader,
+              double simulationTime, bool physicsEnabled) const;
+
+    /// Fraction of each population drawn (elements are stored in random order,
+    /// so drawing a prefix is an unbiased subsample)
+    void setDensity(float density);
+    float getDensity() const { return m_density; }
+
+    size_t getTotalCount() const { return m_totalCount; }
+    size_t getDrawnCount() const;
+    size_t getMemoryBytes() const { return m_totalCount * sizeof(Simulation::ParticleElements); }
+    bool isSoftwareRenderer() const { return m_softwareRenderer; }
+    
+    /// True when GL_RENDERER is a Mesa software rasterizer (llvmpipe, softpipe, SWR)
+    static bool detectSoftwareRasterizer();
+
+private:
+    struct PopulationBuffers {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+        GLsizei count = 0;
+        glm::vec3 color{1.0f};
+        float pointSize = 1.0f;
+        float opacity = 1.0f;
+        const Simulation::CelestialBody* parent = nullptr;
+        uint32_t sourceIndex = 0;   // Index in SolarSystem::getPopulations() (picking IDs)
+    };
+
+    void release();
+    GLsizei drawCount(const PopulationBuffers& population) const;
+
+    std::vector<PopulationBuffers> m_populations;
+    size_t m_totalCount = 0;
+    float m_density = 1.0f;
+    float m_budgetScale = 1.0f;   // Software-rasterizer cap, applied on top of density
+    bool m_softwareRenderer = false;
+
+    uint64_t m_generation = 0;
+    bool m_hasGeneration = false;
+};
+
+} // namespace Render
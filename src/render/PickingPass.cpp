@@ -0,0 +1,155 @@
+#include "PickingPass.hpp"
+#include "core/Logger.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace Render {
+
+PickingPass::PickingPass() {
+    glGenRenderbuffers(1, &m_idBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_idBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RG32UI, WINDOW_SIZE, WINDOW_SIZE);
+    
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, WINDOW_SIZE, WINDOW_SIZE);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    
+    GLint previous = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_idBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_ERROR("PickingPass", "ID framebuffer is incomplete, GPU picking disabled");
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous));
+    
+    const GLsizeiptr bytes = WINDOW_SIZE * WINDOW_SIZE * 2 * sizeof(uint32_t);
+    for (auto& slot : m_slots) {
+        glGenBuffers(1, &slot.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+PickingPass::~PickingPass() {
+    for (auto& slot : m_slots) {
+        if (slot.fence) glDeleteSync(slot.fence);
+        if (slot.pbo) glDeleteBuffers(1, &slot.pbo);
+    }
+    if (m_framebuffer) glDeleteFramebuffers(1, &m_framebuffer);
+    if (m_idBuffer) glDeleteRenderbuffers(1, &m_idBuffer);
+    if (m_depthBuffer) glDeleteRenderbuffers(1, &m_depthBuffer);
+}
+
+void PickingPass::request(float x, float y) {
+    m_x = x;
+    m_y = y;
+    m_requested = m_framebuffer != 0;
+}
+
+glm::mat4 PickingPass::getPickMatrix(int viewportWidth, int viewportHeight) const {
+    // gluPickMatrix: scale the pick window up to the whole NDC square, centred on the cursor
+    const float size = static_cast<float>(WINDOW_SIZE);
+    float w = static_cast<float>(viewportWidth);
+    float h = static_cast<float>(viewportHeight);
+    float glY = h - m_y;
+    glm::mat4 pick = glm::translate(glm::mat4(1.0f),
+                                    glm::vec3((w - 2.0f * m_x) / size, (h - 2.0f * glY) / size, 0.0f));
+    return glm::scale(pick, glm::vec3(w / size, h / size, 1.0f));
+}
+
+void PickingPass::begin() {
+    m_bodies.clear();
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, WINDOW_SIZE, WINDOW_SIZE);
+    const GLuint background[4] = {0, 0, 0, 0};
+    glClearBufferuiv(GL_COLOR, 0, background);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+uint32_t PickingPass::registerBody(const Simulation::CelestialBody* body) {
+    m_bodies.push_back(body);
+    return static_cast<uint32_t>(m_bodies.size());
+}
+
+void PickingPass::end(uint64_t systemGeneration) {
+    m_requested = false;
+    
+    Slot& slot = m_slots[m_nextSlot];
+    if (slot.pending) {
+        // Still in flight from PBO_COUNT passes ago; skip this pick rather than stall
+        return;
+    }
+    
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glReadPixels(0, 0, WINDOW_SIZE, WINDOW_SIZE, GL_RG_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.bodies.swap(m_bodies);
+    slot.systemGeneration = systemGeneration;
+    slot.pending = true;
+    m_nextSlot = (m_nextSlot + 1) % PBO_COUNT;
+}
+
+void PickingPass::resolve() {
+    // Oldest first, so the newest finished readback wins
+    for (int i = 0; i < PBO_COUNT; ++i) {
+        Slot& slot = m_slots[(m_nextSlot + i) % PBO_COUNT];
+        if (!slot.pending) continue;
+        
+        GLenum status = glClientWaitSync(slot.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) continue;
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+        slot.pending = false;
+        
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+        const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                            WINDOW_SIZE * WINDOW_SIZE * 2 * sizeof(uint32_t), GL_MAP_READ_BIT);
+        if (data) {
+            decode(static_cast<const uint32_t*>(data), slot);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+}
+
+void PickingPass::decode(const uint32_t* ids, const Slot& slot) {
+    // Nearest non-background pixel to the cursor (two channels per pixel)
+    const int center = WINDOW_SIZE / 2;
+    uint32_t bestId = 0;
+    uint32_t bestIndex = 0;
+    int bestDist = WINDOW_SIZE * WINDOW_SIZE * 2;
+    for (int y = 0; y < WINDOW_SIZE; ++y) {
+        for (int x = 0; x < WINDOW_SIZE; ++x) {
+            const uint32_t* pixel = ids + 2 * (y * WINDOW_SIZE + x);
+            if (pixel[0] == 0) continue;
+            int dist = (x - center) * (x - center) + (y - center) * (y - center);
+            if (dist < bestDist) {
+                bestDist = dist;
+                bestId = pixel[0];
+                bestIndex = pixel[1];
+            }
+        }
+    }
+    
+    m_result = PickResult{};
+    m_result.valid = true;
+    m_result.systemGeneration = slot.systemGeneration;
+    if (bestId & PARTICLE_FLAG) {
+        m_result.particle.population = static_cast<int>(bestId & ~PARTICLE_FLAG);
+        m_result.particle.index = bestIndex;
+    } else if (bestId > 0 && bestId <= slot.bodies.size()) {
+        m_result.body = slot.bodies[bestId - 1];
+    }
+}
+
+} // namespace Render
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "simulation/CelestialBody.hpp"
+#include "simulation/ParticlePopulation.hpp"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Render {
+
+/// What the ID buffer showed under the cursor
+struct PickResult {
+    const Simulation::CelestialBody* body = nullptr;
+    Simulation::ParticleRef particle;   // Invalid unless a particle was hit
+    uint64_t systemGeneration = 0;
+    bool valid = false;           // False until the first readback completes
+};
+
+/// GPU ID-buffer picking.
+///
+/// When a pick is requested, the renderer redraws bodies and particle populations
+/// into a WINDOW_SIZE x WINDOW_SIZE RG32UI target whose projection covers only the
+/// pixels around the cursor, then starts an asynchronous glReadPixels into a PBO.
+/// The PBO is mapped on a later frame once its fence has signaled, so the CPU
+/// never waits on the GPU; results are one or two frames old.
+///
+/// IDs: the red channel is 0 for background, 1..N for bodies in registration
+/// order, or PARTICLE_FLAG | population for particles, whose element index is
+/// written to the green channel, so every population and element is addressable.
+class PickingPass {
+public:
+    static constexpr int WINDOW_SIZE = 9;
+    static constexpr int PBO_COUNT = 2;
+    static constexpr uint32_t PARTICLE_FLAG = 0x80000000u;
+
+    PickingPass();
+    ~PickingPass();
+
+    // Non-copyable
+    PickingPass(const PickingPass&) = delete;
+    PickingPass& operator=(const PickingPass&) = delete;
+
+    /// Ask for a pick at window coordinates (top-left origin) on the next frame
+    void request(float x, float y);
+    bool hasRequest() const { return m_requested; }
+
+    /// Map any finished readbacks; call once per frame before issuing a new pass
+    void resolve();
+
+    /// Projection pre-multiplier that maps the pick window around the cursor to the full target
+    glm::mat4 getPickMatrix(int viewportWidth, int viewportHeight) const;
+
+    /// Bind and clear the ID target, reset the body table
+    void begin();
+
+    /// ID to write for a body this pass
+    uint32_t registerBody(const Simulation::CelestialBody* body);
+
+    /// Red-channel ID for a particle population
+    static uint32_t populationId(uint32_t population) { return PARTICLE_FLAG | population; }
+
+    /// Queue the readback and consume the request
+    void end(uint64_t systemGeneration);
+
+    const PickResult& getResult() const { return m_result; }
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        std::vector<const Simulation::CelestialBody*> bodies;   // ID table at the time of the pass
+        uint64_t systemGeneration = 0;
+        bool pending = false;
+    };
+
+    void decode(const uint32_t* ids, const Slot& slot);
+
+    GLuint m_framebuffer = 0;
+    GLuint m_idBuffer = 0;
+    GLuint m_depthBuffer = 0;
+    std::array<Slot, PBO_COUNT> m_slots{};
+    int m_nextSlot = 0;
+
+    std::vector<const Simulation::CelestialBody*> m_bodies;
+    float m_x = 0.0f;
+    float m_y = 0.0f;
+    bool m_requested = false;
+    PickResult m_result;
+};
+
+} // namespace Render
@@ -0,0 +1,65 @@
+#include "QualityGovernor.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+
+namespace Render {
+
+//                        lod  planet moon labels trails particles scale
+const std::array<QualitySettings, QualityGovernor::LEVEL_COUNT> QualityGovernor::LEVELS = {{
+    {0, 256, 128, 256, 1.00f, 1.00f, 1.00f},
+    {0, 192,  96, 128, 0.75f, 0.75f, 1.00f},
+    {1, 128,  64,  64, 0.50f, 0.50f, 0.85f},
+    {1,  96,  48,  32, 0.35f, 0.35f, 0.75f},
+    {2,  64,  32,  16, 0.25f, 0.20f, 0.65f},
+    {3,  48,  24,   8, 0.15f, 0.10f, 0.50f},
+}};
+
+QualityGovernor::QualityGovernor() = default;
+
+void QualityGovernor::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    if (!m_enabled) {
+        // Disabled means full quality, not frozen at whatever level was reached
+        m_level = 0;
+        m_goodEvaluations = 0;
+    }
+}
+
+void QualityGovernor::update(float cpuMs, float gpuMs) {
+    m_cpuMs = cpuMs;
+    m_gpuMs = gpuMs;
+
+    // Whichever side is the bottleneck sets the frame time
+    float frameMs = std::max(cpuMs, gpuMs);
+    m_smoothedMs = (m_smoothedMs == 0.0f) ? frameMs : m_smoothedMs + 0.1f * (frameMs - m_smoothedMs);
+
+    if (!m_enabled) return;
+    if (++m_framesSinceEvaluation < EVALUATION_FRAMES) return;
+    m_framesSinceEvaluation = 0;
+
+    if (m_smoothedMs > m_targetMs * OVER_BUDGET && m_level + 1 < LEVEL_COUNT) {
+        ++m_level;
+        m_goodEvaluations = 0;
+        LOG_INFO("QualityGovernor", "Frame time ", m_smoothedMs, " ms over ", m_targetMs,
+                 " ms target, quality level ", m_level);
+    } else if (m_smoothedMs < m_targetMs * HEADROOM && m_level > 0) {
+        if (++m_goodEvaluations >= RECOVERY_EVALUATIONS) {
+            --m_level;
+            m_goodEvaluations = 0;
+            LOG_INFO("QualityGovernor", "Frame time ", m_smoothedMs, " ms, raising quality to level ", m_level);
+        }
+    } else {
+        m_goodEvaluations = 0;
+    }
+}
+
+QualitySettings QualityGovernor::getSettings() const {
+    QualitySettings settings = LEVELS[m_enabled ? m_level : 0];
+    if (!m_allowResolutionScaling) {
+        settings.renderScale = 1.0f;
+    }
+    return settings;
+}
+
+} // namespace Render
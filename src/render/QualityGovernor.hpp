@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+
+namespace Render {
+
+/// Render-quality knobs that the governor trades against frame time
+struct QualitySettings {
+    int sphereLodBias = 0;          // Added to the screen-size sphere LOD (0 = finest)
+    int planetOrbitSegments = 256;
+    int moonOrbitSegments = 128;
+    int labelBudget = 256;          // Labels drawn per frame (hovered/selected always shown)
+    float trailScale = 1.0f;        // Fraction of the user's trail length drawn
+    float particleDensity = 1.0f;   // Fraction of particle populations drawn
+    float renderScale = 1.0f;       // Scene resolution relative to the window
+};
+
+/// Adaptive quality controller that holds a frame-time target.
+///
+/// Each frame it is fed the CPU time (frame time excluding the buffer swap, so
+/// vsync waits don't count as load) and the GPU time from the pass profiler.
+/// The larger of the two is smoothed and compared against the target every
+/// EVALUATION_FRAMES frames: quality steps down one level as soon as the budget
+/// is exceeded, and steps back up only after several evaluations with clear
+/// headroom, so it doesn't oscillate around the threshold.
+class QualityGovernor {
+public:
+    static constexpr int LEVEL_COUNT = 6;
+    static constexpr int EVALUATION_FRAMES = 30;
+    static constexpr int RECOVERY_EVALUATIONS = 3;
+    static constexpr float OVER_BUDGET = 1.05f;    // Step down above target * this
+    static constexpr float HEADROOM = 0.7f;        // Step up below target * this
+
+    QualityGovernor();
+
+    /// Feed one frame's timings (milliseconds)
+    void update(float cpuMs, float gpuMs);
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    void setTargetFrameMs(float ms) { m_targetMs = ms; }
+    float getTargetFrameMs() const { return m_targetMs; }
+
+    /// Allow the lower levels to shrink the offscreen scene resolution
+    void setResolutionScalingAllowed(bool allowed) { m_allowResolutionScaling = allowed; }
+    bool isResolutionScalingAllowed() const { return m_allowResolutionScaling; }
+
+    /// Settings for the current level (level 0 when disabled)
+    QualitySettings getSettings() const;
+    int getLevel() const { return m_level; }
+    float getSmoothedFrameMs() const { return m_smoothedMs; }
+    float getCpuMs() const { return m_cpuMs; }
+    float getGpuMs() const { return m_gpuMs; }
+
+private:
+    static const std::array<QualitySettings, LEVEL_COUNT> LEVELS;
+
+    bool m_enabled = true;
+    bool m_allowResolutionScaling = false;
+    float m_targetMs = 1000.0f / 60.0f;
+
+    int m_level = 0;
+    int m_framesSinceEvaluation = 0;
+    int m_goodEvaluations = 0;
+    float m_smoothedMs = 0.0f;
+    float m_cpuMs = 0.0f;
+    float m_gpuMs = 0.0f;
+};
+
+} // namespace Render
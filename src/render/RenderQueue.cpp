@@ -0,0 +1,75 @@
+#include "RenderQueue.hpp"
+#include "MeshFactory.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Render {
+
+namespace {
+    constexpr uint32_t DEPTH_BITS = 24;
+    constexpr uint32_t DEPTH_MAX = (1u << DEPTH_BITS) - 1;
+    constexpr uint32_t SHADER_MAX = (1u << 12) - 1;
+    constexpr uint32_t MESH_MAX = (1u << 24) - 1;
+}
+
+void RenderQueue::clear() {
+    m_commands.clear();
+    m_order.clear();
+    std::fill(m_shaderIds.begin(), m_shaderIds.end(), 0u);
+    std::fill(m_meshIds.begin(), m_meshIds.end(), 0u);
+    m_shaderCount = 0;
+    m_meshCount = 0;
+}
+
+void RenderQueue::setDepthRange(float nearPlane, float farPlane) {
+    m_nearPlane = std::max(nearPlane, 1e-4f);
+    m_farPlane = std::max(farPlane, m_nearPlane * 2.0f);
+}
+
+uint32_t RenderQueue::quantizeDepth(float viewDepth) const {
+    // Logarithmic mapping keeps precision across the huge near/far ratio
+    float d = std::clamp(viewDepth, m_nearPlane, m_farPlane);
+    float t = std::log(d / m_nearPlane) / std::log(m_farPlane / m_nearPlane);
+    return static_cast<uint32_t>(t * static_cast<float>(DEPTH_MAX));
+}
+
+uint32_t RenderQueue::getDenseId(std::vector<uint32_t>& ids, uint32_t& count, GLuint name) {
+    // GL hands out small consecutive names, so a flat table stays tiny
+    if (name >= ids.size()) {
+        ids.resize(name + 1, 0u);
+    }
+    if (ids[name] == 0) {
+        ids[name] = ++count;
+    }
+    return ids[name];
+}
+
+uint64_t RenderQueue::makeKey(RenderPass pass, uint32_t shaderId, uint32_t meshId, uint32_t depthBits) {
+    uint64_t p = static_cast<uint64_t>(pass) & 0xF;
+    uint64_t s = std::min(shaderId, SHADER_MAX);
+    uint64_t m = std::min(meshId, MESH_MAX);
+    uint64_t d = static_cast<uint64_t>(depthBits) & DEPTH_MAX;
+
+    if (pass == RenderPass::Transparent) {
+        return (p << 60) | ((DEPTH_MAX - d) << 36) | (s << 24) | m;
+    }
+    return (p << 60) | (s << 48) | (m << 24) | d;
+}
+
+void RenderQueue::submit(DrawCommand command, float viewDepth) {
+    uint32_t shaderId = getDenseId(m_shaderIds, m_shaderCount, command.shader);
+    uint32_t meshId = command.mesh ? getDenseId(m_meshIds, m_meshCount, command.mesh->getVertexArray()) : 0;
+    command.sortKey = makeKey(command.pass, shaderId, meshId, quantizeDepth(viewDepth));
+
+    m_order.push_back({command.sortKey, static_cast<uint32_t>(m_commands.size())});
+    m_commands.push_back(command);
+}
+
+void RenderQueue::sort() {
+    // Ties fall back to submission order
+    std::sort(m_order.begin(), m_order.end(), [](const SortEntry& a, const SortEntry& b) {
+        return a.key != b.key ? a.key < b.key : a.index < b.index;
+    });
+}
+
+} // namespace Render
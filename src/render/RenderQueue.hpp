@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+namespace Simulation {
+class CelestialBody;
+}
+
+namespace Render {
+
+class GLMesh;
+
+/// Render passes, executed in enum order
+enum class RenderPass : uint8_t {
+    Opaque = 0,       // Depth-writing geometry, sorted front-to-back for early-Z
+    Transparent = 1   // Blended geometry (orbit lines), sorted back-to-front
+};
+
+/// A single draw submission. Everything needed to issue the draw is captured
+/// at submit time so the queue can be executed in any order.
+struct DrawCommand {
+    uint64_t sortKey = 0;
+    RenderPass pass = RenderPass::Opaque;
+    GLuint shader = 0;
+    const GLMesh* mesh = nullptr;                    // nullptr for generated geometry (orbits)
+    const Simulation::CelestialBody* body = nullptr; // Source body for generated geometry
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 color = glm::vec3(1.0f);
+    float opacity = 1.0f;
+    float highlight = 0.0f;
+    bool isSun = false;
+    int segments = 0;
+};
+
+/// Collects draw commands for a frame and orders them by a 64-bit sort key.
+///
+/// Key layout (most significant bits first):
+///   Opaque:      [63..60 pass][59..48 shader][47..24 mesh][23..0 depth]
+///   Transparent: [63..60 pass][59..36 inverted depth][35..24 shader][23..0 mesh]
+///
+/// Shader and mesh fields hold dense per-frame IDs rather than GL names, so
+/// they never alias. Opaque draws are grouped by state first and then sorted
+/// front-to-back; transparent draws must blend back-to-front, so depth wins
+/// over state there. Equal keys keep submission order.
+class RenderQueue {
+public:
+    /// Reset the queue for a new frame (keeps capacity)
+    void clear();
+
+    /// Add a command; its sort key is computed from pass, shader, mesh and view depth
+    void submit(DrawCommand command, float viewDepth);
+
+    /// Sort all submitted commands by key. Call once per frame before iterating.
+    void sort();
+
+    size_t size() const { return m_order.size(); }
+    bool empty() const { return m_order.empty(); }
+
+    /// Access commands in sorted order (valid after sort())
+    const DrawCommand& operator[](size_t i) const { return m_commands[m_order[i].index]; }
+
+    /// Depth range used for key quantization (matches the camera's clip planes)
+    void setDepthRange(float nearPlane, float farPlane);
+
+    static uint64_t makeKey(RenderPass pass, uint32_t shaderId, uint32_t meshId, uint32_t depthBits);
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t index;
+    };
+
+    uint32_t quantizeDepth(float viewDepth) const;
+
+    /// Dense ID for a GL name, assigned in first-use order and reset by clear()
+    static uint32_t getDenseId(std::vector<uint32_t>& ids, uint32_t& count, GLuint name);
+
+    std::vector<DrawCommand> m_commands;
+    std::vector<SortEntry> m_order;
+    std::vector<uint32_t> m_shaderIds;  // Indexed by program name, 0 = unassigned
+    std::vector<uint32_t> m_meshIds;    // Indexed by vertex array name, 0 = unassigned
+    uint32_t m_shaderCount = 0;
+    uint32_t m_meshCount = 0;
+    float m_nearPlane = 1.0f;
+    float m_farPlane = 1000000.0f;
+};
+
+} // namespace Render
@@ -0,0 +1,80 @@
+#include "RenderTarget.hpp"
+#include "core/Logger.hpp"
+
+namespace Render {
+
+RenderTarget::~RenderTarget() {
+    release();
+}
+
+void RenderTarget::release() {
+    if (m_framebuffer) {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    if (m_colorBuffer) {
+        glDeleteRenderbuffers(1, &m_colorBuffer);
+        m_colorBuffer = 0;
+    }
+    if (m_depthBuffer) {
+        glDeleteRenderbuffers(1, &m_depthBuffer);
+        m_depthBuffer = 0;
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+bool RenderTarget::resize(int width, int height) {
+    if (width <= 0 || height <= 0) return false;
+    if (m_framebuffer && width == m_width && height == m_height) return true;
+
+    release();
+
+    glGenRenderbuffers(1, &m_colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &m_depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    // Preserve the caller's framebuffer (the headless backend renders into its own FBO)
+    GLint previous = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous));
+
+    if (!complete) {
+        LOG_ERROR("RenderTarget", "Offscreen framebuffer ", width, "x", height, " is incomplete");
+        release();
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    LOG_DEBUG("RenderTarget", "Offscreen target resized to ", width, "x", height);
+    return true;
+}
+
+void RenderTarget::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_width, m_height);
+}
+
+void RenderTarget::blitTo(GLuint framebuffer, int width, int height) const {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    // Leave the destination bound for both reading (capture) and drawing (UI)
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+}
+
+} // namespace Render
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <GL/glew.h>
+
+namespace Render {
+
+/// Offscreen color + depth framebuffer used to render the scene below window
+/// resolution. The result is upscaled into the window's framebuffer with blitTo.
+class RenderTarget {
+public:
+    RenderTarget() = default;
+    ~RenderTarget();
+
+    // Non-copyable
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    /// (Re)allocate attachments if the size changed. Returns false if the FBO is incomplete.
+    bool resize(int width, int height);
+
+    /// Bind for drawing and set the viewport to the target size
+    void bind() const;
+
+    /// Linearly upscale the color attachment into `framebuffer` (0 = default framebuffer)
+    void blitTo(GLuint framebuffer, int width, int height) const;
+
+    bool isValid() const { return m_framebuffer != 0; }
+    int getWidth() const { return m_width; }
+    int getHeight() const { return m_height; }
+
+private:
+    void release();
+
+    GLuint m_framebuffer = 0;
+    GLuint m_colorBuffer = 0;
+    GLuint m_depthBuffer = 0;
+    int m_width = 0;
+    int m_height = 0;
+};
+
+} // namespace Render
@@ -53,6 +53,24 @@ GLuint ShaderManager::getShader(const std::string& name) const {
     return 0;
 }
 
+GLuint ShaderManager::loadTransformFeedback(const std::string& name,
+                                             const std::string& vertexPath,
+                                             const std::vector<std::string>& varyings) {
+    auto it = m_shaders.find(name);
+    if (it != m_shaders.end()) {
+        return it->second;
+    }
+    
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, readFile(vertexPath));
+    GLuint program = linkProgram(vertexShader, 0, varyings);
+    glDeleteShader(vertexShader);
+    
+    m_shaders[name] = program;
+    LOG_INFO("ShaderManager", "Loaded transform feedback shader: ", name);
+    
+    return program;
+}
+
 void ShaderManager::useShader(const std::string& name) {
     GLuint program = getShader(name);
     useShader(program);
@@ -105,10 +123,22 @@ GLuint ShaderManager::compileShader(GLenum type, const std::string& source) {
     return shader;
 }
 
-GLuint ShaderManager::linkProgram(GLuint vertexShader, GLuint fragmentShader) {
+GLuint ShaderManager::linkProgram(GLuint vertexShader, GLuint fragmentShader,
+                                  const std::vector<std::string>& feedbackVaryings) {
     GLuint program = glCreateProgram();
     glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
+    if (fragmentShader) {
+        glAttachShader(program, fragmentShader);
+    }
+    
+    // Feedback varyings must be declared before linking
+    if (!feedbackVaryings.empty()) {
+        std::vector<const char*> names;
+        for (const auto& varying : feedbackVaryings) {
+            names.push_back(varying.c_str());
+        }
+        glTransformFeedbackVaryings(program, static_cast<GLsizei>(names.size()), names.data(), GL_INTERLEAVED_ATTRIBS);
+    }
     glLinkProgram(program);
     
     int success;
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <memory>
 #include <GL/glew.h>
 
@@ -23,6 +24,12 @@ public:
                          const std::string& vertexPath,
                          const std::string& fragmentPath);
     
+    /// Load a vertex-only program whose outputs are captured by transform feedback
+    /// (varyings are written interleaved, in the order given)
+    GLuint loadTransformFeedback(const std::string& name,
+                                 const std::string& vertexPath,
+                                 const std::vector<std::string>& varyings);
+    
     /// Get a loaded shader by name
     GLuint getShader(const std::string& name) const;
     
@@ -38,7 +45,8 @@ public:
 
 private:
     GLuint compileShader(GLenum type, const std::string& source);
-    GLuint linkProgram(GLuint vertexShader, GLuint fragmentShader);
+    GLuint linkProgram(GLuint vertexShader, GLuint fragmentShader,
+                       const std::vector<std::string>& feedbackVaryings = {});
     std::string readFile(const std::string& path);
     
     std::unordered_map<std::string, GLuint> m_shaders;
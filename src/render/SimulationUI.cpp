@@ -1,6 +1,9 @@
 #include "SimulationUI.hpp"
+#include "core/FrameArena.hpp"
 #include "imgui.h"
 #include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <string>
 
 namespace Render {
 
@@ -35,6 +38,32 @@ void SimulationUI::renderStatsOverlay(const Core::Time& time) {
             ImGui::SameLine();
             ImGui::TextColored(ImVec4(1, 0, 0, 1), "[PAUSED]");
         }
+        
+        if (m_frameStats.gpuTimingSupported) {
+            ImGui::Separator();
+            ImGui::Text("GPU:  %.2f ms", m_frameStats.gpuTotalMs);
+            for (const auto& pass : m_frameStats.gpuPasses) {
+                ImGui::Text("  %-7s %5.2f ms (max %.2f)", pass.name, pass.avgMs, pass.maxMs);
+            }
+        }
+        
+        if (m_frameStats.particlesTotal > 0) {
+            ImGui::Text("Particles: %zu / %zu", m_frameStats.particlesDrawn, m_frameStats.particlesTotal);
+        }
+        
+        if (m_frameStats.qualityLevel >= 0) {
+            ImGui::Text("Quality: level %d, CPU %.2f ms, scale %.0f%%", m_frameStats.qualityLevel,
+                        m_frameStats.cpuFrameMs, m_frameStats.renderScale * 100.0f);
+        }
+        
+        if (m_frameStats.capturing) {
+            ImGui::Separator();
+            ImGui::TextColored(ImVec4(1, 0.2f, 0.2f, 1), "REC");
+            ImGui::SameLine();
+            ImGui::Text("%llu frames (%llu dropped)",
+                        static_cast<unsigned long long>(m_frameStats.capturedFrames),
+                        static_cast<unsigned long long>(m_frameStats.droppedFrames));
+        }
     }
     ImGui::End();
 }
@@ -48,44 +77,46 @@ void SimulationUI::renderControlPanel(
     ImGui::SetNextWindowSize(ImVec2(300, 0), ImGuiCond_Always);
     if (ImGui::Begin("Simulation Controls", nullptr)) {
         if (ImGui::CollapsingHeader("System Selection", ImGuiTreeNodeFlags_DefaultOpen)) {
-            // Use SystemLoader to get available systems (OCP compliance)
-            auto allSystems = Simulation::SystemLoader::getAvailableSystems();
-            
-            // Split into planetary systems and special events
-            std::vector<std::string> planetSystems;
-            std::vector<std::string> specialEvents;
-            for (const auto& name : allSystems) {
-                if (name == "Black Hole" || name == "Binary Star") {
-                    specialEvents.push_back(name);
-                } else {
-                    planetSystems.push_back(name);
-                }
+            // Background load in progress: the current system keeps running meanwhile
+            if (solarSystem.isLoading()) {
+                std::string overlay = "Loading " + solarSystem.getLoadingSystemName() + "...";
+                ImGui::ProgressBar(solarSystem.getLoadProgress(), ImVec2(-1, 0), overlay.c_str());
             }
-
-            ImGui::TextDisabled("Planetary Systems");
-            ImGui::PushID("Planets");
-            for (const auto& name : planetSystems) {
-                bool isSelected = (solarSystem.getCurrentSystemName() == name);
-                if (ImGui::Selectable(name.c_str(), isSelected)) {
-                    if (callbacks.onSystemSelected) {
-                        callbacks.onSystemSelected(name);
+            
+            // Systems come from the scanned registry, grouped by the category in each file
+            const Simulation::SystemRegistry& registry = solarSystem.getRegistry();
+            float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+            size_t rows = registry.getSystems().size() + registry.getCategories().size();
+            float listHeight = std::min(static_cast<float>(rows), MAX_SYSTEM_LIST_ROWS) * rowHeight + rowHeight * 0.5f;
+            ImGui::BeginChild("SystemList", ImVec2(0, listHeight));
+            for (const auto& category : registry.getCategories()) {
+                ImGui::TextDisabled("%s", category.c_str());
+                ImGui::PushID(category.c_str());
+                for (const auto& info : registry.getSystems()) {
+                    if (info.category != category) continue;
+                    bool isSelected = (solarSystem.getCurrentSystemName() == info.name);
+                    if (ImGui::Selectable(info.name.c_str(), isSelected)) {
+                        if (callbacks.onSystemSelected) {
+                            callbacks.onSystemSelected(info.name);
+                        }
+                    }
+                    if (ImGui::IsItemHovered()) {
+                        ImGui::SetTooltip("%u bodies\n%s", info.bodyCount, info.filePath.c_str());
                     }
                 }
+                ImGui::PopID();
             }
-            ImGui::PopID();
-
+            ImGui::EndChild();
+            
             ImGui::Separator();
-            ImGui::TextDisabled("Special Events");
-            ImGui::PushID("Events");
-            for (const auto& name : specialEvents) {
-                bool isSelected = (solarSystem.getCurrentSystemName() == name);
-                if (ImGui::Selectable(name.c_str(), isSelected)) {
-                    if (callbacks.onSystemSelected) {
-                        callbacks.onSystemSelected(name);
-                    }
-                }
+            const Simulation::SystemCache& cache = solarSystem.getCache();
+            ImGui::TextDisabled("Cached: %zu systems, %.0f / %.0f MB%s", cache.getEntryCount(),
+                                cache.getUsedBytes() / (1024.0 * 1024.0), cache.getBudget() / (1024.0 * 1024.0),
+                                solarSystem.isWarmingCache() ? " (warming)" : "");
+            bool keepPhysics = solarSystem.isKeepPhysicsState();
+            if (ImGui::Checkbox("Resume Cached Physics", &keepPhysics)) {
+                solarSystem.setKeepPhysicsState(keepPhysics);
             }
-            ImGui::PopID();
         }
 
         if (ImGui::CollapsingHeader("Time Controls", ImGuiTreeNodeFlags_DefaultOpen)) {
@@ -107,6 +138,23 @@ void SimulationUI::renderControlPanel(
             if (ImGui::Checkbox("N-Body Gravity (Chaos)", &physicsEnabled)) {
                 solarSystem.setPhysicsEnabled(physicsEnabled);
             }
+            if (physicsEnabled) {
+                ImGui::Checkbox("Show Trails", &m_showTrails);
+                ImGui::SliderInt("Trail Length", &m_trailLength,
+                                 TrailRenderer::MIN_TRAIL_LENGTH, TrailRenderer::MAX_TRAIL_LENGTH,
+                                 "%d samples", ImGuiSliderFlags_Logarithmic);
+            }
+
+            ImGui::Separator();
+            ImGui::Checkbox("Adaptive Quality", &m_adaptiveQuality);
+            if (m_adaptiveQuality) {
+                ImGui::SliderInt("Target FPS", &m_targetFps, 20, 240);
+                ImGui::Checkbox("Allow Resolution Scaling", &m_allowResolutionScaling);
+                if (m_frameStats.qualityLevel >= 0) {
+                    ImGui::Text("Level %d (0 = full quality), scene at %.0f%%",
+                                m_frameStats.qualityLevel, m_frameStats.renderScale * 100.0f);
+                }
+            }
         }
 
         if (solarSystem.getCurrentSystemName() == "Solar System") {
@@ -127,10 +175,42 @@ void SimulationUI::renderControlPanel(
                 eventBtn("Voyager 2 Neptune (1989)", -10.353);
             }
         }
+        
+        if (ImGui::CollapsingHeader("Memory")) {
+            renderMemorySection();
+        }
     }
     ImGui::End();
 }
 
+void SimulationUI::renderMemorySection() {
+    const double MB = 1024.0 * 1024.0;
+    const Core::MemoryReport& report = m_memoryReport;
+    ImGui::Text("Resident: %.0f MB (peak %.0f MB)", report.rssBytes / MB, report.peakRssBytes / MB);
+    if (report.budgetBytes > 0) {
+        bool over = report.peakRssBytes > report.budgetBytes;
+        ImGui::TextColored(over ? ImVec4(1, 0.3f, 0.3f, 1) : ImVec4(0.6f, 0.6f, 0.6f, 1),
+                           "Budget: %.0f MB%s", report.budgetBytes / MB, over ? " (exceeded)" : "");
+    }
+    ImGui::Text("GPU buffers: %.1f MB", report.gpuBufferBytes / MB);
+    ImGui::Text("Pooled body blocks: %.1f MB", report.pooledBodyBytes / MB);
+    
+    if (!Core::AllocationTracker::ENABLED) {
+        ImGui::TextDisabled("Allocation tracking: build with -DSPACE_SIM_ALLOCATION_TRACKING=ON");
+        return;
+    }
+    ImGui::Text("Heap in use: %.1f MB", report.total.liveBytes / MB);
+    ImGui::Separator();
+    ImGui::TextDisabled("%-9s %9s %10s %12s", "", "allocs", "KB/frame", "total MB");
+    for (size_t index = 0; index < report.frame.tags.size(); ++index) {
+        const Core::AllocationCounts& frame = report.frame.tags[index];
+        const Core::AllocationCounts& total = report.total.tags[index];
+        ImGui::Text("%-9s %9llu %10.1f %12.1f",
+                    Core::AllocationTracker::getTagName(static_cast<Core::AllocationTag>(index)),
+                    static_cast<unsigned long long>(frame.allocations), frame.bytes / 1024.0, total.bytes / MB);
+    }
+}
+
 void SimulationUI::renderBodiesPanel(
     Simulation::SolarSystem& solarSystem,
     [[maybe_unused]] const Core::Time& time,
@@ -158,6 +238,8 @@ void SimulationUI::renderBodiesPanel(
             }
         }
 
+        // One label buffer for every moon row, from frame scratch
+        std::pmr::string childLabel(&Core::FrameArena::get());
         auto& bodies = solarSystem.getBodies();
         for (size_t i = 1; i < bodies.size(); ++i) {
             const auto& body = bodies[i];
@@ -171,7 +253,9 @@ void SimulationUI::renderBodiesPanel(
             for (const auto& child : body->getChildren()) {
                 ImGui::PushID(child.get());
                 bool childSelected = (lockedBody == child.get());
-                if (ImGui::Selectable(("  > " + child->getName()).c_str(), childSelected)) {
+                childLabel.assign("  > ");
+                childLabel += child->getName();
+                if (ImGui::Selectable(childLabel.c_str(), childSelected)) {
                     if (callbacks.onBodySelected) {
                         callbacks.onBodySelected(child.get());
                     }
@@ -202,6 +286,8 @@ void SimulationUI::renderHelpButton() {
             ImGui::BulletText("Tab: Camera Mode");
             ImGui::BulletText("Double-Click Planet: Focus");
             ImGui::BulletText("P: Pause | O: Reset View");
+            ImGui::BulletText("F9: Dump GPU Timings");
+            ImGui::BulletText("F12: Start/Stop Frame Capture");
             if (ImGui::Button("Close", ImVec2(-1, 0))) m_showHelp = false;
         }
         ImGui::End();
@@ -217,7 +303,10 @@ void SimulationUI::renderLabels(
     const Simulation::CelestialBody* lockedBody,
     bool showLabels
 ) {
-    if (!showLabels) return;
+    if (!showLabels) {
+        m_labelLayout.clear();
+        return;
+    }
     
     int w, h;
     m_window.getSize(w, h);
@@ -226,8 +315,10 @@ void SimulationUI::renderLabels(
     float sysScale = solarSystem.getSystemScale();
     ImDrawList* drawList = ImGui::GetBackgroundDrawList();
     
-    std::function<void(const Simulation::CelestialBody&, glm::vec3)> drawLabel;
-    drawLabel = [&](const Simulation::CelestialBody& body, glm::vec3 parentPos) {
+    // Project every candidate, then let the layout drop overlaps and enforce the budget
+    m_labelLayout.begin(sw, sh, m_labelBudget);
+    // Recurses through itself rather than a std::function, whose captures would be heap-allocated
+    auto addLabel = [&](auto& self, const Simulation::CelestialBody& body, glm::vec3 parentPos) -> void {
         glm::vec3 worldPos = solarSystem.isPhysicsEnabled() 
             ? (body.getPhysicsPosition() * sysScale) 
             : ((parentPos / sysScale + body.getPosition(simulationTime)) * sysScale);
@@ -237,12 +328,23 @@ void SimulationUI::renderLabels(
         if (clipPos.z > 0 && clipPos.w > 0 && shouldShow) {
             glm::vec3 ndc = glm::vec3(clipPos) / clipPos.w;
             float sx = (ndc.x + 1.0f) * 0.5f * sw, sy = (1.0f - ndc.y) * 0.5f * sh;
-            ImU32 col = (hoveredBody == &body || selectedBody == &body) ? IM_COL32(255, 255, 255, 255) : IM_COL32(200, 200, 200, 150);
-            drawList->AddText(ImVec2(sx + 10, sy - 10), col, body.getName().c_str());
+            if (sx >= 0.0f && sx < sw && sy >= 0.0f && sy < sh) {
+                ImVec2 textSize = ImGui::CalcTextSize(body.getName().c_str());
+                bool highlighted = hoveredBody == &body || selectedBody == &body;
+                m_labelLayout.add(&body, glm::vec2(sx, sy), glm::vec2(textSize.x, textSize.y),
+                                  LabelLayout::bodyPriority(body), highlighted);
+            }
         }
-        for (const auto& child : body.getChildren()) drawLabel(*child, worldPos);
+        for (const auto& child : body.getChildren()) self(self, *child, worldPos);
     };
-    for (const auto& body : solarSystem.getBodies()) drawLabel(*body, glm::vec3(0.0f));
+    for (const auto& body : solarSystem.getBodies()) addLabel(addLabel, *body, glm::vec3(0.0f));
+    m_labelLayout.resolve();
+    
+    for (const auto& label : m_labelLayout.getPlaced()) {
+        bool highlighted = hoveredBody == label.body || selectedBody == label.body;
+        ImU32 col = highlighted ? IM_COL32(255, 255, 255, 255) : IM_COL32(200, 200, 200, 150);
+        drawList->AddText(ImVec2(label.min.x, label.min.y), col, label.body->getName().c_str());
+    }
 }
 
 void SimulationUI::renderBodyTooltip(
@@ -287,4 +389,41 @@ void SimulationUI::renderBodyTooltip(
     ImGui::End();
 }
 
+void SimulationUI::renderParticleTooltip(
+    const Simulation::SolarSystem& solarSystem,
+    const Simulation::ParticleRef& particle,
+    bool hovered,
+    float mouseX, float mouseY,
+    bool uiWantsMouse
+) {
+    if (!particle.isValid() || uiWantsMouse) return;
+    
+    // Picks lag a frame or two, so the population may be gone after a system switch
+    const auto& populations = solarSystem.getPopulations();
+    if (static_cast<size_t>(particle.population) >= populations.size()) return;
+    const Simulation::ParticlePopulation& population = populations[particle.population];
+    std::span<const Simulation::ParticleElements> elements = population.getElements();
+    if (particle.index >= elements.size()) return;
+    const Simulation::ParticleElements& element = elements[particle.index];
+    
+    ImGui::SetNextWindowBgAlpha(0.85f);
+    if (hovered) {
+        ImGui::SetNextWindowPos(ImVec2(mouseX + 20, mouseY + 20), ImGuiCond_Always);
+    } else {
+        ImGui::SetNextWindowPos(ImVec2(10, 100), ImGuiCond_FirstUseEver);
+    }
+    
+    ImGui::Begin("Particle Info", nullptr, ImGuiWindowFlags_Tooltip | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar);
+    ImGui::TextColored(ImVec4(0.4, 0.8, 1.0, 1.0), "%s #%u", population.name.c_str(), particle.index);
+    ImGui::Separator();
+    ImGui::Text("Distance: %.3f AU", element.semiMajorAxis);
+    ImGui::Text("Eccentricity: %.3f", element.eccentricity);
+    ImGui::Text("Inclination: %.1f deg", glm::degrees(element.inclination));
+    ImGui::Text("Period: %.3f Years", element.period);
+    if (hovered) {
+        ImGui::TextColored(ImVec4(0.7, 0.7, 0.7, 1.0), "(Click to select)");
+    }
+    ImGui::End();
+}
+
 } // namespace Render
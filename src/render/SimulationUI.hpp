@@ -1,9 +1,12 @@
 #pragma once
 
 #include "simulation/SolarSystem.hpp"
-#include "simulation/SystemLoader.hpp"
+#include "core/MemoryStats.hpp"
 #include "core/Time.hpp"
 #include "Camera.hpp"
+#include "FrameStats.hpp"
+#include "TrailRenderer.hpp"
+#include "LabelLayout.hpp"
 #include "platform/WindowInterface.hpp"
 #include <functional>
 
@@ -35,7 +38,7 @@ public:
         const UICallbacks& callbacks
     );
     
-    /// Render planet labels as background overlay
+    /// Render planet labels as background overlay, decluttered through LabelLayout
     void renderLabels(
         const Simulation::SolarSystem& solarSystem,
         const Camera& camera,
@@ -55,13 +58,47 @@ public:
         bool uiWantsMouse
     );
     
+    /// Render particle info tooltip (hovered particles follow the cursor)
+    void renderParticleTooltip(
+        const Simulation::SolarSystem& solarSystem,
+        const Simulation::ParticleRef& particle,
+        bool hovered,
+        float mouseX, float mouseY,
+        bool uiWantsMouse
+    );
+    
     // Settings accessors for render options
     void setShowOrbits(bool show) { m_showOrbits = show; }
     bool isShowOrbits() const { return m_showOrbits; }
     void setShowLabels(bool show) { m_showLabels = show; }
     bool isShowLabels() const { return m_showLabels; }
+    bool isShowTrails() const { return m_showTrails; }
+    int getTrailLength() const { return m_trailLength; }
+    
+    // Adaptive quality options
+    bool isAdaptiveQuality() const { return m_adaptiveQuality; }
+    void setAdaptiveQuality(bool enabled) { m_adaptiveQuality = enabled; }
+    int getTargetFps() const { return m_targetFps; }
+    bool isResolutionScalingAllowed() const { return m_allowResolutionScaling; }
+    
+    /// Maximum labels drawn per frame (hovered and selected bodies are always labeled)
+    void setLabelBudget(int budget) { m_labelBudget = budget; }
+    
+    /// Labels placed by the last renderLabels call (empty when labels are hidden)
+    const LabelLayout& getLabelLayout() const { return m_labelLayout; }
+    
+    /// Drop last frame's placed labels (their bodies are gone after a system swap)
+    void clearLabels() { m_labelLayout.clear(); }
+    
+    /// Latest renderer statistics for the stats overlay
+    void setFrameStats(const FrameStats& stats) { m_frameStats = stats; }
+    
+    /// Latest memory figures for the Memory section
+    void setMemoryReport(const Core::MemoryReport& report) { m_memoryReport = report; }
 
 private:
+    static constexpr float MAX_SYSTEM_LIST_ROWS = 14.0f;   // Longer lists scroll
+    
     void renderStatsOverlay(const Core::Time& time);
     void renderControlPanel(
         Simulation::SolarSystem& solarSystem,
@@ -74,12 +111,22 @@ private:
         const Simulation::CelestialBody* lockedBody,
         const UICallbacks& callbacks
     );
+    void renderMemorySection();
     void renderHelpButton();
     
     Platform::WindowInterface& m_window;
     bool m_showOrbits = true;
     bool m_showLabels = true;
+    bool m_showTrails = true;
+    int m_trailLength = TrailRenderer::DEFAULT_TRAIL_LENGTH;
+    bool m_adaptiveQuality = true;
+    int m_targetFps = 60;
+    bool m_allowResolutionScaling = false;
+    int m_labelBudget = 256;
+    LabelLayout m_labelLayout;
     bool m_showHelp = false;
+    FrameStats m_frameStats;
+    Core::MemoryReport m_memoryReport;
 };
 
 } // namespace Render
@@ -0,0 +1,147 @@
+#include "StreamingBuffer.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+
+namespace Render {
+
+StreamingBuffer::StreamingBuffer(GLsizeiptr regionSize) {
+    m_supportsBufferStorage = GLEW_ARB_buffer_storage || GLEW_VERSION_4_4;
+    create(regionSize);
+    LOG_INFO("StreamingBuffer", "Created ", FRAME_REGIONS, " x ", regionSize / 1024, " KB ring (",
+             isPersistent() ? "persistent mapping" : "unsynchronized mapping", ")");
+}
+
+StreamingBuffer::~StreamingBuffer() {
+    destroy();
+}
+
+void StreamingBuffer::create(GLsizeiptr regionSize) {
+    ++m_generation;
+    m_regionSize = regionSize;
+    m_requestedRegionSize = regionSize;
+    m_region = 0;
+    m_head = 0;
+
+    GLsizeiptr totalSize = m_regionSize * FRAME_REGIONS;
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+
+    if (m_supportsBufferStorage) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+        m_persistentPtr = glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags);
+        if (!m_persistentPtr) {
+            LOG_WARN("StreamingBuffer", "Persistent mapping failed, falling back to unsynchronized mapping");
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            glDeleteBuffers(1, &m_buffer);
+            glGenBuffers(1, &m_buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+            m_supportsBufferStorage = false;
+        }
+    }
+
+    if (!m_persistentPtr) {
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void StreamingBuffer::destroy() {
+    for (auto& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (m_buffer) {
+        if (m_persistentPtr) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            m_persistentPtr = nullptr;
+        }
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+    }
+}
+
+void StreamingBuffer::waitForFence(GLsync& fence) {
+    if (!fence) return;
+
+    // Flush on the first wait so the fence is guaranteed to signal
+    GLbitfield waitFlags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (true) {
+        GLenum result = glClientWaitSync(fence, waitFlags, 1000000);  // 1 ms
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED) {
+            break;
+        }
+        waitFlags = 0;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void StreamingBuffer::beginFrame() {
+    // Grow if the previous frame ran out of space (all regions must be idle first)
+    if (m_requestedRegionSize > m_regionSize) {
+        GLsizeiptr newSize = std::max(m_requestedRegionSize, m_regionSize * 2);
+        for (auto& fence : m_fences) {
+            waitForFence(fence);
+        }
+        destroy();
+        create(newSize);
+        LOG_INFO("StreamingBuffer", "Grew region to ", newSize / 1024, " KB");
+        return;
+    }
+
+    m_region = (m_region + 1) % FRAME_REGIONS;
+    m_head = 0;
+    waitForFence(m_fences[m_region]);
+}
+
+StreamingBuffer::Allocation StreamingBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment) {
+    GLintptr regionStart = static_cast<GLintptr>(m_region) * m_regionSize;
+    GLintptr offset = regionStart + m_head;
+    offset = ((offset + alignment - 1) / alignment) * alignment;
+
+    if (offset + size > regionStart + m_regionSize) {
+        m_requestedRegionSize = std::max(m_requestedRegionSize, (offset - regionStart) + size);
+        return {};
+    }
+    m_head = (offset - regionStart) + size;
+
+    Allocation allocation;
+    allocation.buffer = m_buffer;
+    allocation.offset = offset;
+    allocation.size = size;
+
+    if (m_persistentPtr) {
+        allocation.data = static_cast<char*>(m_persistentPtr) + offset;
+    } else {
+        // The fence in beginFrame() already guarantees the GPU is done with this range
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+        allocation.data = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size,
+            GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    return allocation;
+}
+
+void StreamingBuffer::commit(const Allocation& allocation) {
+    if (!allocation || m_persistentPtr) {
+        return;  // Coherent persistent mappings need no explicit flush
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void StreamingBuffer::endFrame() {
+    if (m_fences[m_region]) {
+        glDeleteSync(m_fences[m_region]);
+    }
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+} // namespace Render
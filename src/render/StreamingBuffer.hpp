@@ -0,0 +1,77 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Render {
+
+/// Ring buffer for dynamic per-frame GPU data (orbit points, trails, instance data).
+///
+/// The buffer is split into FRAME_REGIONS regions; each frame writes into the next
+/// region and fences it, so the CPU only waits if the GPU is FRAME_REGIONS frames
+/// behind. Uses a persistent coherent mapping when ARB_buffer_storage is available,
+/// otherwise maps each allocation with GL_MAP_UNSYNCHRONIZED_BIT.
+class StreamingBuffer {
+public:
+    static constexpr int FRAME_REGIONS = 3;
+
+    /// A writable slice of the buffer, valid for the current frame only
+    struct Allocation {
+        void* data = nullptr;    // CPU write pointer
+        GLuint buffer = 0;       // GL buffer name to source from
+        GLintptr offset = 0;     // Byte offset of the slice in the buffer
+        GLsizeiptr size = 0;
+
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    explicit StreamingBuffer(GLsizeiptr regionSize = 4 * 1024 * 1024);
+    ~StreamingBuffer();
+
+    // Non-copyable
+    StreamingBuffer(const StreamingBuffer&) = delete;
+    StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+    /// Advance to the next frame region, waiting on its fence if the GPU still reads it
+    void beginFrame();
+
+    /// Reserve `size` bytes with the offset rounded up to a multiple of `alignment`.
+    /// Returns an empty allocation if the region is exhausted; the region grows
+    /// at the next beginFrame(). Without persistent mapping the slice stays mapped
+    /// until commit(), so commit each allocation before making the next one.
+    Allocation allocate(GLsizeiptr size, GLsizeiptr alignment = 16);
+
+    /// Make written data visible to GL. Call before the draw that reads it.
+    void commit(const Allocation& allocation);
+
+    /// Fence the current region so it is not overwritten while in flight
+    void endFrame();
+
+    GLuint getBuffer() const { return m_buffer; }
+    
+    /// Incremented every time the buffer object is (re)created. GL may reuse the
+    /// deleted name, so cached attribute bindings must key on this, not on getBuffer().
+    uint64_t getGeneration() const { return m_generation; }
+    bool isPersistent() const { return m_persistentPtr != nullptr; }
+    GLsizeiptr getRegionSize() const { return m_regionSize; }
+    size_t getMemoryBytes() const { return static_cast<size_t>(m_regionSize) * FRAME_REGIONS; }
+
+private:
+    void create(GLsizeiptr regionSize);
+    void destroy();
+    void waitForFence(GLsync& fence);
+
+    GLuint m_buffer = 0;
+    uint64_t m_generation = 0;
+    GLsizeiptr m_regionSize = 0;
+    GLsizeiptr m_requestedRegionSize = 0;
+    int m_region = 0;
+    GLsizeiptr m_head = 0;                  // Bytes used in the current region
+    std::array<GLsync, FRAME_REGIONS> m_fences{};
+    void* m_persistentPtr = nullptr;
+    bool m_supportsBufferStorage = false;
+};
+
+} // namespace Render
@@ -0,0 +1,190 @@
+#include "TestParticleSystem.hpp"
+#include "ParticleRenderer.hpp"
+#include "simulation/PhysicsSimulator.hpp"
+#include "core/Logger.hpp"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+
+namespace Render {
+
+namespace {
+    constexpr GLuint ATTRACTOR_BINDING = 0;
+}
+
+TestParticleSystem::TestParticleSystem()
+    : m_softwareRenderer(ParticleRenderer::detectSoftwareRasterizer()) {
+    glGenBuffers(1, &m_attractorBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_attractorBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(AttractorBlock), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    m_attractors.reserve(MAX_ATTRACTORS);
+}
+
+TestParticleSystem::~TestParticleSystem() {
+    release();
+    if (m_attractorBuffer) {
+        glDeleteBuffers(1, &m_attractorBuffer);
+        m_attractorBuffer = 0;
+    }
+}
+
+void TestParticleSystem::release() {
+    for (auto& swarm : m_swarms) {
+        glDeleteVertexArrays(2, swarm.vaos.data());
+        glDeleteBuffers(2, swarm.buffers.data());
+    }
+    m_swarms.clear();
+}
+
+size_t TestParticleSystem::getParticleCount() const {
+    size_t count = 0;
+    for (const auto& swarm : m_swarms) {
+        count += static_cast<size_t>(swarm.count);
+    }
+    return count;
+}
+
+size_t TestParticleSystem::getMemoryBytes() const {
+    return getParticleCount() * 2 * sizeof(Simulation::TestParticleState) + sizeof(AttractorBlock);
+}
+
+void TestParticleSystem::rebuild(const Simulation::SolarSystem& solarSystem) {
+    release();
+
+    const double gravity = solarSystem.getGravityConstant();
+    for (const auto& spec : solarSystem.getTestParticleSwarms()) {
+        if (!spec.parent || spec.count == 0) continue;
+
+        Simulation::TestParticleSwarm sized = spec;
+        if (m_softwareRenderer) {
+            sized.count = std::min(sized.count, SOFTWARE_PARTICLE_BUDGET);
+        }
+
+        // Initial conditions are the only time particle state crosses the bus
+        std::vector<Simulation::TestParticleState> states = Simulation::ParticleGenerator::generateDisk(
+            sized, spec.parent->getPhysicsPosition(), spec.parent->getPhysicsVelocity(),
+            static_cast<float>(gravity * spec.parent->getMass()));
+
+        Swarm swarm;
+        swarm.count = static_cast<GLsizei>(states.size());
+        swarm.center = spec.parent;
+        swarm.captureRadius = spec.captureRadius;
+        swarm.color = spec.color;
+        swarm.pointSize = spec.pointSize;
+        swarm.opacity = spec.opacity;
+
+        const GLsizeiptr bytes = static_cast<GLsizeiptr>(states.size() * sizeof(Simulation::TestParticleState));
+        const GLsizei stride = sizeof(Simulation::TestParticleState);
+        glGenBuffers(2, swarm.buffers.data());
+        glGenVertexArrays(2, swarm.vaos.data());
+        for (int i = 0; i < 2; ++i) {
+            glBindVertexArray(swarm.vaos[i]);
+            glBindBuffer(GL_ARRAY_BUFFER, swarm.buffers[i]);
+            glBufferData(GL_ARRAY_BUFFER, bytes, i == 0 ? states.data() : nullptr, GL_DYNAMIC_COPY);
+            glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)sizeof(glm::vec4));
+            glEnableVertexAttribArray(1);
+        }
+        glBindVertexArray(0);
+
+        LOG_INFO("TestParticleSystem", "Swarm '", spec.name, "': ", swarm.count, " particles around ",
+                 spec.parent->getName());
+        m_swarms.push_back(swarm);
+    }
+}
+
+void TestParticleSystem::queueStep(const Simulation::SolarSystem& solarSystem, float dt) {
+    // Physics resets and system loads invalidate every particle, and the steps
+    // before them; the swarms are rebuilt from the bodies at the next flush
+    if (!m_hasGeneration || solarSystem.getStateGeneration() != m_generation) {
+        m_generation = solarSystem.getStateGeneration();
+        m_hasGeneration = true;
+        m_rebuildPending = true;
+        m_pending.clear();
+        m_pendingCenters.clear();
+    }
+    if (m_rebuildPending || m_swarms.empty()) return;
+
+    PendingStep step{};
+    solarSystem.collectAttractors(m_attractors, MAX_ATTRACTORS);
+    std::copy(m_attractors.begin(), m_attractors.end(), step.attractors.bodies);
+    step.attractors.count = static_cast<GLint>(m_attractors.size());
+    step.firstCenter = m_pendingCenters.size();
+    step.dt = dt;
+    for (const auto& swarm : m_swarms) {
+        m_pendingCenters.push_back(swarm.center->getPhysicsPosition());
+    }
+    m_pending.push_back(step);
+}
+
+void TestParticleSystem::flush(const Simulation::SolarSystem& solarSystem, ShaderManager& shaderManager,
+                               GLuint updateShader) {
+    if (m_rebuildPending) {
+        m_rebuildPending = false;
+        rebuild(solarSystem);
+    }
+    if (m_pending.empty()) return;
+    if (m_swarms.empty() || !updateShader) {
+        m_pending.clear();
+        m_pendingCenters.clear();
+        return;
+    }
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, ATTRACTOR_BINDING, m_attractorBuffer);
+    shaderManager.useShader(updateShader);
+    GLuint blockIndex = glGetUniformBlockIndex(updateShader, "Attractors");
+    if (blockIndex != GL_INVALID_INDEX) {
+        glUniformBlockBinding(updateShader, blockIndex, ATTRACTOR_BINDING);
+    }
+    glUniform1f(shaderManager.getUniformLocation(updateShader, "softeningSq"), Simulation::PhysicsSimulator::SOFTENING_SQ);
+    GLint dtLoc = shaderManager.getUniformLocation(updateShader, "dt");
+    GLint centerLoc = shaderManager.getUniformLocation(updateShader, "captureCenter");
+    GLint radiusLoc = shaderManager.getUniformLocation(updateShader, "captureRadiusSq");
+
+    glEnable(GL_RASTERIZER_DISCARD);
+    for (const PendingStep& step : m_pending) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_attractorBuffer);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(AttractorBlock), &step.attractors);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glUniform1f(dtLoc, step.dt);
+
+        for (size_t i = 0; i < m_swarms.size(); ++i) {
+            Swarm& swarm = m_swarms[i];
+            int next = 1 - swarm.current;
+            glUniform3fv(centerLoc, 1, glm::value_ptr(m_pendingCenters[step.firstCenter + i]));
+            glUniform1f(radiusLoc, swarm.captureRadius * swarm.captureRadius);
+
+            glBindVertexArray(swarm.vaos[swarm.current]);
+            glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, swarm.buffers[next]);
+            glBeginTransformFeedback(GL_POINTS);
+            glDrawArrays(GL_POINTS, 0, swarm.count);
+            glEndTransformFeedback();
+
+            swarm.current = next;
+        }
+    }
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    m_pending.clear();
+    m_pendingCenters.clear();
+}
+
+void TestParticleSystem::draw(ShaderManager& shaderManager, GLuint shader) const {
+    GLint colorLoc = shaderManager.getUniformLocation(shader, "particleColor");
+    GLint opacityLoc = shaderManager.getUniformLocation(shader, "opacity");
+    GLint sizeLoc = shaderManager.getUniformLocation(shader, "pointSize");
+
+    for (const auto& swarm : m_swarms) {
+        glUniform3fv(colorLoc, 1, glm::value_ptr(swarm.color));
+        glUniform1f(opacityLoc, swarm.opacity);
+        glUniform1f(sizeLoc, swarm.pointSize);
+
+        glBindVertexArray(swarm.vaos[swarm.current]);
+        glDrawArrays(GL_POINTS, 0, swarm.count);
+    }
+    glBindVertexArray(0);
+}
+
+} // namespace Render
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ShaderManager.hpp"
+#include "simulation/SolarSystem.hpp"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+
+namespace Render {
+
+/// Integrates massless test-particle swarms on the GPU with transform feedback.
+///
+/// Each swarm's state (position, velocity) lives in two buffers used ping-pong:
+/// a vertex-only pass reads one, applies gravity from the massive bodies and
+/// writes the other through transform feedback with rasterization disabled.
+/// The massive bodies are recorded on the CPU at every physics step and
+/// replayed into a uniform buffer when the next drawn frame dispatches the
+/// queued steps, so frames that are not drawn issue no GPU work. Particle
+/// state is uploaded once at reset and never read back.
+class TestParticleSystem {
+public:
+    /// Must match the Attractors block in swarm_update.vert
+    static constexpr int MAX_ATTRACTORS = 64;
+
+    /// Particles per swarm on software rasterizers (llvmpipe)
+    static constexpr size_t SOFTWARE_PARTICLE_BUDGET = 50000;
+
+    TestParticleSystem();
+    ~TestParticleSystem();
+
+    // Non-copyable
+    TestParticleSystem(const TestParticleSystem&) = delete;
+    TestParticleSystem& operator=(const TestParticleSystem&) = delete;
+
+    /// Record one physics step for every swarm (CPU only; call after each physics step)
+    void queueStep(const Simulation::SolarSystem& solarSystem, float dt);
+
+    /// Rebuild swarms after a reset and dispatch the queued steps (update shader is bound here)
+    void flush(const Simulation::SolarSystem& solarSystem, ShaderManager& shaderManager, GLuint updateShader);
+
+    /// Draw all swarms. The draw shader must be bound with its frame uniforms set.
+    void draw(ShaderManager& shaderManager, GLuint shader) const;
+
+    size_t getParticleCount() const;
+    
+    /// Both ping-pong state buffers of every swarm, plus the attractor block
+    size_t getMemoryBytes() const;
+
+private:
+    struct Swarm {
+        std::array<GLuint, 2> buffers{};
+        std::array<GLuint, 2> vaos{};
+        int current = 0;                // Buffer holding the latest state
+        GLsizei count = 0;
+        const Simulation::CelestialBody* center = nullptr;
+        float captureRadius = 0.0f;
+        glm::vec3 color{1.0f};
+        float pointSize = 1.0f;
+        float opacity = 1.0f;
+    };
+
+    /// std140 layout of the Attractors uniform block
+    struct AttractorBlock {
+        glm::vec4 bodies[MAX_ATTRACTORS];   // xyz = position, w = G * mass
+        GLint count;
+        GLint padding[3];
+    };
+
+    /// Massive bodies and capture centers of one queued step
+    struct PendingStep {
+        AttractorBlock attractors;
+        size_t firstCenter;             // Into m_pendingCenters, one per swarm
+        float dt;
+    };
+
+    /// Recreate swarm buffers from fresh initial conditions
+    void rebuild(const Simulation::SolarSystem& solarSystem);
+    void release();
+
+    std::vector<Swarm> m_swarms;
+    GLuint m_attractorBuffer = 0;
+    std::vector<glm::vec4> m_attractors;
+    std::vector<PendingStep> m_pending;         // Capacity kept between frames
+    std::vector<glm::vec3> m_pendingCenters;
+    bool m_softwareRenderer = false;
+
+    uint64_t m_generation = 0;
+    bool m_hasGeneration = false;
+    bool m_rebuildPending = false;
+};
+
+} // namespace Render
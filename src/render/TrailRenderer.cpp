@@ -0,0 +1,230 @@
+#include "TrailRenderer.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace Render {
+
+namespace {
+
+void collectBodies(std::span<const Simulation::BodyPtr> bodies,
+                   std::vector<const Simulation::CelestialBody*>& out) {
+    for (const auto& body : bodies) {
+        out.push_back(body.get());
+        collectBodies(body->getChildren(), out);
+    }
+}
+
+} // namespace
+
+TrailRenderer::TrailRenderer() {
+    // Instanced draws need a VAO bound even without attributes
+    glGenVertexArrays(1, &m_vao);
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &m_maxTexels);
+}
+
+TrailRenderer::~TrailRenderer() {
+    release();
+    if (m_vao) {
+        glDeleteVertexArrays(1, &m_vao);
+        m_vao = 0;
+    }
+}
+
+void TrailRenderer::setTrailLength(int samples) {
+    m_trailLength = std::clamp(samples, MIN_TRAIL_LENGTH, MAX_TRAIL_LENGTH);
+    // Compared against the clamped size, or a ring at the texel limit would be regrown every frame
+    if (m_bodyCount > 0 && getRingRows(m_bodyCount) > m_capacity) {
+        // History can't be stretched in place; regrow the ring on the next update
+        m_hasGeneration = false;
+    }
+}
+
+void TrailRenderer::clear() {
+    m_head = 0;
+    m_sampleCount = 0;
+}
+
+int TrailRenderer::getRingRows(int bodyCount) const {
+    // A texture buffer is limited in texels, not bytes
+    if (m_maxTexels <= 0 || bodyCount <= 0) return m_trailLength;
+    return static_cast<int>(std::min<GLint>(m_trailLength, m_maxTexels / bodyCount));
+}
+
+void TrailRenderer::rebuild(const Simulation::SolarSystem& solarSystem) {
+    m_bodies.clear();
+    collectBodies(solarSystem.getBodies(), m_bodies);
+
+    int bodyCount = static_cast<int>(m_bodies.size());
+    if (bodyCount != m_bodyCount || m_capacity < getRingRows(bodyCount)) {
+        allocate(bodyCount, m_trailLength);
+    } else {
+        clear();
+    }
+
+    // Colors only change with the body set
+    if (m_bodyCount > 0) {
+        std::vector<uint8_t> colors(static_cast<size_t>(m_bodyCount) * 4);
+        for (int i = 0; i < m_bodyCount; ++i) {
+            glm::vec3 c = glm::clamp(m_bodies[i]->getColor(), 0.0f, 1.0f);
+            colors[i * 4 + 0] = static_cast<uint8_t>(c.x * 255.0f);
+            colors[i * 4 + 1] = static_cast<uint8_t>(c.y * 255.0f);
+            colors[i * 4 + 2] = static_cast<uint8_t>(c.z * 255.0f);
+            colors[i * 4 + 3] = 255;
+        }
+        glBindBuffer(GL_TEXTURE_BUFFER, m_colorBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(colors.size()), colors.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+}
+
+void TrailRenderer::allocate(int bodyCount, int capacity) {
+    release();
+    clear();
+    m_bodyCount = bodyCount;
+    m_capacity = 0;
+    if (bodyCount == 0) return;
+
+    int maxRows = getRingRows(bodyCount);
+    if (capacity > maxRows) {
+        LOG_WARN("TrailRenderer", "Trail length ", capacity, " exceeds texture buffer limit for ",
+                 bodyCount, " bodies, clamping to ", maxRows);
+        capacity = maxRows;
+    }
+    if (capacity < 2) {
+        m_bodyCount = 0;
+        return;
+    }
+    m_capacity = capacity;
+
+    const GLsizeiptr ringBytes = static_cast<GLsizeiptr>(capacity) * bodyCount * sizeof(glm::vec4);
+    glGenBuffers(1, &m_positionBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_positionBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, ringBytes, nullptr, GL_DYNAMIC_DRAW);
+
+    glGenBuffers(1, &m_colorBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_colorBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(bodyCount) * 4, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    glGenTextures(1, &m_positionTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, m_positionTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_positionBuffer);
+
+    glGenTextures(1, &m_colorTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, m_colorTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA8, m_colorBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    m_row.resize(static_cast<size_t>(bodyCount));
+    m_lastRow.resize(static_cast<size_t>(bodyCount));
+
+    LOG_INFO("TrailRenderer", "Trail ring: ", bodyCount, " bodies x ", capacity, " samples (",
+             ringBytes / (1024 * 1024), " MB)");
+}
+
+void TrailRenderer::release() {
+    if (m_positionTexture) {
+        glDeleteTextures(1, &m_positionTexture);
+        m_positionTexture = 0;
+    }
+    if (m_colorTexture) {
+        glDeleteTextures(1, &m_colorTexture);
+        m_colorTexture = 0;
+    }
+    if (m_positionBuffer) {
+        glDeleteBuffers(1, &m_positionBuffer);
+        m_positionBuffer = 0;
+    }
+    if (m_colorBuffer) {
+        glDeleteBuffers(1, &m_colorBuffer);
+        m_colorBuffer = 0;
+    }
+}
+
+void TrailRenderer::releaseRing() {
+    release();
+    clear();
+    m_bodyCount = 0;
+    m_capacity = 0;
+    m_hasGeneration = false;
+    m_bodies.clear();
+    m_row = {};
+    m_lastRow = {};
+}
+
+void TrailRenderer::update(const Simulation::SolarSystem& solarSystem, bool visible) {
+    // Kepler orbits have no history worth keeping, and the ring can be gigabytes
+    if (!solarSystem.isPhysicsEnabled()) {
+        if (m_hasGeneration) releaseRing();
+        return;
+    }
+
+    if (!m_hasGeneration || solarSystem.getStateGeneration() != m_generation) {
+        // A new state invalidates the history; don't reserve a ring nobody looks at
+        if (!visible) {
+            if (m_hasGeneration) releaseRing();
+            return;
+        }
+        m_generation = solarSystem.getStateGeneration();
+        m_hasGeneration = true;
+        rebuild(solarSystem);
+        
+        // Interpolation starts from where the bodies are now
+        m_lastSampleTime = solarSystem.getPhysicsTime();
+        for (int i = 0; i < m_bodyCount; ++i) {
+            m_lastRow[i] = glm::vec4(m_bodies[i]->getPhysicsPosition(), 1.0f);
+        }
+    }
+    if (m_capacity == 0) return;
+
+    // Sampled by simulated time, not per frame, so density is independent of frame rate
+    const double elapsed = solarSystem.getPhysicsTime() - m_lastSampleTime;
+    int due = static_cast<int>(elapsed / SAMPLE_INTERVAL);
+    if (due <= 0) return;
+
+    // After a long stall only the newest ring's worth of samples survives anyway
+    int skipped = std::max(due - m_capacity, 0);
+    const GLsizeiptr rowBytes = static_cast<GLsizeiptr>(m_bodyCount) * sizeof(glm::vec4);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_positionBuffer);
+    for (int sample = skipped + 1; sample <= due; ++sample) {
+        float t = static_cast<float>(sample * SAMPLE_INTERVAL / elapsed);
+        for (int i = 0; i < m_bodyCount; ++i) {
+            m_row[i] = glm::mix(m_lastRow[i], glm::vec4(m_bodies[i]->getPhysicsPosition(), 1.0f), t);
+        }
+        glBufferSubData(GL_TEXTURE_BUFFER, static_cast<GLintptr>(m_head) * rowBytes, rowBytes, m_row.data());
+
+        m_head = (m_head + 1) % m_capacity;
+        m_sampleCount = std::min(m_sampleCount + 1, m_capacity);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // The newest sample is the base for the next interpolation
+    m_lastSampleTime += due * SAMPLE_INTERVAL;
+    std::swap(m_row, m_lastRow);
+}
+
+void TrailRenderer::draw(ShaderManager& shaderManager, GLuint shader) const {
+    int count = std::min(m_sampleCount, m_trailLength);
+    if (count < 2 || m_bodyCount == 0) return;
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, m_positionTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, m_colorTexture);
+    glActiveTexture(GL_TEXTURE0);
+
+    glUniform1i(shaderManager.getUniformLocation(shader, "trailPositions"), 0);
+    glUniform1i(shaderManager.getUniformLocation(shader, "trailColors"), 1);
+    glUniform1i(shaderManager.getUniformLocation(shader, "head"), m_head);
+    glUniform1i(shaderManager.getUniformLocation(shader, "capacity"), m_capacity);
+    glUniform1i(shaderManager.getUniformLocation(shader, "bodyCount"), m_bodyCount);
+    glUniform1i(shaderManager.getUniformLocation(shader, "sampleCount"), count);
+
+    // One strip per body; vertex i is sample (head - count + i)
+    glBindVertexArray(m_vao);
+    glDrawArraysInstanced(GL_LINE_STRIP, 0, count, m_bodyCount);
+    glBindVertexArray(0);
+}
+
+} // namespace Render
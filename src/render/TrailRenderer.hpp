@@ -0,0 +1,94 @@
+#pragma once
+
+#include "ShaderManager.hpp"
+#include "simulation/SolarSystem.hpp"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Render {
+
+/// Fading position trails for N-body mode, kept entirely on the GPU.
+///
+/// Samples are taken every SAMPLE_INTERVAL of simulated time, interpolated
+/// between the positions seen at rendered frames, so trail density does not
+/// depend on the frame rate. Positions live in a texture buffer laid out as
+/// [sample][body] and used as a ring: each sample overwrites one row at the
+/// write head and nothing
+/// else is ever re-uploaded. All trails are drawn with a single instanced
+/// GL_LINE_STRIP whose vertex shader fetches its sample by gl_VertexID offset
+/// from the head, so the CPU never reorders or rebuilds trail geometry.
+class TrailRenderer {
+public:
+    static constexpr int MIN_TRAIL_LENGTH = 16;
+    static constexpr int MAX_TRAIL_LENGTH = 8192;
+    static constexpr int DEFAULT_TRAIL_LENGTH = 512;
+    static constexpr double SAMPLE_INTERVAL = 1.0 / 60.0;   // Simulated time between samples
+
+    TrailRenderer();
+    ~TrailRenderer();
+
+    // Non-copyable
+    TrailRenderer(const TrailRenderer&) = delete;
+    TrailRenderer& operator=(const TrailRenderer&) = delete;
+
+    /// Samples kept per body. Growing past the allocated ring clears the trails.
+    void setTrailLength(int samples);
+    int getTrailLength() const { return m_trailLength; }
+
+    /// Append every sample due since the last update, interpolated up to the
+    /// current physics positions.
+    /// The ring is only reserved in N-body mode once trails are `visible`; after
+    /// that sampling continues while hidden, so toggling trails back on keeps the history.
+    void update(const Simulation::SolarSystem& solarSystem, bool visible);
+
+    /// Draw all trails. The trail shader must be bound with its frame uniforms set.
+    void draw(ShaderManager& shaderManager, GLuint shader) const;
+
+    /// Forget all samples (the ring storage is kept)
+    void clear();
+
+    int getBodyCount() const { return m_bodyCount; }
+    int getSampleCount() const { return m_sampleCount; }
+    
+    /// Position ring plus per-body colors
+    size_t getMemoryBytes() const {
+        return static_cast<size_t>(m_bodyCount) * (static_cast<size_t>(m_capacity) * sizeof(glm::vec4) + 4);
+    }
+
+private:
+    /// Rebuild the body list and size the ring for it
+    void rebuild(const Simulation::SolarSystem& solarSystem);
+    void allocate(int bodyCount, int capacity);
+    void release();
+    
+    /// Free the ring and forget the body list (Kepler mode, or nothing to show yet)
+    void releaseRing();
+    
+    /// Rows the ring should have for bodyCount bodies: the trail length, clamped
+    /// to what a texture buffer can address
+    int getRingRows(int bodyCount) const;
+
+    GLuint m_vao = 0;
+    GLuint m_positionBuffer = 0;
+    GLuint m_positionTexture = 0;
+    GLuint m_colorBuffer = 0;
+    GLuint m_colorTexture = 0;
+
+    int m_trailLength = DEFAULT_TRAIL_LENGTH;
+    int m_capacity = 0;      // Rows allocated in the ring
+    int m_bodyCount = 0;
+    int m_head = 0;          // Next row to write
+    int m_sampleCount = 0;   // Valid rows, up to m_capacity
+    GLint m_maxTexels = 0;
+
+    double m_lastSampleTime = 0.0;   // Physics time of m_lastRow
+    uint64_t m_generation = 0;
+    bool m_hasGeneration = false;
+
+    std::vector<const Simulation::CelestialBody*> m_bodies;
+    std::vector<glm::vec4> m_row;       // Staging for one sample
+    std::vector<glm::vec4> m_lastRow;   // Positions at m_lastSampleTime
+};
+
+} // namespace Render
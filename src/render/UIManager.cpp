@@ -81,7 +81,12 @@ UIManager::UIManager(Platform::WindowInterface& window, void* glContext)
     colors[ImGuiCol_ModalWindowDimBg]       = ImVec4(0.80f, 0.80f, 0.80f, 0.35f);
     
     SDL_Window* sdlWindow = static_cast<SDL_Window*>(window.getNativeHandle());
-    ImGui_ImplSDL3_InitForOpenGL(sdlWindow, glContext);
+    m_headless = (sdlWindow == nullptr);
+    if (!m_headless) {
+        ImGui_ImplSDL3_InitForOpenGL(sdlWindow, glContext);
+    } else {
+        io.IniFilename = nullptr;
+    }
     ImGui_ImplOpenGL3_Init("#version 330");
     
     LOG_INFO("UIManager", "ImGui initialized");
@@ -89,14 +94,24 @@ UIManager::UIManager(Platform::WindowInterface& window, void* glContext)
 
 UIManager::~UIManager() {
     ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplSDL3_Shutdown();
+    if (!m_headless) {
+        ImGui_ImplSDL3_Shutdown();
+    }
     ImGui::DestroyContext();
     LOG_INFO("UIManager", "ImGui shutdown");
 }
 
 void UIManager::beginFrame() {
     ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplSDL3_NewFrame();
+    if (m_headless) {
+        int width, height;
+        m_window.getSize(width, height);
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+        io.DeltaTime = 1.0f / 60.0f;
+    } else {
+        ImGui_ImplSDL3_NewFrame();
+    }
     ImGui::NewFrame();
 }
 
@@ -114,6 +129,7 @@ bool UIManager::wantsMouse() const {
 }
 
 void UIManager::processEvent(const SDL_Event& event) {
+    if (m_headless) return;
     ImGui_ImplSDL3_ProcessEvent(&event);
 }
 
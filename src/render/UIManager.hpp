@@ -35,6 +35,7 @@ public:
 
 private:
     Platform::WindowInterface& m_window;
+    bool m_headless = false;  // No native window: display size and timing are fed manually
 };
 
 } // namespace Render
@@ -0,0 +1,97 @@
+#include "BodyArena.hpp"
+#include <memory>
+#include <mutex>
+#include <new>
+
+namespace Simulation {
+
+namespace {
+
+struct BlockPool {
+    std::mutex mutex;
+    std::vector<void*> blocks;
+};
+
+// Never destroyed, so arenas released during static destruction still find it
+BlockPool& getPool() {
+    static BlockPool* pool = new BlockPool();
+    return *pool;
+}
+
+} // namespace
+
+// The bodies' destructors are deliberately not run: everything they own lives
+// in these blocks
+BodyArena::~BodyArena() {
+    for (const Block& block : m_blocks) {
+        if (block.size != BLOCK_BYTES || !poolBlock(block.data)) {
+            ::operator delete(block.data, block.size);
+        }
+    }
+}
+
+BodyPtr BodyArena::create(std::string_view name, double radius, const glm::vec3& color,
+                          const OrbitalParams& orbitalParams, BodyType type) {
+    void* memory = allocate(sizeof(CelestialBody), alignof(CelestialBody));
+    ++m_bodyCount;
+    return BodyPtr(new (memory) CelestialBody(name, radius, color, orbitalParams, type, this));
+}
+
+void* BodyArena::do_allocate(size_t bytes, size_t alignment) {
+    void* cursor = m_cursor;
+    size_t space = static_cast<size_t>(m_end - m_cursor);
+    if (cursor && std::align(alignment, bytes, cursor, space)) {
+        m_cursor = static_cast<char*>(cursor) + bytes;
+        return cursor;
+    }
+    
+    // Large arrays get a block of their own and leave the current block open
+    if (bytes > MAX_SHARED_BYTES) {
+        return allocateBlock(bytes);
+    }
+    m_cursor = static_cast<char*>(allocateBlock(BLOCK_BYTES));
+    m_end = m_cursor + BLOCK_BYTES;
+    return do_allocate(bytes, alignment);
+}
+
+void* BodyArena::allocateBlock(size_t bytes) {
+    void* data = bytes == BLOCK_BYTES ? takePooledBlock() : nullptr;
+    if (!data) {
+        data = ::operator new(bytes);
+    }
+    m_blocks.push_back(Block{data, bytes});
+    m_reservedBytes += bytes;
+    return data;
+}
+
+void* BodyArena::takePooledBlock() {
+    BlockPool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.blocks.empty()) {
+        return nullptr;
+    }
+    void* data = pool.blocks.back();
+    pool.blocks.pop_back();
+    return data;
+}
+
+size_t BodyArena::getPooledBytes() {
+    BlockPool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    return pool.blocks.size() * BLOCK_BYTES;
+}
+
+bool BodyArena::poolBlock(void* data) {
+    BlockPool& pool = getPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.blocks.size() >= MAX_POOLED_BLOCKS) {
+        return false;
+    }
+    if (pool.blocks.capacity() == 0) {
+        pool.blocks.reserve(MAX_POOLED_BLOCKS);
+    }
+    pool.blocks.push_back(data);
+    return true;
+}
+
+} // namespace Simulation
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CelestialBody.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace Simulation {
+
+/// Monotonic arena that owns every body of one system, including names and
+/// child arrays.
+///
+/// Loading a system of N bodies takes a few fixed-size blocks instead of ~3N
+/// small heap allocations. Destroying the arena returns those blocks
+/// without visiting the bodies, so unloading is independent of the body count
+/// and long sessions that switch systems do not fragment the heap. Bodies are
+/// never freed individually (see ArenaDeleter), so the arena must outlive every
+/// BodyPtr and raw body pointer into it. Not thread-safe: a system is built by
+/// one thread and then handed over with its SystemData.
+class BodyArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t BLOCK_BYTES = 1024 * 1024;
+    static constexpr size_t MAX_SHARED_BYTES = BLOCK_BYTES / 4;    // Larger requests get their own block
+    
+    /// A few standard blocks of destroyed arenas are kept for the next load, so
+    /// small reloads do not fault in fresh pages; the rest go back to the heap
+    static constexpr size_t MAX_POOLED_BLOCKS = 8;
+    
+    BodyArena() = default;
+    ~BodyArena() override;
+    
+    // Non-copyable, non-movable (bodies point into the arena)
+    BodyArena(const BodyArena&) = delete;
+    BodyArena& operator=(const BodyArena&) = delete;
+    
+    BodyPtr create(std::string_view name, double radius, const glm::vec3& color,
+                   const OrbitalParams& orbitalParams, BodyType type = BodyType::Planet);
+    
+    /// Memory held from the heap, including the unused tail of the current block
+    size_t getReservedBytes() const { return m_reservedBytes; }
+    size_t getBlockCount() const { return m_blocks.size(); }
+    size_t getBodyCount() const { return m_bodyCount; }
+    
+    /// Heap held by the block pool for the next load
+    static size_t getPooledBytes();
+    
+private:
+    struct Block {
+        void* data;
+        size_t size;
+    };
+    
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}   // Released with the arena
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+    
+    void* allocateBlock(size_t bytes);
+    
+    /// Process-wide free list of standard blocks (arenas live on loader threads)
+    static void* takePooledBlock();
+    static bool poolBlock(void* data);
+    
+    std::vector<Block> m_blocks;
+    char* m_cursor = nullptr;
+    char* m_end = nullptr;
+    size_t m_reservedBytes = 0;
+    size_t m_bodyCount = 0;
+};
+
+} // namespace Simulation
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "SystemLoader.hpp"
+#include <string>
+#include <string_view>
+
+namespace Simulation {
+
+/// Small-body orbital element catalog layouts
+enum class CatalogFormat {
+    Auto,       // Detect from the file name and contents
+    MpcOrb,     // Minor Planet Center MPCORB.DAT fixed-width records
+    JplTable,   // JPL ELEMENTS.* tables: column spans given by a dashed rule under the header
+    Csv         // Header row plus comma-separated values (e.g. a JPL SBDB query export)
+};
+
+struct CatalogImportOptions {
+    CatalogFormat format = CatalogFormat::Auto;
+    double referenceEpochJd = 2451545.0;    // Simulation t = 0 (J2000.0)
+    size_t maxBodies = 0;                   // 0 = import every record
+    unsigned threadCount = 0;               // 0 = hardware concurrency
+    LoadControl* control = nullptr;         // Cancellation for background loads
+};
+
+/// Imports asteroid and comet element catalogs as children of a system's star.
+///
+/// The file is memory-mapped and split into line-aligned chunks whose records
+/// are parsed into orbital elements on a thread pool; the bodies are then
+/// created on the calling thread in file order, so the result is deterministic.
+/// Mean anomalies are propagated from each record's epoch to the reference
+/// epoch. Parabolic and hyperbolic orbits (e >= 1) cannot be represented by
+/// OrbitModel and are skipped (the import log reports how many).
+class CatalogImporter {
+public:
+    /// Append the catalog's bodies to `system` under its first star (a Sun is
+    /// created if there is none). Returns false if the file cannot be read or
+    /// the import was cancelled.
+    static bool import(const std::string& filePath, SystemData& system,
+                       const CatalogImportOptions& options = {});
+
+    /// Parse "mpc", "jpl", "csv" or "auto"
+    static bool parseFormat(std::string_view name, CatalogFormat& outFormat);
+
+    /// Julian date at 0h of a calendar date (Gregorian, fractional day allowed)
+    static double calendarToJulian(int year, int month, double day);
+
+    /// Julian date of an MPC packed epoch such as "K24AH"; NaN if malformed
+    static double unpackMpcEpoch(std::string_view packed);
+};
+
+} // namespace Simulation
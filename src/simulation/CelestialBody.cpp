@@ -3,23 +3,25 @@
 
 namespace Simulation {
 
-CelestialBody::CelestialBody(const std::string& name, 
+CelestialBody::CelestialBody(std::string_view name, 
                              double radius, 
                              const glm::vec3& color, 
                              const OrbitalParams& orbitalParams,
-                             BodyType type)
-    : m_name(name)
+                             BodyType type,
+                             std::pmr::memory_resource* resource)
+    : m_name(name, resource)
     , m_radius(radius)
     , m_color(color)
     , m_orbitalParams(orbitalParams)
-    , m_type(type) {
+    , m_type(type)
+    , m_children(resource) {
 }
 
 glm::vec3 CelestialBody::getPosition(double time) const {
     return OrbitModel::calculatePosition(m_orbitalParams, time);
 }
 
-void CelestialBody::addChild(std::unique_ptr<CelestialBody> child) {
+void CelestialBody::addChild(BodyPtr child) {
     child->setParent(this);
     m_children.push_back(std::move(child));
 }
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <glm/glm.hpp>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <span>
 
 namespace Simulation {
 
@@ -29,17 +32,23 @@ struct OrbitalParams {
     double argumentPeriapsis;      // Radians (omega)
 };
 
+class CelestialBody;
+class BodyArena;
+
+/// Bodies live in their system's BodyArena and are released with it in one
+/// step, so owning pointers never destroy or free them individually
+struct ArenaDeleter {
+    void operator()(CelestialBody*) const noexcept {}
+};
+using BodyPtr = std::unique_ptr<CelestialBody, ArenaDeleter>;
+
+/// A body, its name and its child array are all allocated from one BodyArena
+/// (see BodyArena::create)
 class CelestialBody {
 public:
-    CelestialBody(const std::string& name, 
-                  double radius, 
-                  const glm::vec3& color, 
-                  const OrbitalParams& orbitalParams,
-                  BodyType type = BodyType::Planet);
-
     glm::vec3 getPosition(double time) const;
 
-    const std::string& getName() const { return m_name; }
+    const std::pmr::string& getName() const { return m_name; }
     double getRadius() const { return m_radius; }
     const glm::vec3& getColor() const { return m_color; }
     const OrbitalParams& getOrbitalParams() const { return m_orbitalParams; }
@@ -58,23 +67,39 @@ public:
     glm::vec3 getPhysicsVelocity() const { return m_physicsVelocity; }
     double getMass() const { return m_mass; }
     
-    void addChild(std::unique_ptr<CelestialBody> child);
-    const std::vector<std::unique_ptr<CelestialBody>>& getChildren() const { return m_children; }
+    void addChild(BodyPtr child);
+    void reserveChildren(size_t count) { m_children.reserve(count); }
+    const std::pmr::vector<BodyPtr>& getChildren() const { return m_children; }
     
     // Recursive position calculation (in AU)
     glm::vec3 getWorldPosition(double time) const;
     
     void setParent(const CelestialBody* parent) { m_parent = parent; }
     const CelestialBody* getParent() const { return m_parent; }
+    
+    /// Precomputed orbit loop relative to the parent (in AU), owned by the
+    /// system's DerivedData. Empty when not cached.
+    void setOrbitPath(std::span<const glm::vec3> path) { m_orbitPath = path; }
+    std::span<const glm::vec3> getOrbitPath() const { return m_orbitPath; }
 
 private:
-    std::string m_name;
+    friend class BodyArena;
+    
+    CelestialBody(std::string_view name, 
+                  double radius, 
+                  const glm::vec3& color, 
+                  const OrbitalParams& orbitalParams,
+                  BodyType type,
+                  std::pmr::memory_resource* resource);
+
+    std::pmr::string m_name;
     double m_radius;
     glm::vec3 m_color;
     OrbitalParams m_orbitalParams;
     BodyType m_type;
-    std::vector<std::unique_ptr<CelestialBody>> m_children;
+    std::pmr::vector<BodyPtr> m_children;
     const CelestialBody* m_parent = nullptr;
+    std::span<const glm::vec3> m_orbitPath;
 
     // Physics State
     glm::vec3 m_physicsPosition = glm::vec3(0.0f);
@@ -0,0 +1,431 @@
+#include "CompiledSystem.hpp"
+#include "core/Logger.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <unordered_map>
+
+namespace Simulation {
+
+namespace {
+
+constexpr uint64_t SECTION_ALIGNMENT = 8;
+constexpr uint32_t PROGRESS_INTERVAL = 4096;   // Bodies between progress reports / cancellation checks
+
+size_t sectionIndex(CompiledSection section) {
+    return static_cast<size_t>(section);
+}
+
+/// Record size and expected record count of each section
+void expectedLayout(const CompiledSystemHeader& header, CompiledSection section,
+                    size_t& recordSize, uint64_t& recordCount) {
+    recordCount = header.bodyCount;
+    switch (section) {
+        case CompiledSection::Parents:          recordSize = sizeof(int32_t); break;
+        case CompiledSection::Types:            recordSize = sizeof(uint8_t); break;
+        case CompiledSection::Color:            recordSize = sizeof(glm::vec3); break;
+        case CompiledSection::NameOffsets:      recordSize = sizeof(uint32_t); break;
+        case CompiledSection::Populations:
+            recordSize = sizeof(CompiledPopulation);
+            recordCount = header.populationCount;
+            break;
+        case CompiledSection::ParticleElements:
+            recordSize = sizeof(ParticleElements);
+            recordCount = header.particleCount;
+            break;
+        case CompiledSection::Swarms:
+            recordSize = sizeof(CompiledSwarm);
+            recordCount = header.swarmCount;
+            break;
+        case CompiledSection::Strings:
+            recordSize = 1;
+            recordCount = 0;    // Variable; checked separately
+            break;
+        default:                                recordSize = sizeof(double); break;
+    }
+}
+
+/// Accumulates sections into one buffer, padding each to SECTION_ALIGNMENT
+class SectionWriter {
+public:
+    explicit SectionWriter(CompiledSystemHeader& header)
+        : m_header(header), m_buffer(sizeof(CompiledSystemHeader), 0) {}
+
+    template <typename T>
+    void add(CompiledSection section, const std::vector<T>& values) {
+        m_buffer.resize((m_buffer.size() + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1), 0);
+        CompiledSectionRange& range = m_header.sections[sectionIndex(section)];
+        range.offset = m_buffer.size();
+        range.size = values.size() * sizeof(T);
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+        m_buffer.insert(m_buffer.end(), bytes, bytes + range.size);
+    }
+
+    std::vector<uint8_t>& finish() {
+        std::memcpy(m_buffer.data(), &m_header, sizeof(CompiledSystemHeader));
+        return m_buffer;
+    }
+
+private:
+    CompiledSystemHeader& m_header;
+    std::vector<uint8_t> m_buffer;
+};
+
+/// Deduplicating string table; offset 0 is the empty string
+class StringTable {
+public:
+    StringTable() : m_data(1, '\0') {}
+
+    uint32_t add(const std::string& value) {
+        if (value.empty()) return 0;
+        auto it = m_offsets.find(value);
+        if (it != m_offsets.end()) return it->second;
+        uint32_t offset = static_cast<uint32_t>(m_data.size());
+        m_data.insert(m_data.end(), value.begin(), value.end());
+        m_data.push_back('\0');
+        m_offsets.emplace(value, offset);
+        return offset;
+    }
+
+    const std::vector<char>& data() const { return m_data; }
+
+private:
+    std::vector<char> m_data;
+    std::unordered_map<std::string, uint32_t> m_offsets;
+};
+
+} // namespace
+
+bool CompiledSystem::open(const std::string& filePath) {
+    m_header = nullptr;
+    if (!m_file.open(filePath)) {
+        return false;
+    }
+    if (!validate(filePath)) {
+        m_file.close();
+        return false;
+    }
+    m_header = reinterpret_cast<const CompiledSystemHeader*>(m_file.data());
+    return true;
+}
+
+bool CompiledSystem::validate(const std::string& filePath) const {
+    if (m_file.size() < sizeof(CompiledSystemHeader)) {
+        LOG_ERROR("CompiledSystem", "File too small for a compiled system: ", filePath);
+        return false;
+    }
+    const auto& header = *reinterpret_cast<const CompiledSystemHeader*>(m_file.data());
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        LOG_ERROR("CompiledSystem", "Not a version ", VERSION, " compiled system: ", filePath);
+        return false;
+    }
+
+    // Every section must lie inside the file, be aligned and hold exactly the counted records
+    for (size_t i = 0; i < sectionIndex(CompiledSection::Count); ++i) {
+        const CompiledSectionRange& range = header.sections[i];
+        size_t recordSize = 0;
+        uint64_t recordCount = 0;
+        expectedLayout(header, static_cast<CompiledSection>(i), recordSize, recordCount);
+
+        bool inBounds = range.offset % SECTION_ALIGNMENT == 0 && range.offset <= m_file.size() &&
+                        range.size <= m_file.size() - range.offset;
+        bool sized = static_cast<CompiledSection>(i) == CompiledSection::Strings
+            ? range.size > 0
+            : range.size == recordCount * recordSize;
+        if (!inBounds || !sized) {
+            LOG_ERROR("CompiledSystem", "Section ", i, " out of bounds or mis-sized in ", filePath);
+            return false;
+        }
+    }
+
+    // Cross-references: strings terminated, names in range, parents before children
+    const CompiledSectionRange& strings = header.sections[sectionIndex(CompiledSection::Strings)];
+    const char* stringData = reinterpret_cast<const char*>(m_file.data() + strings.offset);
+    auto validString = [&](uint32_t offset) { return offset < strings.size; };
+    auto section = [&](CompiledSection id) { return m_file.data() + header.sections[sectionIndex(id)].offset; };
+
+    bool valid = stringData[strings.size - 1] == '\0' && validString(header.nameOffset);
+    const auto* parents = reinterpret_cast<const int32_t*>(section(CompiledSection::Parents));
+    const auto* types = section(CompiledSection::Types);
+    const auto* names = reinterpret_cast<const uint32_t*>(section(CompiledSection::NameOffsets));
+    for (uint32_t i = 0; valid && i < header.bodyCount; ++i) {
+        valid = parents[i] >= -1 && parents[i] < static_cast<int32_t>(i) &&
+                types[i] <= static_cast<uint8_t>(BodyType::Other) && validString(names[i]);
+    }
+    const auto* populations = reinterpret_cast<const CompiledPopulation*>(section(CompiledSection::Populations));
+    for (uint32_t i = 0; valid && i < header.populationCount; ++i) {
+        const CompiledPopulation& pop = populations[i];
+        valid = validString(pop.nameOffset) && pop.parent >= -1 &&
+                pop.parent < static_cast<int32_t>(header.bodyCount) &&
+                pop.firstElement <= header.particleCount &&
+                pop.elementCount <= header.particleCount - pop.firstElement;
+    }
+    const auto* swarms = reinterpret_cast<const CompiledSwarm*>(section(CompiledSection::Swarms));
+    for (uint32_t i = 0; valid && i < header.swarmCount; ++i) {
+        valid = validString(swarms[i].nameOffset) && swarms[i].parent >= -1 &&
+                swarms[i].parent < static_cast<int32_t>(header.bodyCount);
+    }
+    if (!valid) {
+        LOG_ERROR("CompiledSystem", "Corrupt cross-references in ", filePath);
+    }
+    return valid;
+}
+
+bool CompiledSystem::readHeader(const std::string& filePath, CompiledSystemHeader& outHeader,
+                                std::string& outName) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(&outHeader), sizeof(outHeader))) {
+        return false;
+    }
+    if (std::memcmp(outHeader.magic, MAGIC, sizeof(MAGIC)) != 0 || outHeader.version != VERSION) {
+        return false;
+    }
+    
+    const CompiledSectionRange& strings = outHeader.sections[sectionIndex(CompiledSection::Strings)];
+    if (outHeader.nameOffset >= strings.size) {
+        return false;
+    }
+    file.seekg(static_cast<std::streamoff>(strings.offset + outHeader.nameOffset));
+    outName.clear();
+    uint64_t remaining = strings.size - outHeader.nameOffset;
+    char c = 0;
+    while (remaining-- > 0 && file.get(c) && c != '\0') {
+        outName.push_back(c);
+    }
+    return static_cast<bool>(file) && c == '\0';
+}
+
+const char* CompiledSystem::getString(uint32_t offset) const {
+    return getSection<char>(CompiledSection::Strings).data() + offset;
+}
+
+std::unique_ptr<SystemData> CompiledSystem::instantiate(LoadControl* control) const {
+    auto data = std::make_unique<SystemData>();
+    data->name = getString(m_header->nameOffset);
+    data->systemScale = m_header->systemScale;
+    data->planetScale = m_header->planetScale;
+
+    auto parents = getSection<int32_t>(CompiledSection::Parents);
+    auto types = getSection<uint8_t>(CompiledSection::Types);
+    auto semiMajorAxis = getSection<double>(CompiledSection::SemiMajorAxis);
+    auto eccentricity = getSection<double>(CompiledSection::Eccentricity);
+    auto inclination = getSection<double>(CompiledSection::Inclination);
+    auto period = getSection<double>(CompiledSection::Period);
+    auto meanAnomaly = getSection<double>(CompiledSection::MeanAnomaly);
+    auto node = getSection<double>(CompiledSection::LongitudeAscendingNode);
+    auto periapsis = getSection<double>(CompiledSection::ArgumentPeriapsis);
+    auto mass = getSection<double>(CompiledSection::Mass);
+    auto radius = getSection<double>(CompiledSection::Radius);
+    auto color = getSection<glm::vec3>(CompiledSection::Color);
+    auto names = getSection<uint32_t>(CompiledSection::NameOffsets);
+
+    // Size every child array up front, so the arena holds no outgrown copies
+    std::vector<uint32_t> childCounts(m_header->bodyCount, 0);
+    size_t topLevelCount = 0;
+    for (int32_t parent : parents) {
+        if (parent < 0) {
+            ++topLevelCount;
+        } else {
+            ++childCounts[parent];
+        }
+    }
+    data->bodies.reserve(topLevelCount);
+
+    // Depth-first order: each parent already exists when its children are reached
+    std::vector<CelestialBody*> created(m_header->bodyCount, nullptr);
+    for (uint32_t i = 0; i < m_header->bodyCount; ++i) {
+        if (control && i % PROGRESS_INTERVAL == 0) {
+            if (control->isCancelled()) return nullptr;
+            control->report(static_cast<float>(i) / static_cast<float>(m_header->bodyCount));
+        }
+        OrbitalParams orbit{semiMajorAxis[i], eccentricity[i], inclination[i], period[i],
+                            meanAnomaly[i], node[i], periapsis[i]};
+        auto body = data->arena->create(getString(names[i]), radius[i], color[i], orbit,
+                                        static_cast<BodyType>(types[i]));
+        body->setMass(mass[i]);
+        body->reserveChildren(childCounts[i]);
+        created[i] = body.get();
+        if (parents[i] < 0) {
+            data->bodies.push_back(std::move(body));
+        } else {
+            created[parents[i]]->addChild(std::move(body));
+        }
+    }
+
+    auto elements = getSection<ParticleElements>(CompiledSection::ParticleElements);
+    for (const CompiledPopulation& record : getSection<CompiledPopulation>(CompiledSection::Populations)) {
+        ParticlePopulation population;
+        population.name = getString(record.nameOffset);
+        if (record.parent >= 0) {
+            population.parent = created[record.parent];
+            population.parentName = population.parent->getName();
+        }
+        population.color = glm::vec3(record.color[0], record.color[1], record.color[2]);
+        population.pointSize = record.pointSize;
+        population.opacity = record.opacity;
+        population.mappedElements = elements.subspan(record.firstElement, record.elementCount);
+        data->populations.push_back(std::move(population));
+    }
+
+    for (const CompiledSwarm& record : getSection<CompiledSwarm>(CompiledSection::Swarms)) {
+        TestParticleSwarm swarm;
+        swarm.name = getString(record.nameOffset);
+        if (record.parent >= 0) {
+            swarm.parent = created[record.parent];
+            swarm.parentName = swarm.parent->getName();
+        } else if (!data->bodies.empty()) {
+            swarm.parent = data->bodies[0].get();
+        }
+        swarm.count = record.count;
+        swarm.seed = record.seed;
+        swarm.innerRadius = record.innerRadius;
+        swarm.outerRadius = record.outerRadius;
+        swarm.thickness = record.thickness;
+        swarm.captureRadius = record.captureRadius;
+        swarm.color = glm::vec3(record.color[0], record.color[1], record.color[2]);
+        swarm.pointSize = record.pointSize;
+        swarm.opacity = record.opacity;
+        data->testParticles.push_back(std::move(swarm));
+    }
+
+    return data;
+}
+
+bool CompiledSystem::write(const SystemData& data, const std::string& filePath) {
+    StringTable strings;
+    std::vector<int32_t> parents;
+    std::vector<uint8_t> types;
+    std::vector<double> semiMajorAxis, eccentricity, inclination, period, meanAnomaly, node, periapsis;
+    std::vector<double> mass, radius;
+    std::vector<glm::vec3> color;
+    std::vector<uint32_t> names;
+    std::unordered_map<const CelestialBody*, int32_t> indices;
+
+    // Flatten the hierarchy depth-first so parents precede their children
+    std::function<void(const CelestialBody&, int32_t)> flatten = [&](const CelestialBody& body, int32_t parent) {
+        int32_t index = static_cast<int32_t>(parents.size());
+        indices[&body] = index;
+        const OrbitalParams& orbit = body.getOrbitalParams();
+        parents.push_back(parent);
+        types.push_back(static_cast<uint8_t>(body.getType()));
+        semiMajorAxis.push_back(orbit.semiMajorAxis);
+        eccentricity.push_back(orbit.eccentricity);
+        inclination.push_back(orbit.inclination);
+        period.push_back(orbit.orbitalPeriod);
+        meanAnomaly.push_back(orbit.meanAnomaly0);
+        node.push_back(orbit.longitudeAscendingNode);
+        periapsis.push_back(orbit.argumentPeriapsis);
+        mass.push_back(body.getMass());
+        radius.push_back(body.getRadius());
+        color.push_back(body.getColor());
+        names.push_back(strings.add(std::string(body.getName())));
+        for (const auto& child : body.getChildren()) {
+            flatten(*child, index);
+        }
+    };
+    for (const auto& body : data.bodies) {
+        flatten(*body, -1);
+    }
+    auto indexOf = [&](const CelestialBody* body) {
+        auto it = body ? indices.find(body) : indices.end();
+        return it != indices.end() ? it->second : -1;
+    };
+
+    std::vector<CompiledPopulation> populations;
+    std::vector<ParticleElements> elements;
+    for (const ParticlePopulation& population : data.populations) {
+        CompiledPopulation record{};
+        record.nameOffset = strings.add(population.name);
+        record.parent = indexOf(population.parent);
+        record.firstElement = static_cast<uint32_t>(elements.size());
+        std::span<const ParticleElements> source = population.getElements();
+        record.elementCount = static_cast<uint32_t>(source.size());
+        record.color[0] = population.color.x;
+        record.color[1] = population.color.y;
+        record.color[2] = population.color.z;
+        record.pointSize = population.pointSize;
+        record.opacity = population.opacity;
+        populations.push_back(record);
+        elements.insert(elements.end(), source.begin(), source.end());
+    }
+
+    std::vector<CompiledSwarm> swarms;
+    for (const TestParticleSwarm& swarm : data.testParticles) {
+        CompiledSwarm record{};
+        record.nameOffset = strings.add(swarm.name);
+        record.parent = indexOf(swarm.parent);
+        record.count = static_cast<uint32_t>(swarm.count);
+        record.seed = swarm.seed;
+        record.innerRadius = swarm.innerRadius;
+        record.outerRadius = swarm.outerRadius;
+        record.thickness = swarm.thickness;
+        record.captureRadius = swarm.captureRadius;
+        record.color[0] = swarm.color.x;
+        record.color[1] = swarm.color.y;
+        record.color[2] = swarm.color.z;
+        record.pointSize = swarm.pointSize;
+        record.opacity = swarm.opacity;
+        swarms.push_back(record);
+    }
+
+    CompiledSystemHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.bodyCount = static_cast<uint32_t>(parents.size());
+    header.populationCount = static_cast<uint32_t>(populations.size());
+    header.particleCount = static_cast<uint32_t>(elements.size());
+    header.swarmCount = static_cast<uint32_t>(swarms.size());
+    header.nameOffset = strings.add(data.name);
+    header.systemScale = data.systemScale;
+    header.planetScale = data.planetScale;
+
+    SectionWriter writer(header);
+    writer.add(CompiledSection::Parents, parents);
+    writer.add(CompiledSection::Types, types);
+    writer.add(CompiledSection::SemiMajorAxis, semiMajorAxis);
+    writer.add(CompiledSection::Eccentricity, eccentricity);
+    writer.add(CompiledSection::Inclination, inclination);
+    writer.add(CompiledSection::Period, period);
+    writer.add(CompiledSection::MeanAnomaly, meanAnomaly);
+    writer.add(CompiledSection::LongitudeAscendingNode, node);
+    writer.add(CompiledSection::ArgumentPeriapsis, periapsis);
+    writer.add(CompiledSection::Mass, mass);
+    writer.add(CompiledSection::Radius, radius);
+    writer.add(CompiledSection::Color, color);
+    writer.add(CompiledSection::NameOffsets, names);
+    writer.add(CompiledSection::Populations, populations);
+    writer.add(CompiledSection::ParticleElements, elements);
+    writer.add(CompiledSection::Swarms, swarms);
+    writer.add(CompiledSection::Strings, strings.data());
+    const std::vector<uint8_t>& bytes = writer.finish();
+
+    // Unique per writer, so concurrent compiles of one system never share a temporary file
+    std::string tempPath = Core::MappedFile::getTempPath(filePath);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_ERROR("CompiledSystem", "Failed to create compiled system: ", tempPath);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            LOG_ERROR("CompiledSystem", "Failed to write compiled system: ", tempPath);
+            file.close();
+            std::error_code error;
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filePath, error);
+    if (error) {
+        LOG_ERROR("CompiledSystem", "Failed to move ", tempPath, " to ", filePath, ": ", error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+} // namespace Simulation
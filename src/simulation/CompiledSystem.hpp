@@ -0,0 +1,138 @@
+#pragma once
+
+#include "SystemLoader.hpp"
+#include "core/MappedFile.hpp"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace Simulation {
+
+/// Sections of a compiled system file. Per-body sections are structure-of-arrays
+/// in depth-first order, so a body's parent always precedes it.
+enum class CompiledSection : uint32_t {
+    Parents,                // int32 per body, -1 for top-level bodies
+    Types,                  // uint8 BodyType per body
+    SemiMajorAxis,          // double per body (AU)
+    Eccentricity,           // double per body
+    Inclination,            // double per body (radians)
+    Period,                 // double per body (years)
+    MeanAnomaly,            // double per body (radians at t=0)
+    LongitudeAscendingNode, // double per body (radians)
+    ArgumentPeriapsis,      // double per body (radians)
+    Mass,                   // double per body
+    Radius,                 // double per body
+    Color,                  // vec3 per body
+    NameOffsets,            // uint32 string table offset per body
+    Populations,            // CompiledPopulation per population
+    ParticleElements,       // ParticleElements shared by all populations
+    Swarms,                 // CompiledSwarm per test-particle swarm
+    Strings,                // NUL-terminated UTF-8 strings
+    Count
+};
+
+/// Byte range of one section within the file (offsets are 8-byte aligned)
+struct CompiledSectionRange {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+struct CompiledSystemHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t bodyCount;
+    uint32_t populationCount;
+    uint32_t particleCount;
+    uint32_t swarmCount;
+    uint32_t nameOffset;    // System name in the string table
+    float systemScale;
+    float planetScale;
+    uint32_t reserved;
+    CompiledSectionRange sections[static_cast<size_t>(CompiledSection::Count)];
+};
+static_assert(sizeof(CompiledSystemHeader) == 40 + 16 * static_cast<size_t>(CompiledSection::Count),
+              "CompiledSystemHeader must stay tightly packed");
+
+struct CompiledPopulation {
+    uint32_t nameOffset;
+    int32_t parent;         // Body index, -1 for the system origin
+    uint32_t firstElement;  // Range in the ParticleElements section
+    uint32_t elementCount;
+    float color[3];
+    float pointSize;
+    float opacity;
+    uint32_t reserved;
+};
+static_assert(sizeof(CompiledPopulation) == 40, "CompiledPopulation must stay tightly packed");
+
+struct CompiledSwarm {
+    uint32_t nameOffset;
+    int32_t parent;         // Body index, -1 for the first body
+    uint32_t count;
+    uint32_t seed;
+    float innerRadius;
+    float outerRadius;
+    float thickness;
+    float captureRadius;
+    float color[3];
+    float pointSize;
+    float opacity;
+    uint32_t reserved;
+};
+static_assert(sizeof(CompiledSwarm) == 56, "CompiledSwarm must stay tightly packed");
+
+/// Binary compiled system (.ssb), produced from the JSON description by `systemc`.
+///
+/// The file is memory-mapped and its arrays are read in place: opening it only
+/// validates the header and section bounds, with no parsing or per-value copies.
+/// Values are stored in host (little-endian) byte order, already converted to
+/// the units used at runtime (angles in radians, masses resolved).
+class CompiledSystem {
+public:
+    static constexpr char MAGIC[4] = {'S', 'S', 'Y', 'B'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr const char* FILE_EXTENSION = ".ssb";
+
+    /// Map and validate a compiled system. Returns false if the file is missing or malformed.
+    bool open(const std::string& filePath);
+    
+    /// Read just the header and system name without mapping the file (for listings)
+    static bool readHeader(const std::string& filePath, CompiledSystemHeader& outHeader, std::string& outName);
+    bool isOpen() const { return m_header != nullptr; }
+
+    const CompiledSystemHeader& getHeader() const { return *m_header; }
+    uint32_t getBodyCount() const { return m_header->bodyCount; }
+    
+    /// The whole mapped file
+    const uint8_t* getData() const { return m_file.data(); }
+    size_t getSize() const { return m_file.size(); }
+
+    /// Typed view of a section, pointing into the mapping
+    template <typename T>
+    std::span<const T> getSection(CompiledSection section) const {
+        const CompiledSectionRange& range = m_header->sections[static_cast<size_t>(section)];
+        return {reinterpret_cast<const T*>(m_file.data() + range.offset), range.size / sizeof(T)};
+    }
+
+    /// String from the string table (offsets are validated on open)
+    const char* getString(uint32_t offset) const;
+
+    /// Build the runtime bodies, populations and swarms from the mapped arrays.
+    /// Particle elements stay in the mapping, so this file must outlive the
+    /// populations (SystemLoader keeps it in SystemData::compiled).
+    /// Returns nullptr if cancelled through `control`.
+    std::unique_ptr<SystemData> instantiate(LoadControl* control = nullptr) const;
+
+    /// Serialize a loaded system. Written to a temporary file and renamed into
+    /// place, so a concurrent reader never maps a partial file.
+    static bool write(const SystemData& data, const std::string& filePath);
+
+private:
+    bool validate(const std::string& filePath) const;
+
+    Core::MappedFile m_file;
+    const CompiledSystemHeader* m_header = nullptr;
+};
+
+} // namespace Simulation
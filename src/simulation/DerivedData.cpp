@@ -0,0 +1,351 @@
+#include "DerivedData.hpp"
+#include "OrbitModel.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <glm/gtc/constants.hpp>
+
+namespace Simulation {
+
+namespace {
+
+constexpr uint64_t SECTION_ALIGNMENT = 8;
+
+uint64_t alignUp(uint64_t value) {
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+/// Bodies in depth-first order (the order of compiled files and of the blob)
+void flattenBodies(std::span<const BodyPtr> bodies,
+                   std::vector<CelestialBody*>& out) {
+    for (const auto& body : bodies) {
+        out.push_back(body.get());
+        flattenBodies(body->getChildren(), out);
+    }
+}
+
+void samplePath(const OrbitalParams& params, glm::vec3* out) {
+    constexpr uint32_t SEGMENTS = DerivedData::ORBIT_PATH_SEGMENTS;
+    for (uint32_t i = 0; i < SEGMENTS; ++i) {
+        double eccentricAnomaly = (static_cast<double>(i) / SEGMENTS) * 2.0 * glm::pi<double>();
+        out[i] = OrbitModel::positionAtEccentricAnomaly(params, eccentricAnomaly);
+    }
+}
+
+/// Name component that identifies the build of the derivation code
+uint64_t versionedKey(uint64_t contentHash) {
+    uint64_t key = contentHash ^ (DerivedData::CODE_VERSION * 0x9E3779B97F4A7C15ull);
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    return key;
+}
+
+} // namespace
+
+std::span<const glm::vec3> DerivedData::getOrbitPath(size_t bodyIndex) const {
+    if (bodyIndex >= m_header->pathCount) {
+        return {};
+    }
+    const auto* paths = reinterpret_cast<const glm::vec3*>(m_base + m_header->pathsOffset);
+    return {paths + bodyIndex * m_header->pathSegments, m_header->pathSegments};
+}
+
+bool DerivedData::hasPopulation(size_t index) const {
+    return index < m_header->populationCount &&
+           reinterpret_cast<const uint64_t*>(m_base + m_header->populationsOffset)[index] != NO_ELEMENTS;
+}
+
+std::span<const ParticleElements> DerivedData::getPopulationElements(size_t index) const {
+    if (!hasPopulation(index)) {
+        return {};
+    }
+    const auto* counts = reinterpret_cast<const uint64_t*>(m_base + m_header->populationsOffset);
+    const auto* elements = reinterpret_cast<const ParticleElements*>(m_base + m_header->elementsOffset);
+    return {elements + m_populationFirst[index], static_cast<size_t>(counts[index])};
+}
+
+void DerivedData::attachOrbitPaths(std::span<const BodyPtr> bodies) const {
+    std::vector<CelestialBody*> flat;
+    flattenBodies(bodies, flat);
+    for (size_t i = 0; i < flat.size(); ++i) {
+        flat[i]->setOrbitPath(getOrbitPath(i));
+    }
+}
+
+bool DerivedData::bind(const uint8_t* base, size_t size) {
+    m_base = nullptr;
+    m_size = 0;
+    m_header = nullptr;
+    m_populationFirst.clear();
+    if (size < sizeof(DerivedDataHeader)) {
+        return false;
+    }
+    const auto& header = *reinterpret_cast<const DerivedDataHeader*>(base);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.codeVersion != CODE_VERSION ||
+        header.fileSize != size || header.pathSegments != ORBIT_PATH_SEGMENTS ||
+        header.pathCount > header.bodyCount) {
+        return false;
+    }
+
+    // Every section must be aligned and lie inside the blob
+    auto inBounds = [size](uint64_t offset, uint64_t bytes) {
+        return offset % SECTION_ALIGNMENT == 0 && offset <= size && bytes <= size - offset;
+    };
+    uint64_t pathBytes = uint64_t(header.pathCount) * header.pathSegments * sizeof(glm::vec3);
+    if (!inBounds(header.pathsOffset, pathBytes) ||
+        !inBounds(header.populationsOffset, uint64_t(header.populationCount) * sizeof(uint64_t)) ||
+        header.elementCount > size / sizeof(ParticleElements) ||
+        !inBounds(header.elementsOffset, header.elementCount * sizeof(ParticleElements))) {
+        return false;
+    }
+
+    // Population ranges must add up to the element section exactly
+    const auto* counts = reinterpret_cast<const uint64_t*>(base + header.populationsOffset);
+    uint64_t first = 0;
+    m_populationFirst.reserve(header.populationCount);
+    for (uint32_t i = 0; i < header.populationCount; ++i) {
+        m_populationFirst.push_back(first);
+        if (counts[i] == NO_ELEMENTS) continue;
+        if (counts[i] > header.elementCount - first) {
+            m_populationFirst.clear();
+            return false;
+        }
+        first += counts[i];
+    }
+    if (first != header.elementCount) {
+        m_populationFirst.clear();
+        return false;
+    }
+
+    m_base = base;
+    m_size = size;
+    m_header = &header;
+    return true;
+}
+
+uint64_t DerivedDataCache::hashContent(const void* data, size_t size) {
+    // Word-at-a-time multiply/rotate mix; reads ~10 GB/s, so hashing is never
+    // the bottleneck next to the derivations it guards
+    constexpr uint64_t K0 = 0x9E3779B97F4A7C15ull;
+    constexpr uint64_t K1 = 0xC2B2AE3D27D4EB4Full;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = K1 ^ size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = std::rotl(hash ^ (word * K0), 29) * K1;
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        hash = std::rotl(hash ^ (word * K0), 29) * K1;
+    }
+    hash ^= hash >> 32;
+    hash *= K0;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+std::string DerivedDataCache::getBlobPath(const std::string& sourcePath, uint64_t contentHash) {
+    namespace fs = std::filesystem;
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(versionedKey(contentHash)));
+    fs::path source(sourcePath);
+    std::string fileName = source.filename().string() + "." + key + FILE_EXTENSION;
+    return (source.parent_path() / DIRECTORY / fileName).string();
+}
+
+std::shared_ptr<const DerivedData> DerivedDataCache::load(const std::string& sourcePath, uint64_t contentHash) {
+    std::string blobPath = getBlobPath(sourcePath, contentHash);
+    std::error_code error;
+    if (!std::filesystem::exists(blobPath, error)) {
+        return nullptr;
+    }
+
+    auto derived = std::make_shared<DerivedData>();
+    if (!derived->m_file.open(blobPath)) {
+        return nullptr;
+    }
+    if (!derived->bind(derived->m_file.data(), derived->m_file.size()) ||
+        derived->getContentHash() != contentHash) {
+        LOG_WARN("DerivedData", "Ignoring invalid derived data ", blobPath);
+        return nullptr;
+    }
+    return derived;
+}
+
+std::shared_ptr<DerivedData> DerivedDataCache::build(const SystemData& data, uint64_t contentHash,
+                                                     bool includePopulations, LoadControl* control) {
+    std::vector<CelestialBody*> flat;
+    flattenBodies(data.bodies, flat);
+    uint32_t pathCount = static_cast<uint32_t>(std::min<size_t>(flat.size(), DerivedData::MAX_ORBIT_PATHS));
+
+    uint64_t elementCount = 0;
+    for (const ParticlePopulation& population : data.populations) {
+        if (includePopulations && population.generated) {
+            elementCount += population.getElements().size();
+        }
+    }
+
+    DerivedDataHeader header{};
+    std::memcpy(header.magic, DerivedData::MAGIC, sizeof(header.magic));
+    header.codeVersion = DerivedData::CODE_VERSION;
+    header.contentHash = contentHash;
+    header.bodyCount = static_cast<uint32_t>(flat.size());
+    header.pathCount = pathCount;
+    header.pathSegments = DerivedData::ORBIT_PATH_SEGMENTS;
+    header.populationCount = static_cast<uint32_t>(data.populations.size());
+    header.pathsOffset = alignUp(sizeof(DerivedDataHeader));
+    header.populationsOffset = alignUp(header.pathsOffset +
+                                       uint64_t(pathCount) * header.pathSegments * sizeof(glm::vec3));
+    header.elementsOffset = alignUp(header.populationsOffset + header.populationCount * sizeof(uint64_t));
+    header.elementCount = elementCount;
+    header.fileSize = alignUp(header.elementsOffset + elementCount * sizeof(ParticleElements));
+
+    auto derived = std::make_shared<DerivedData>();
+    derived->m_storage.resize(header.fileSize / sizeof(uint64_t));
+    auto* base = reinterpret_cast<uint8_t*>(derived->m_storage.data());
+    std::memcpy(base, &header, sizeof(header));
+
+    auto* paths = reinterpret_cast<glm::vec3*>(base + header.pathsOffset);
+    for (uint32_t i = 0; i < pathCount; ++i) {
+        if (control && i % 256 == 0 && control->isCancelled()) {
+            return nullptr;
+        }
+        samplePath(flat[i]->getOrbitalParams(), paths + size_t(i) * header.pathSegments);
+    }
+
+    auto* counts = reinterpret_cast<uint64_t*>(base + header.populationsOffset);
+    auto* elements = reinterpret_cast<ParticleElements*>(base + header.elementsOffset);
+    for (size_t i = 0; i < data.populations.size(); ++i) {
+        const ParticlePopulation& population = data.populations[i];
+        if (!includePopulations || !population.generated) {
+            counts[i] = DerivedData::NO_ELEMENTS;
+            continue;
+        }
+        std::span<const ParticleElements> source = population.getElements();
+        counts[i] = source.size();
+        std::copy(source.begin(), source.end(), elements);
+        elements += source.size();
+    }
+
+    derived->bind(base, header.fileSize);
+    return derived;
+}
+
+bool DerivedDataCache::store(const std::string& sourcePath, const DerivedData& derived) {
+    namespace fs = std::filesystem;
+    std::string blobPath = getBlobPath(sourcePath, derived.getContentHash());
+    std::error_code error;
+    fs::create_directories(fs::path(blobPath).parent_path(), error);
+    if (error) {
+        LOG_WARN("DerivedData", "Cannot create ", fs::path(blobPath).parent_path().string(), ": ",
+                 error.message());
+        return false;
+    }
+
+    // Written beside the blob and renamed, so a concurrent load never maps half a file;
+    // the name is unique because the warm-cache thread may store the same blob
+    std::string tempPath = Core::MappedFile::getTempPath(blobPath);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_WARN("DerivedData", "Failed to create derived data: ", tempPath);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(derived.m_base), static_cast<std::streamsize>(derived.m_size));
+        if (!file) {
+            LOG_WARN("DerivedData", "Failed to write derived data: ", tempPath);
+            file.close();
+            fs::remove(tempPath, error);
+            return false;
+        }
+    }
+    fs::rename(tempPath, blobPath, error);
+    if (error) {
+        LOG_WARN("DerivedData", "Failed to move ", tempPath, " to ", blobPath, ": ", error.message());
+        fs::remove(tempPath, error);
+        return false;
+    }
+
+    evictStale(sourcePath, blobPath);
+    return true;
+}
+
+void DerivedDataCache::attach(const std::string& sourcePath, uint64_t contentHash,
+                              std::shared_ptr<const DerivedData> cached, SystemData& data,
+                              bool includePopulations, LoadControl* control) {
+    std::vector<CelestialBody*> flat;
+    flattenBodies(data.bodies, flat);
+
+    // Catalogs imported into the system are not covered by the hash, so spot-check
+    // the first point of every cached path (one evaluation instead of a full loop)
+    bool usable = cached && cached->getBodyCount() == flat.size();
+    for (size_t i = 0; usable && i < cached->getHeader().pathCount; ++i) {
+        glm::vec3 expected = OrbitModel::positionAtEccentricAnomaly(flat[i]->getOrbitalParams(), 0.0);
+        usable = std::memcmp(&cached->getOrbitPath(i)[0], &expected, sizeof(expected)) == 0;
+    }
+
+    if (!usable) {
+        auto start = std::chrono::steady_clock::now();
+        auto built = build(data, contentHash, includePopulations, control);
+        if (!built) {
+            return;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        LOG_INFO("DerivedData", "Derived ", built->getHeader().pathCount, " orbit paths and ",
+                 built->getHeader().elementCount, " particles for ", sourcePath, " in ", ms, " ms");
+
+        // Map the stored blob so generated elements are not held twice on the heap
+        cached = built;
+        if (store(sourcePath, *built)) {
+            if (auto mapped = load(sourcePath, contentHash)) {
+                cached = std::move(mapped);
+            }
+        }
+    } else {
+        LOG_DEBUG("DerivedData", "Using cached derived data for ", sourcePath);
+    }
+
+    for (size_t i = 0; i < flat.size(); ++i) {
+        flat[i]->setOrbitPath(cached->getOrbitPath(i));
+    }
+    data.derived = std::move(cached);
+}
+
+void DerivedDataCache::evictStale(const std::string& sourcePath, const std::string& keepPath) {
+    namespace fs = std::filesystem;
+    fs::path source(sourcePath);
+    fs::path directory = fs::path(keepPath).parent_path();
+    std::string sourceName = source.filename().string();
+
+    std::error_code error;
+    std::vector<fs::path> stale;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        const fs::path& path = entry.path();
+        if (path.extension() != FILE_EXTENSION || path == fs::path(keepPath)) continue;
+
+        // "<source file name>.<16 hex digits>.ssd"
+        std::string owner = path.stem().string();
+        size_t dot = owner.rfind('.');
+        if (dot == std::string::npos) continue;
+        owner.resize(dot);
+
+        if (owner == sourceName || !fs::exists(directory.parent_path() / owner, error)) {
+            stale.push_back(path);
+        }
+    }
+    for (const fs::path& path : stale) {
+        fs::remove(path, error);
+        LOG_DEBUG("DerivedData", "Evicted stale derived data ", path.string());
+    }
+}
+
+} // namespace Simulation
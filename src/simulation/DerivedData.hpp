@@ -0,0 +1,113 @@
+#pragma once
+
+#include "SystemLoader.hpp"
+#include "core/MappedFile.hpp"
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Simulation {
+
+/// Layout of a derived-data blob (.ssd). Offsets are 8-byte aligned.
+struct DerivedDataHeader {
+    char magic[4];
+    uint32_t codeVersion;
+    uint64_t contentHash;       // Of the source system file
+    uint32_t bodyCount;         // Bodies in the source system, depth-first
+    uint32_t pathCount;         // Leading bodies that have an orbit path
+    uint32_t pathSegments;
+    uint32_t populationCount;
+    uint64_t pathsOffset;       // vec3[pathCount * pathSegments]
+    uint64_t populationsOffset; // uint64 element count per population (NO_ELEMENTS: not cached)
+    uint64_t elementsOffset;    // ParticleElements of the cached populations, back to back
+    uint64_t elementCount;
+    uint64_t fileSize;
+};
+static_assert(sizeof(DerivedDataHeader) == 72, "DerivedDataHeader must stay tightly packed");
+
+/// Data computed from a system's elements rather than stored in its file:
+/// orbit polylines for the renderer and particles generated from seeded
+/// distributions. Either mapped from the cache (read in place) or built in
+/// memory with the same layout.
+class DerivedData {
+public:
+    static constexpr char MAGIC[4] = {'S', 'S', 'D', 'D'};
+    static constexpr uint32_t CODE_VERSION = 1;     // Bump whenever anything derived changes
+    static constexpr uint32_t ORBIT_PATH_SEGMENTS = 256;
+    static constexpr uint32_t MAX_ORBIT_PATHS = 4096;    // Later bodies fall back to per-frame paths
+    static constexpr uint64_t NO_ELEMENTS = ~0ull;
+
+    const DerivedDataHeader& getHeader() const { return *m_header; }
+    uint64_t getContentHash() const { return m_header->contentHash; }
+    uint32_t getBodyCount() const { return m_header->bodyCount; }
+
+    /// Orbit loop of the depth-first body `bodyIndex`, sampled uniformly in eccentric anomaly
+    std::span<const glm::vec3> getOrbitPath(size_t bodyIndex) const;
+
+    bool hasPopulation(size_t index) const;
+    std::span<const ParticleElements> getPopulationElements(size_t index) const;
+
+    /// Point each body (depth-first) at its orbit path
+    void attachOrbitPaths(std::span<const BodyPtr> bodies) const;
+
+    bool isMapped() const { return m_file.isOpen(); }
+    size_t getSizeBytes() const { return m_size; }
+
+    /// Heap memory held (mapped blobs live in the page cache)
+    size_t getHeapBytes() const { return m_storage.size() * sizeof(uint64_t); }
+
+private:
+    friend class DerivedDataCache;
+
+    /// Validate the blob at m_base and index its populations
+    bool bind(const uint8_t* base, size_t size);
+
+    Core::MappedFile m_file;
+    std::vector<uint64_t> m_storage;    // In-memory blob (8-byte aligned words)
+    const uint8_t* m_base = nullptr;
+    size_t m_size = 0;
+    const DerivedDataHeader* m_header = nullptr;
+    std::vector<uint64_t> m_populationFirst;   // First element of each cached population
+};
+
+/// Content-addressed on-disk cache of DerivedData.
+///
+/// Blobs live in a `.derived` directory beside the system file, named after the
+/// file and a hash of its bytes mixed with DerivedData::CODE_VERSION. Editing the
+/// file or changing the derivation code changes the name. Whenever a blob is
+/// written, older blobs for the same file and blobs whose file is gone are deleted.
+class DerivedDataCache {
+public:
+    static constexpr const char* DIRECTORY = ".derived";
+    static constexpr const char* FILE_EXTENSION = ".ssd";
+
+    /// Fast 64-bit content hash (not cryptographic)
+    static uint64_t hashContent(const void* data, size_t size);
+
+    static std::string getBlobPath(const std::string& sourcePath, uint64_t contentHash);
+
+    /// Map the blob for this content, or nullptr if missing or invalid
+    static std::shared_ptr<const DerivedData> load(const std::string& sourcePath, uint64_t contentHash);
+
+    /// Compute the derived data of a loaded system. Populations are included
+    /// only when requested (compiled files already store their elements).
+    /// Returns nullptr if cancelled through `control`.
+    static std::shared_ptr<DerivedData> build(const SystemData& data, uint64_t contentHash,
+                                              bool includePopulations, LoadControl* control = nullptr);
+
+    /// Write a blob (temporary file, then rename) and evict stale ones
+    static bool store(const std::string& sourcePath, const DerivedData& derived);
+
+    /// Use `cached` if it fits `data`, otherwise build, store and map a fresh
+    /// blob; then attach it to the bodies and to data.derived
+    static void attach(const std::string& sourcePath, uint64_t contentHash,
+                       std::shared_ptr<const DerivedData> cached, SystemData& data,
+                       bool includePopulations, LoadControl* control = nullptr);
+
+private:
+    static void evictStale(const std::string& sourcePath, const std::string& keepPath);
+};
+
+} // namespace Simulation
@@ -30,6 +30,14 @@ glm::vec3 OrbitModel::calculatePosition(const OrbitalParams& params, double time
         if (std::abs(dE) < 1e-8) break;
     }
 
+    return positionAtEccentricAnomaly(params, E);
+}
+
+glm::vec3 OrbitModel::positionAtEccentricAnomaly(const OrbitalParams& params, double E) {
+    if (params.semiMajorAxis == 0.0 || params.orbitalPeriod == 0.0) {
+        return glm::vec3(0.0f);
+    }
+
     // Calculate true anomaly (v)
     // tan(v/2) = sqrt((1+e)/(1-e)) * tan(E/2)
     double sqrtTerm = std::sqrt((1.0 + params.eccentricity) / (1.0 - params.eccentricity));
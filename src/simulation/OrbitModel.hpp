@@ -9,6 +9,10 @@ class OrbitModel {
 public:
     // Returns position in 3D space given orbital parameters and time
     static glm::vec3 calculatePosition(const OrbitalParams& params, double time);
+    
+    // Position at a given eccentric anomaly (closed form, no Kepler solve);
+    // sampling E uniformly traces the orbit ellipse
+    static glm::vec3 positionAtEccentricAnomaly(const OrbitalParams& params, double eccentricAnomaly);
 };
 
 } // namespace Simulation
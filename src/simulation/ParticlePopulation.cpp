@@ -0,0 +1,123 @@
+#include "ParticlePopulation.hpp"
+#include "core/Logger.hpp"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+
+namespace Simulation {
+
+namespace {
+    constexpr char FILE_MAGIC[4] = {'S', 'S', 'P', 'P'};
+    constexpr uint32_t MAX_FILE_PARTICLES = 64u * 1024u * 1024u;
+}
+
+std::vector<ParticleElements> ParticleGenerator::generate(const ParticleDistribution& distribution,
+                                                          size_t count, uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto sample = [&rng](const ParticleRange& range) {
+        if (range.max <= range.min) return range.min;
+        return std::uniform_real_distribution<float>(range.min, range.max)(rng);
+    };
+
+    const float toRadians = glm::pi<float>() / 180.0f;
+    // Kepler's third law in AU / years / solar masses: P^2 = a^3 / M
+    const double periodScale = 1.0 / std::sqrt(distribution.centralMass > 0.0 ? distribution.centralMass : 1.0);
+
+    std::vector<ParticleElements> elements(count);
+    for (ParticleElements& p : elements) {
+        p.semiMajorAxis = sample(distribution.semiMajorAxis);
+        p.eccentricity = std::min(sample(distribution.eccentricity), 0.99f);
+        p.inclination = sample(distribution.inclination) * toRadians;
+        p.longitudeAscendingNode = sample(distribution.longitudeAscendingNode) * toRadians;
+        p.argumentPeriapsis = sample(distribution.argumentPeriapsis) * toRadians;
+        p.meanAnomaly0 = sample(distribution.meanAnomaly) * toRadians;
+        p.size = sample(distribution.size);
+
+        double a = static_cast<double>(p.semiMajorAxis);
+        p.period = static_cast<float>(std::sqrt(a * a * a) * periodScale);
+    }
+    return elements;
+}
+
+std::vector<TestParticleState> ParticleGenerator::generateDisk(const TestParticleSwarm& swarm,
+                                                               const glm::vec3& centerPosition,
+                                                               const glm::vec3& centerVelocity,
+                                                               float centerGM) {
+    std::mt19937 rng(swarm.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> height(0.0f, std::max(swarm.thickness, 1e-6f));
+
+    const float inner = std::max(swarm.innerRadius, 1e-3f);
+    const float outer = std::max(swarm.outerRadius, inner);
+    const float twoPi = 2.0f * glm::pi<float>();
+
+    std::vector<TestParticleState> states(swarm.count);
+    for (TestParticleState& s : states) {
+        // Uniform over the annulus area
+        float r = std::sqrt(inner * inner + unit(rng) * (outer * outer - inner * inner));
+        float theta = unit(rng) * twoPi;
+        float c = std::cos(theta);
+        float sn = std::sin(theta);
+
+        // Circular speed, prograde like the Kepler orbits (counter-clockwise about +Y)
+        float speed = std::sqrt(centerGM / r);
+        s.position = glm::vec4(centerPosition + glm::vec3(r * c, height(rng), r * sn), 1.0f);
+        s.velocity = glm::vec4(centerVelocity + glm::vec3(-sn, 0.0f, c) * speed, 0.0f);
+    }
+    return states;
+}
+
+bool ParticleGenerator::loadFile(const std::string& filePath, std::vector<ParticleElements>& outElements) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("ParticleGenerator", "Failed to open particle file: ", filePath);
+        return false;
+    }
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    uint32_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 || version != FILE_VERSION) {
+        LOG_ERROR("ParticleGenerator", "Not a version ", FILE_VERSION, " particle file: ", filePath);
+        return false;
+    }
+    if (count > MAX_FILE_PARTICLES) {
+        LOG_ERROR("ParticleGenerator", "Particle file ", filePath, " claims ", count, " particles");
+        return false;
+    }
+
+    outElements.resize(count);
+    file.read(reinterpret_cast<char*>(outElements.data()),
+              static_cast<std::streamsize>(count * sizeof(ParticleElements)));
+    if (!file) {
+        LOG_ERROR("ParticleGenerator", "Particle file truncated: ", filePath);
+        outElements.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ParticleGenerator::saveFile(const std::string& filePath, const std::vector<ParticleElements>& elements) {
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("ParticleGenerator", "Failed to create particle file: ", filePath);
+        return false;
+    }
+
+    uint32_t version = FILE_VERSION;
+    uint32_t count = static_cast<uint32_t>(elements.size());
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(elements.data()),
+               static_cast<std::streamsize>(elements.size() * sizeof(ParticleElements)));
+    return static_cast<bool>(file);
+}
+
+} // namespace Simulation
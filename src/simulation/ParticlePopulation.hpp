@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CelestialBody.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Simulation {
+
+/// Packed Keplerian elements for one particle, laid out for direct GPU upload.
+/// Angles are in radians, distances in AU, periods in years.
+struct ParticleElements {
+    float semiMajorAxis = 1.0f;
+    float eccentricity = 0.0f;
+    float inclination = 0.0f;
+    float period = 1.0f;
+    float meanAnomaly0 = 0.0f;
+    float longitudeAscendingNode = 0.0f;
+    float argumentPeriapsis = 0.0f;
+    float size = 1.0f;              // Point size multiplier
+};
+static_assert(sizeof(ParticleElements) == 32, "ParticleElements must stay tightly packed");
+
+/// Inclusive [min, max] range sampled uniformly
+struct ParticleRange {
+    float min = 0.0f;
+    float max = 0.0f;
+};
+
+/// Orbital-element distribution for generated populations (angles in degrees)
+struct ParticleDistribution {
+    ParticleRange semiMajorAxis{2.1f, 3.3f};
+    ParticleRange eccentricity{0.0f, 0.1f};
+    ParticleRange inclination{0.0f, 10.0f};
+    ParticleRange longitudeAscendingNode{0.0f, 360.0f};
+    ParticleRange argumentPeriapsis{0.0f, 360.0f};
+    ParticleRange meanAnomaly{0.0f, 360.0f};
+    ParticleRange size{1.0f, 1.0f};
+    double centralMass = 1.0;       // Solar masses; sets periods via Kepler's third law
+};
+
+/// A large group of massless particles (asteroid belt, planetary ring) that
+/// only exist on the GPU - no CelestialBody, name or physics state per particle.
+struct ParticlePopulation {
+    std::string name;
+    std::string parentName;                   // Empty: orbit the system origin
+    const CelestialBody* parent = nullptr;    // Resolved from parentName at load time
+    glm::vec3 color{0.6f, 0.55f, 0.5f};
+    float pointSize = 1.5f;
+    float opacity = 0.6f;
+    bool generated = false;                   // Sampled from a distribution (cached as derived data)
+    std::vector<ParticleElements> elements;   // Owned elements (empty when mapped)
+    std::span<const ParticleElements> mappedElements;   // Read in place from SystemData::compiled
+
+    std::span<const ParticleElements> getElements() const {
+        return mappedElements.empty() ? std::span<const ParticleElements>(elements) : mappedElements;
+    }
+};
+
+/// One particle of a population, as picked, hovered or selected
+struct ParticleRef {
+    int population = -1;      // Index into SolarSystem::getPopulations(), -1 for none
+    uint32_t index = 0;       // Element index within the population
+
+    bool isValid() const { return population >= 0; }
+    bool operator==(const ParticleRef& other) const = default;
+};
+
+/// State of one test particle as stored on the GPU (position.w is 1 while alive)
+struct TestParticleState {
+    glm::vec4 position{0.0f, 0.0f, 0.0f, 1.0f};
+    glm::vec4 velocity{0.0f};
+};
+static_assert(sizeof(TestParticleState) == 32, "TestParticleState must stay tightly packed");
+
+/// Massless particles integrated under the gravity of the massive bodies
+/// in N-body mode (accretion disks, debris swarms)
+struct TestParticleSwarm {
+    std::string name;
+    std::string parentName;                   // Disk center; empty = first body
+    const CelestialBody* parent = nullptr;
+    size_t count = 100000;
+    uint32_t seed = 1;
+    float innerRadius = 2.0f;
+    float outerRadius = 20.0f;
+    float thickness = 0.2f;                   // Vertical scatter of the disk
+    float captureRadius = 0.5f;               // Particles this close to the center are absorbed
+    glm::vec3 color{1.0f, 0.6f, 0.2f};
+    float pointSize = 1.5f;
+    float opacity = 0.4f;
+};
+
+/// Creates and serializes particle element sets
+class ParticleGenerator {
+public:
+    /// Sample `count` particles from a distribution (deterministic for a given seed).
+    /// Element order is random, so any prefix is an unbiased subsample.
+    static std::vector<ParticleElements> generate(const ParticleDistribution& distribution,
+                                                  size_t count, uint32_t seed);
+
+    /// Binary population file: "SSPP", uint32 version (1), uint32 count,
+    /// then `count` little-endian ParticleElements records.
+    /// Returns false if the file is missing or malformed.
+    static bool loadFile(const std::string& filePath, std::vector<ParticleElements>& outElements);
+    static bool saveFile(const std::string& filePath, const std::vector<ParticleElements>& elements);
+
+    /// Initial states for a swarm: a disk in the XZ plane around the center on
+    /// circular orbits, given the center's physics state and G * mass
+    static std::vector<TestParticleState> generateDisk(const TestParticleSwarm& swarm,
+                                                       const glm::vec3& centerPosition,
+                                                       const glm::vec3& centerVelocity,
+                                                       float centerGM);
+
+    static constexpr uint32_t FILE_VERSION = 1;
+};
+
+} // namespace Simulation
@@ -1,4 +1,6 @@
 #include "PhysicsSimulator.hpp"
+#include "core/FrameArena.hpp"
+#include <algorithm>
 #include <cmath>
 #include <functional>
 
@@ -7,22 +9,36 @@ namespace Simulation {
 PhysicsSimulator::PhysicsSimulator() {
 }
 
-void PhysicsSimulator::collectBodies(std::vector<std::unique_ptr<CelestialBody>>& bodies, 
-                                      std::vector<CelestialBody*>& outBodies) {
-    std::function<void(CelestialBody*)> collect;
-    collect = [&](CelestialBody* b) {
-        outBodies.push_back(b);
-        for (auto& child : b->getChildren()) {
-            collect(child.get());
-        }
-    };
+void PhysicsSimulator::collectBodies(std::span<const BodyPtr> bodies, 
+                                      std::pmr::vector<CelestialBody*>& outBodies) {
+    for (const auto& b : bodies) {
+        outBodies.push_back(b.get());
+        collectBodies(b->getChildren(), outBodies);
+    }
+}
+
+void PhysicsSimulator::appendAttractors(std::span<const BodyPtr> bodies,
+                                        std::vector<glm::vec4>& outAttractors) const {
+    for (const auto& b : bodies) {
+        outAttractors.emplace_back(b->getPhysicsPosition(), static_cast<float>(m_gravityConstant * b->getMass()));
+        appendAttractors(b->getChildren(), outAttractors);
+    }
+}
+
+void PhysicsSimulator::collectAttractors(std::span<const BodyPtr> bodies,
+                                         std::vector<glm::vec4>& outAttractors, size_t maxCount) const {
+    outAttractors.clear();
+    appendAttractors(bodies, outAttractors);
     
-    for (auto& b : bodies) {
-        collect(b.get());
+    // Keep the heaviest bodies; the rest barely perturb massless particles
+    if (outAttractors.size() > maxCount) {
+        std::partial_sort(outAttractors.begin(), outAttractors.begin() + maxCount, outAttractors.end(),
+                          [](const glm::vec4& a, const glm::vec4& b) { return a.w > b.w; });
+        outAttractors.resize(maxCount);
     }
 }
 
-void PhysicsSimulator::initializeFromOrbits(std::vector<std::unique_ptr<CelestialBody>>& bodies, double time) {
+void PhysicsSimulator::initializeFromOrbits(std::span<const BodyPtr> bodies, double time) {
     std::function<void(CelestialBody&, glm::vec3, glm::vec3)> initBody;
     initBody = [&](CelestialBody& body, glm::vec3 parentPos, glm::vec3 parentVel) {
         glm::vec3 localPos = body.getPosition(time);
@@ -56,21 +72,20 @@ void PhysicsSimulator::initializeFromOrbits(std::vector<std::unique_ptr<Celestia
     }
 }
 
-void PhysicsSimulator::update(std::vector<std::unique_ptr<CelestialBody>>& bodies, double dt) {
-    // Collect all bodies into a flat vector
-    std::vector<CelestialBody*> allBodies;
+void PhysicsSimulator::update(std::span<const BodyPtr> bodies, double dt) {
+    // Collect all bodies into a flat vector (scratch for this frame, runs several times per frame)
+    std::pmr::memory_resource* scratch = &Core::FrameArena::get();
+    std::pmr::vector<CelestialBody*> allBodies(scratch);
     collectBodies(bodies, allBodies);
 
     // 1. Compute accelerations (gravitational forces)
-    std::vector<glm::vec3> accelerations(allBodies.size(), glm::vec3(0.0f));
+    std::pmr::vector<glm::vec3> accelerations(allBodies.size(), glm::vec3(0.0f), scratch);
     for (size_t i = 0; i < allBodies.size(); ++i) {
         for (size_t j = i + 1; j < allBodies.size(); ++j) {
             glm::vec3 rVec = allBodies[j]->getPhysicsPosition() - allBodies[i]->getPhysicsPosition();
             float distSq = glm::dot(rVec, rVec);
             
-            // Softening factor prevents infinite forces at near-zero distances
-            const float softeningSq = 0.001f;
-            float forceMag = static_cast<float>(m_gravityConstant / (distSq + softeningSq));
+            float forceMag = static_cast<float>(m_gravityConstant / (distSq + SOFTENING_SQ));
             
             float dist = std::sqrt(distSq);
             if (dist < 0.0001f) continue;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "CelestialBody.hpp"
+#include <glm/glm.hpp>
+#include <memory_resource>
 #include <vector>
 
 namespace Simulation {
@@ -9,13 +11,22 @@ namespace Simulation {
 /// Extracted from SolarSystem to follow Single Responsibility Principle
 class PhysicsSimulator {
 public:
+    /// Softening factor (squared distance) that prevents infinite forces at near-zero distances
+    static constexpr float SOFTENING_SQ = 0.001f;
+    
     PhysicsSimulator();
     
     /// Initialize physics state from orbital positions
-    void initializeFromOrbits(std::vector<std::unique_ptr<CelestialBody>>& bodies, double time);
+    void initializeFromOrbits(std::span<const BodyPtr> bodies, double time);
+    
+    /// Update physics simulation (one step). Scratch comes from the frame arena,
+    /// so this must run on the main thread
+    void update(std::span<const BodyPtr> bodies, double dt);
     
-    /// Update physics simulation (one step)
-    void update(std::vector<std::unique_ptr<CelestialBody>>& bodies, double dt);
+    /// Collect up to maxCount of the heaviest bodies as (position, G * mass),
+    /// for integrators that need only the massive bodies (e.g. GPU test particles)
+    void collectAttractors(std::span<const BodyPtr> bodies,
+                           std::vector<glm::vec4>& outAttractors, size_t maxCount) const;
     
     /// Set the gravitational constant
     void setGravityConstant(double g) { m_gravityConstant = g; }
@@ -23,8 +34,11 @@ public:
 
 private:
     /// Collect all bodies (including children) into a flat list
-    void collectBodies(std::vector<std::unique_ptr<CelestialBody>>& bodies, 
-                       std::vector<CelestialBody*>& outBodies);
+    void collectBodies(std::span<const BodyPtr> bodies, 
+                       std::pmr::vector<CelestialBody*>& outBodies);
+    
+    void appendAttractors(std::span<const BodyPtr> bodies,
+                          std::vector<glm::vec4>& outAttractors) const;
     
     double m_gravityConstant = 0.0001;  // Tuned for the visual scale
 };
@@ -8,30 +8,215 @@ SolarSystem::SolarSystem()
     : m_physicsSimulator(std::make_unique<PhysicsSimulator>()) {
 }
 
-void SolarSystem::init() {
-    loadSystem("Solar System");
+void SolarSystem::init(const std::string& systemName) {
+    m_registry.scan();
+    loadSystem(systemName);
 }
 
 void SolarSystem::loadSystem(const std::string& systemName) {
+    cancelPendingLoad();
+    
+    CachedSystem cached = m_cache.take(systemName);
+    if (cached.data) {
+        LOG_INFO("SolarSystem", "'", systemName, "' found in the system cache");
+        adoptSystem(systemName, std::move(cached.data), cached.hasPhysicsState);
+        return;
+    }
+    
+    std::string filePath = m_registry.getFilePath(systemName);
+    if (filePath.empty()) {
+        LOG_WARN("SolarSystem", "No system file declares '", systemName, "'");
+        adoptSystem(systemName, nullptr);
+        return;
+    }
+    adoptSystem(systemName, SystemLoader::loadFromFile(filePath));
+}
+
+void SolarSystem::loadSystemAsync(const std::string& systemName) {
+    cancelPendingLoad();
+    
+    auto load = std::make_unique<PendingLoad>();
+    load->systemName = systemName;
+    
+    // Cache hit: already finished, swapped in at the next frame boundary
+    CachedSystem cached = m_cache.take(systemName);
+    if (cached.data) {
+        load->result = std::move(cached.data);
+        load->hasPhysicsState = cached.hasPhysicsState;
+        load->control.report(1.0f);
+        load->finished.store(true, std::memory_order_release);
+        m_pendingLoad = std::move(load);
+        publishActiveSystems();
+        LOG_INFO("SolarSystem", "'", systemName, "' found in the system cache");
+        return;
+    }
+    
+    // Resolved here: the registry is only touched on this thread
+    load->filePath = m_registry.getFilePath(systemName);
+    if (load->filePath.empty()) {
+        LOG_WARN("SolarSystem", "No system file declares '", systemName, "'");
+    }
+    
+    PendingLoad* state = load.get();
+    state->thread = std::jthread([state](std::stop_token stopToken) {
+        state->control.stopToken = stopToken;
+        if (!state->filePath.empty()) {
+            state->result = SystemLoader::loadFromFile(state->filePath, &state->control);
+        }
+        state->finished.store(true, std::memory_order_release);
+    });
+    m_pendingLoad = std::move(load);
+    publishActiveSystems();
+    LOG_INFO("SolarSystem", "Loading '", systemName, "' in the background");
+}
+
+bool SolarSystem::applyPendingLoad() {
+    reapCancelledLoads();
+    if (!m_pendingLoad || !m_pendingLoad->finished.load(std::memory_order_acquire)) {
+        return false;
+    }
+    
+    std::unique_ptr<PendingLoad> load = std::move(m_pendingLoad);
+    if (load->thread.joinable()) {
+        load->thread.join();
+    }
+    adoptSystem(load->systemName, std::move(load->result), load->hasPhysicsState);
+    return true;
+}
+
+void SolarSystem::cancelPendingLoad() {
+    if (!m_pendingLoad) return;
+    
+    // Don't block on the join; the loader notices the stop request and exits
+    LOG_INFO("SolarSystem", "Cancelling load of '", m_pendingLoad->systemName, "'");
+    m_pendingLoad->thread.request_stop();
+    m_cancelledLoads.push_back(std::move(m_pendingLoad));
+    publishActiveSystems();
+    reapCancelledLoads();
+}
+
+void SolarSystem::publishActiveSystems() {
+    std::lock_guard<std::mutex> lock(m_activeMutex);
+    m_activeSystemName = m_currentSystemName;
+    m_activeLoadName = m_pendingLoad ? m_pendingLoad->systemName : std::string();
+}
+
+void SolarSystem::reapCancelledLoads() {
+    std::erase_if(m_cancelledLoads, [this](const std::unique_ptr<PendingLoad>& load) {
+        if (!load->finished.load(std::memory_order_acquire)) return false;
+        
+        // Finished before the cancel landed (or was a cache hit): keep it for next time
+        if (load->result) {
+            m_cache.putIfAbsent(load->systemName, {std::move(load->result), load->hasPhysicsState});
+        }
+        return true;
+    });
+}
+
+void SolarSystem::warmCache(std::vector<std::string> systemNames) {
+    // (name, file) pairs resolved here: the registry is only touched on this thread
+    std::vector<std::pair<std::string, std::string>> systems;
+    for (auto& name : systemNames) {
+        std::string filePath = m_registry.getFilePath(name);
+        if (name != m_currentSystemName && !filePath.empty()) {
+            systems.emplace_back(std::move(name), std::move(filePath));
+        }
+    }
+    if (systems.empty()) return;
+    
+    m_warming.store(true, std::memory_order_relaxed);
+    m_warmThread = std::jthread([this, systems = std::move(systems)](std::stop_token stopToken) {
+        // A live or loading system already has its data in memory
+        auto isActive = [this](const std::string& name) {
+            return name == m_activeSystemName || name == m_activeLoadName;
+        };
+        LoadControl control;
+        control.stopToken = stopToken;
+        size_t warmed = 0;
+        for (const auto& [name, filePath] : systems) {
+            if (stopToken.stop_requested()) break;
+            if (m_cache.contains(name)) continue;
+            {
+                std::lock_guard<std::mutex> lock(m_activeMutex);
+                if (isActive(name)) continue;
+            }
+            
+            auto data = SystemLoader::loadFromFile(filePath, &control);
+            if (!data) continue;
+            
+            // Checked again under the lock: the user may have switched to it meanwhile
+            std::lock_guard<std::mutex> lock(m_activeMutex);
+            if (!isActive(name)) {
+                m_cache.putIfAbsent(name, {std::move(data), false});
+                ++warmed;
+            }
+        }
+        LOG_INFO("SolarSystem", "System cache warmed with ", warmed, " systems (",
+                 m_cache.getUsedBytes() / (1024 * 1024), " MB)");
+        m_warming.store(false, std::memory_order_relaxed);
+    });
+}
+
+float SolarSystem::getLoadProgress() const {
+    return m_pendingLoad ? m_pendingLoad->control.progress.load(std::memory_order_relaxed) : 1.0f;
+}
+
+const std::string& SolarSystem::getLoadingSystemName() const {
+    static const std::string none;
+    return m_pendingLoad ? m_pendingLoad->systemName : none;
+}
+
+void SolarSystem::adoptSystem(const std::string& systemName, std::unique_ptr<SystemData> systemData,
+                              bool hasPhysicsState) {
+    // Park the outgoing system so switching back skips the file (reselecting
+    // the live system reloads it fresh instead)
+    if (m_currentFromFile && systemName != m_currentSystemName && !m_bodies.empty()) {
+        auto outgoing = std::make_unique<SystemData>();
+        outgoing->name = m_currentSystemName;
+        outgoing->systemScale = m_systemScale;
+        outgoing->planetScale = m_planetScale;
+        outgoing->arena = std::move(m_arena);
+        outgoing->bodies = std::move(m_bodies);
+        outgoing->populations = std::move(m_populations);
+        outgoing->testParticles = std::move(m_testParticles);
+        outgoing->derived = std::move(m_derived);
+        outgoing->compiled = std::move(m_compiled);
+        m_cache.put(m_currentSystemName, {std::move(outgoing), m_physicsEnabled});
+    }
+    
+    // Bodies are not destroyed one by one: dropping the arena releases them all
     m_bodies.clear();
+    m_arena.reset();
+    m_populations.clear();
+    m_testParticles.clear();
+    m_derived.reset();
+    m_compiled.reset();
     m_currentSystemName = systemName;
-    
-    // Try to load from JSON file
-    std::string filePath = SystemLoader::getSystemFilePath(systemName);
-    auto systemData = SystemLoader::loadFromFile(filePath);
+    m_currentFromFile = systemData != nullptr;
+    ++m_stateGeneration;
+    ++m_systemGeneration;
     
     if (systemData) {
         m_systemScale = systemData->systemScale;
         m_planetScale = systemData->planetScale;
+        m_arena = std::move(systemData->arena);
         m_bodies = std::move(systemData->bodies);
-        LOG_INFO("SolarSystem", "Loaded '", systemName, "' from JSON");
+        m_populations = std::move(systemData->populations);
+        m_testParticles = std::move(systemData->testParticles);
+        m_derived = std::move(systemData->derived);
+        m_compiled = std::move(systemData->compiled);
+        LOG_INFO("SolarSystem", "Loaded '", systemName, "'");
     } else {
         // Fallback to hardcoded Solar System if JSON loading fails
         LOG_WARN("SolarSystem", "Failed to load '", systemName, "' from JSON, using fallback");
         loadFallbackSolarSystem();
     }
     
-    if (m_physicsEnabled) {
+    // A copy the warm thread cached before it saw this system go live
+    publishActiveSystems();
+    m_cache.take(m_currentSystemName);
+    
+    if (m_physicsEnabled && !(hasPhysicsState && m_keepPhysicsState)) {
         resetPhysics();
     }
 }
@@ -47,58 +232,66 @@ void SolarSystem::setPhysicsEnabled(bool enabled) {
 void SolarSystem::resetPhysics() {
     // Delegate to PhysicsSimulator (SRP)
     m_physicsSimulator->initializeFromOrbits(m_bodies, 0.0);
+    ++m_stateGeneration;
 }
 
 void SolarSystem::updatePhysics(double dt) {
     if (!m_physicsEnabled) return;
     // Delegate to PhysicsSimulator (SRP)
     m_physicsSimulator->update(m_bodies, dt);
+    ++m_physicsStepCount;
+    m_physicsTime += dt;
+}
+
+void SolarSystem::collectAttractors(std::vector<glm::vec4>& outAttractors, size_t maxCount) const {
+    m_physicsSimulator->collectAttractors(m_bodies, outAttractors, maxCount);
 }
 
 void SolarSystem::loadFallbackSolarSystem() {
     m_currentSystemName = "Solar System";
     m_systemScale = 10.0f;
     m_planetScale = 0.5f;
+    m_arena = std::make_unique<BodyArena>();
     
     // Sun
-    m_bodies.push_back(std::make_unique<CelestialBody>("Sun", 109.0, glm::vec3(1.0f, 1.0f, 0.0f), OrbitalParams{0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0}, BodyType::Star));
+    m_bodies.push_back(m_arena->create("Sun", 109.0, glm::vec3(1.0f, 1.0f, 0.0f), OrbitalParams{0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0}, BodyType::Star));
     // Mercury
-    m_bodies.push_back(std::make_unique<CelestialBody>("Mercury", 0.38, glm::vec3(0.7f, 0.7f, 0.7f), OrbitalParams{0.387, 0.2056, glm::radians(7.00), 0.2408, glm::radians(174.79), glm::radians(48.33), glm::radians(29.12)}, BodyType::Planet));
+    m_bodies.push_back(m_arena->create("Mercury", 0.38, glm::vec3(0.7f, 0.7f, 0.7f), OrbitalParams{0.387, 0.2056, glm::radians(7.00), 0.2408, glm::radians(174.79), glm::radians(48.33), glm::radians(29.12)}, BodyType::Planet));
     // Venus
-    m_bodies.push_back(std::make_unique<CelestialBody>("Venus", 0.95, glm::vec3(0.9f, 0.8f, 0.5f), OrbitalParams{0.723, 0.0068, glm::radians(3.39), 0.6152, glm::radians(50.11), glm::radians(76.68), glm::radians(54.85)}, BodyType::Planet));
+    m_bodies.push_back(m_arena->create("Venus", 0.95, glm::vec3(0.9f, 0.8f, 0.5f), OrbitalParams{0.723, 0.0068, glm::radians(3.39), 0.6152, glm::radians(50.11), glm::radians(76.68), glm::radians(54.85)}, BodyType::Planet));
     
     // Earth & Moon
-    auto earth = std::make_unique<CelestialBody>("Earth", 1.0, glm::vec3(0.2f, 0.4f, 0.9f), OrbitalParams{1.000, 0.0167, glm::radians(0.00), 1.0000, glm::radians(357.52), glm::radians(-11.26), glm::radians(102.94)}, BodyType::Planet);
-    earth->addChild(std::make_unique<CelestialBody>("Moon", 0.27, glm::vec3(0.6f, 0.6f, 0.6f), OrbitalParams{0.15, 0.0549, glm::radians(5.145), 0.0748, 0.0, 0.0, 0.0}, BodyType::Moon));
+    auto earth = m_arena->create("Earth", 1.0, glm::vec3(0.2f, 0.4f, 0.9f), OrbitalParams{1.000, 0.0167, glm::radians(0.00), 1.0000, glm::radians(357.52), glm::radians(-11.26), glm::radians(102.94)}, BodyType::Planet);
+    earth->addChild(m_arena->create("Moon", 0.27, glm::vec3(0.6f, 0.6f, 0.6f), OrbitalParams{0.15, 0.0549, glm::radians(5.145), 0.0748, 0.0, 0.0, 0.0}, BodyType::Moon));
     m_bodies.push_back(std::move(earth));
     
     // Mars & Moons
-    auto mars = std::make_unique<CelestialBody>("Mars", 0.53, glm::vec3(0.8f, 0.4f, 0.3f), OrbitalParams{1.524, 0.0934, glm::radians(1.85), 1.8808, glm::radians(19.41), glm::radians(49.58), glm::radians(286.50)}, BodyType::Planet);
-    mars->addChild(std::make_unique<CelestialBody>("Phobos", 0.15, glm::vec3(0.5f, 0.4f, 0.4f), OrbitalParams{0.08, 0.0151, glm::radians(1.093), 0.0008, 0.0, 0.0, 0.0}, BodyType::Moon));
-    mars->addChild(std::make_unique<CelestialBody>("Deimos", 0.12, glm::vec3(0.6f, 0.5f, 0.5f), OrbitalParams{0.12, 0.0002, glm::radians(0.93), 0.003, 0.0, 0.0, 0.0}, BodyType::Moon));
+    auto mars = m_arena->create("Mars", 0.53, glm::vec3(0.8f, 0.4f, 0.3f), OrbitalParams{1.524, 0.0934, glm::radians(1.85), 1.8808, glm::radians(19.41), glm::radians(49.58), glm::radians(286.50)}, BodyType::Planet);
+    mars->addChild(m_arena->create("Phobos", 0.15, glm::vec3(0.5f, 0.4f, 0.4f), OrbitalParams{0.08, 0.0151, glm::radians(1.093), 0.0008, 0.0, 0.0, 0.0}, BodyType::Moon));
+    mars->addChild(m_arena->create("Deimos", 0.12, glm::vec3(0.6f, 0.5f, 0.5f), OrbitalParams{0.12, 0.0002, glm::radians(0.93), 0.003, 0.0, 0.0, 0.0}, BodyType::Moon));
     m_bodies.push_back(std::move(mars));
 
     // Jupiter & Moons
-    auto jupiter = std::make_unique<CelestialBody>("Jupiter", 11.2, glm::vec3(0.8f, 0.7f, 0.6f), OrbitalParams{5.203, 0.0484, glm::radians(1.30), 11.862, glm::radians(20.02), glm::radians(100.55), glm::radians(273.87)}, BodyType::Planet);
-    jupiter->addChild(std::make_unique<CelestialBody>("Io", 0.28, glm::vec3(0.8f, 0.8f, 0.4f), OrbitalParams{0.40, 0.004, 0.0, 0.0048, 0.0, 0.0, 0.0}, BodyType::Moon));
-    jupiter->addChild(std::make_unique<CelestialBody>("Europa", 0.24, glm::vec3(0.7f, 0.7f, 0.7f), OrbitalParams{0.55, 0.009, 0.0, 0.0097, 0.0, 0.0, 0.0}, BodyType::Moon));
-    jupiter->addChild(std::make_unique<CelestialBody>("Ganymede", 0.41, glm::vec3(0.6f, 0.6f, 0.6f), OrbitalParams{0.75, 0.001, 0.0, 0.0196, 0.0, 0.0, 0.0}, BodyType::Moon));
-    jupiter->addChild(std::make_unique<CelestialBody>("Callisto", 0.37, glm::vec3(0.5f, 0.5f, 0.5f), OrbitalParams{1.0, 0.007, 0.0, 0.0457, 0.0, 0.0, 0.0}, BodyType::Moon));
+    auto jupiter = m_arena->create("Jupiter", 11.2, glm::vec3(0.8f, 0.7f, 0.6f), OrbitalParams{5.203, 0.0484, glm::radians(1.30), 11.862, glm::radians(20.02), glm::radians(100.55), glm::radians(273.87)}, BodyType::Planet);
+    jupiter->addChild(m_arena->create("Io", 0.28, glm::vec3(0.8f, 0.8f, 0.4f), OrbitalParams{0.40, 0.004, 0.0, 0.0048, 0.0, 0.0, 0.0}, BodyType::Moon));
+    jupiter->addChild(m_arena->create("Europa", 0.24, glm::vec3(0.7f, 0.7f, 0.7f), OrbitalParams{0.55, 0.009, 0.0, 0.0097, 0.0, 0.0, 0.0}, BodyType::Moon));
+    jupiter->addChild(m_arena->create("Ganymede", 0.41, glm::vec3(0.6f, 0.6f, 0.6f), OrbitalParams{0.75, 0.001, 0.0, 0.0196, 0.0, 0.0, 0.0}, BodyType::Moon));
+    jupiter->addChild(m_arena->create("Callisto", 0.37, glm::vec3(0.5f, 0.5f, 0.5f), OrbitalParams{1.0, 0.007, 0.0, 0.0457, 0.0, 0.0, 0.0}, BodyType::Moon));
     m_bodies.push_back(std::move(jupiter));
     
     // Saturn
-    auto saturn = std::make_unique<CelestialBody>("Saturn", 9.45, glm::vec3(0.9f, 0.8f, 0.6f), OrbitalParams{9.537, 0.0541, glm::radians(2.49), 29.457, glm::radians(317.02), glm::radians(113.72), glm::radians(339.39)}, BodyType::Planet);
-    saturn->addChild(std::make_unique<CelestialBody>("Titan", 0.40, glm::vec3(0.8f, 0.6f, 0.2f), OrbitalParams{0.82, 0.028, 0.0, 0.0437, 0.0, 0.0, 0.0}, BodyType::Moon));
+    auto saturn = m_arena->create("Saturn", 9.45, glm::vec3(0.9f, 0.8f, 0.6f), OrbitalParams{9.537, 0.0541, glm::radians(2.49), 29.457, glm::radians(317.02), glm::radians(113.72), glm::radians(339.39)}, BodyType::Planet);
+    saturn->addChild(m_arena->create("Titan", 0.40, glm::vec3(0.8f, 0.6f, 0.2f), OrbitalParams{0.82, 0.028, 0.0, 0.0437, 0.0, 0.0, 0.0}, BodyType::Moon));
     m_bodies.push_back(std::move(saturn));
     
     // Uranus
-    auto uranus = std::make_unique<CelestialBody>("Uranus", 4.0, glm::vec3(0.6f, 0.8f, 0.9f), OrbitalParams{19.191, 0.0472, glm::radians(0.77), 84.011, glm::radians(142.59), glm::radians(74.00), glm::radians(96.66)}, BodyType::Planet);
-    uranus->addChild(std::make_unique<CelestialBody>("Titania", 0.12, glm::vec3(0.7f, 0.7f, 0.7f), OrbitalParams{0.29, 0.001, 0.0, 0.0238, 0.0, 0.0, 0.0}, BodyType::Moon));
+    auto uranus = m_arena->create("Uranus", 4.0, glm::vec3(0.6f, 0.8f, 0.9f), OrbitalParams{19.191, 0.0472, glm::radians(0.77), 84.011, glm::radians(142.59), glm::radians(74.00), glm::radians(96.66)}, BodyType::Planet);
+    uranus->addChild(m_arena->create("Titania", 0.12, glm::vec3(0.7f, 0.7f, 0.7f), OrbitalParams{0.29, 0.001, 0.0, 0.0238, 0.0, 0.0, 0.0}, BodyType::Moon));
     m_bodies.push_back(std::move(uranus));
 
     // Neptune
-    auto neptune = std::make_unique<CelestialBody>("Neptune", 3.88, glm::vec3(0.3f, 0.3f, 0.8f), OrbitalParams{30.069, 0.0086, glm::radians(1.77), 164.79, glm::radians(260.25), glm::radians(131.78), glm::radians(272.85)}, BodyType::Planet);
-    neptune->addChild(std::make_unique<CelestialBody>("Triton", 0.21, glm::vec3(0.7f, 0.6f, 0.8f), OrbitalParams{0.24, 0.0, glm::radians(157.0), 0.016, 0.0, 0.0, 0.0}, BodyType::Moon));
+    auto neptune = m_arena->create("Neptune", 3.88, glm::vec3(0.3f, 0.3f, 0.8f), OrbitalParams{30.069, 0.0086, glm::radians(1.77), 164.79, glm::radians(260.25), glm::radians(131.78), glm::radians(272.85)}, BodyType::Planet);
+    neptune->addChild(m_arena->create("Triton", 0.21, glm::vec3(0.7f, 0.6f, 0.8f), OrbitalParams{0.24, 0.0, glm::radians(157.0), 0.016, 0.0, 0.0, 0.0}, BodyType::Moon));
     m_bodies.push_back(std::move(neptune));
 }
 
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include "CelestialBody.hpp"
 #include "PhysicsSimulator.hpp"
+#include "ParticlePopulation.hpp"
+#include "SystemCache.hpp"
+#include "SystemLoader.hpp"
+#include "SystemRegistry.hpp"
 
 namespace Simulation {
 
@@ -12,15 +20,59 @@ class SolarSystem {
 public:
     SolarSystem();
 
-    void init(); // Loads default Solar System
+    static constexpr const char* DEFAULT_SYSTEM = "Solar System";
+    
+    /// Scan the registry and load the first system
+    void init(const std::string& systemName = DEFAULT_SYSTEM);
     void loadSystem(const std::string& systemName);
+    
+    /// Start loading a system on a background thread. The current system stays
+    /// live until applyPendingLoad() swaps the result in; a new request cancels
+    /// any load still in flight.
+    void loadSystemAsync(const std::string& systemName);
+    
+    /// Swap in a finished background load. Call at a frame boundary: body
+    /// pointers held elsewhere are invalidated when this returns true.
+    bool applyPendingLoad();
+    
+    void cancelPendingLoad();
+    bool isLoading() const { return m_pendingLoad != nullptr; }
+    float getLoadProgress() const;
+    const std::string& getLoadingSystemName() const;
+    
+    /// Available system files; add directories before init()
+    SystemRegistry& getRegistry() { return m_registry; }
+    const SystemRegistry& getRegistry() const { return m_registry; }
+    
+    /// Systems switched away from are parked here; loads check it first
+    SystemCache& getCache() { return m_cache; }
+    const SystemCache& getCache() const { return m_cache; }
+    
+    /// Parse the given systems into the cache on a background thread (skipping
+    /// any already cached, and whichever system is live or loading at the time)
+    void warmCache(std::vector<std::string> systemNames);
+    bool isWarmingCache() const { return m_warming.load(std::memory_order_relaxed); }
+    
+    /// Resume a cached system's N-body state instead of resetting it from orbits
+    void setKeepPhysicsState(bool keep) { m_keepPhysicsState = keep; }
+    bool isKeepPhysicsState() const { return m_keepPhysicsState; }
 
-    const std::vector<std::unique_ptr<CelestialBody>>& getBodies() const { return m_bodies; }
+    const std::vector<BodyPtr>& getBodies() const { return m_bodies; }
     // Non-const access for physics updates
-    std::vector<std::unique_ptr<CelestialBody>>& getBodies() { return m_bodies; }
+    std::vector<BodyPtr>& getBodies() { return m_bodies; }
     
     const CelestialBody* getSun() const; // Returns the central star
     
+    /// Massless particle groups drawn on the GPU (no per-particle bodies)
+    const std::vector<ParticlePopulation>& getPopulations() const { return m_populations; }
+    
+    /// Massless swarms integrated on the GPU while physics is enabled
+    const std::vector<TestParticleSwarm>& getTestParticleSwarms() const { return m_testParticles; }
+    
+    /// Massive bodies as (physics position, G * mass), heaviest first when truncated
+    void collectAttractors(std::vector<glm::vec4>& outAttractors, size_t maxCount) const;
+    double getGravityConstant() const { return m_physicsSimulator->getGravityConstant(); }
+    
     const std::string& getCurrentSystemName() const { return m_currentSystemName; }
     float getSystemScale() const { return m_systemScale; } 
     float getPlanetScale() const { return m_planetScale; }
@@ -30,18 +82,72 @@ public:
     bool isPhysicsEnabled() const { return m_physicsEnabled; }
     void updatePhysics(double dt);
     void resetPhysics();
+    
+    /// Incremented on every physics step; lets renderers detect new samples
+    uint64_t getPhysicsStepCount() const { return m_physicsStepCount; }
+    
+    /// Simulated time integrated so far, summed over physics steps
+    double getPhysicsTime() const { return m_physicsTime; }
+    
+    /// Incremented whenever body state is replaced (system load, physics reset)
+    uint64_t getStateGeneration() const { return m_stateGeneration; }
+    
+    /// Incremented on every system load; static per-system data may be cached against it
+    uint64_t getSystemGeneration() const { return m_systemGeneration; }
 
 private:
+    /// A background load; the thread is declared last so it is joined before
+    /// the state it writes is destroyed
+    struct PendingLoad {
+        std::string systemName;
+        std::string filePath;
+        LoadControl control;
+        std::unique_ptr<SystemData> result;
+        bool hasPhysicsState = false;     // Result came from the cache with N-body state
+        std::atomic<bool> finished{false};
+        std::jthread thread;
+    };
+    
+    /// Replace the current system with loaded data (nullptr: fallback system).
+    /// The outgoing system is moved into the cache.
+    void adoptSystem(const std::string& systemName, std::unique_ptr<SystemData> systemData,
+                     bool hasPhysicsState = false);
+    void reapCancelledLoads();
     void loadFallbackSolarSystem();
     
-    std::vector<std::unique_ptr<CelestialBody>> m_bodies;
+    /// Publish the live and loading system names to the warm-cache thread
+    void publishActiveSystems();
+    
+    std::unique_ptr<BodyArena> m_arena;   // Owns the bodies of the live system
+    std::vector<BodyPtr> m_bodies;
+    std::vector<ParticlePopulation> m_populations;
+    std::vector<TestParticleSwarm> m_testParticles;
+    std::shared_ptr<const DerivedData> m_derived;   // Backs the bodies' orbit paths
+    std::shared_ptr<const CompiledSystem> m_compiled;   // Backs mapped particle elements
     std::string m_currentSystemName;
+    bool m_currentFromFile = false;   // The fallback system is never cached
     float m_systemScale = 10.0f; 
     float m_planetScale = 1.0f; 
     
     // Physics simulation (SRP - extracted into separate class)
     bool m_physicsEnabled = false;
     std::unique_ptr<PhysicsSimulator> m_physicsSimulator;
+    uint64_t m_physicsStepCount = 0;
+    double m_physicsTime = 0.0;
+    uint64_t m_stateGeneration = 0;
+    uint64_t m_systemGeneration = 0;
+    
+    SystemRegistry m_registry;
+    std::unique_ptr<PendingLoad> m_pendingLoad;
+    std::vector<std::unique_ptr<PendingLoad>> m_cancelledLoads;   // Still winding down
+    
+    SystemCache m_cache;
+    bool m_keepPhysicsState = true;
+    std::atomic<bool> m_warming{false};
+    std::mutex m_activeMutex;           // Guards the names below for the warm thread
+    std::string m_activeSystemName;
+    std::string m_activeLoadName;
+    std::jthread m_warmThread;    // Last: joined before the cache it fills is destroyed
 };
 
 } // namespace Simulation
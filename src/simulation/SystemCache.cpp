@@ -0,0 +1,154 @@
+#include "SystemCache.hpp"
+#include "DerivedData.hpp"
+#include "core/Logger.hpp"
+
+namespace Simulation {
+
+SystemCache::SystemCache(size_t budgetBytes)
+    : m_budget(budgetBytes) {
+}
+
+SystemCache::~SystemCache() = default;
+
+CachedSystem SystemCache::take(const std::string& systemName) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(systemName);
+    if (found == m_index.end()) {
+        ++m_misses;
+        return {};
+    }
+    
+    ++m_hits;
+    CachedSystem result = std::move(found->second->system);
+    m_usedBytes -= found->second->bytes;
+    m_entries.erase(found->second);
+    m_index.erase(found);
+    return result;
+}
+
+void SystemCache::put(const std::string& systemName, CachedSystem entry) {
+    if (!entry.data) return;
+    
+    // Estimated outside the lock: large catalogs take a few ms to walk
+    size_t bytes = estimateBytes(*entry.data);
+    
+    // Evicted systems are destroyed after the lock is released
+    std::vector<CachedSystem> evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto found = m_index.find(systemName);
+    if (found != m_index.end()) {
+        m_usedBytes -= found->second->bytes;
+        evicted.push_back(std::move(found->second->system));
+        m_entries.erase(found->second);
+        m_index.erase(found);
+    }
+    insertLocked(systemName, std::move(entry), bytes, evicted);
+}
+
+void SystemCache::putIfAbsent(const std::string& systemName, CachedSystem entry) {
+    if (!entry.data || contains(systemName)) return;
+    
+    size_t bytes = estimateBytes(*entry.data);
+    std::vector<CachedSystem> evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_index.count(systemName)) {
+        evicted.push_back(std::move(entry));   // Raced with another insert
+        return;
+    }
+    insertLocked(systemName, std::move(entry), bytes, evicted);
+}
+
+void SystemCache::insertLocked(const std::string& systemName, CachedSystem entry, size_t bytes,
+                               std::vector<CachedSystem>& evicted) {
+    if (bytes > m_budget) {
+        LOG_DEBUG("SystemCache", "'", systemName, "' (", bytes / (1024 * 1024),
+                  " MB) exceeds the cache budget, not cached");
+        evicted.push_back(std::move(entry));
+        return;
+    }
+    
+    m_entries.push_front(Entry{systemName, std::move(entry), bytes});
+    m_index[systemName] = m_entries.begin();
+    m_usedBytes += bytes;
+    evictLocked(evicted);
+}
+
+void SystemCache::evictLocked(std::vector<CachedSystem>& evicted) {
+    while (m_usedBytes > m_budget && !m_entries.empty()) {
+        Entry& oldest = m_entries.back();
+        LOG_DEBUG("SystemCache", "Evicting '", oldest.systemName, "'");
+        m_usedBytes -= oldest.bytes;
+        evicted.push_back(std::move(oldest.system));
+        m_index.erase(oldest.systemName);
+        m_entries.pop_back();
+    }
+}
+
+bool SystemCache::contains(const std::string& systemName) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_index.count(systemName) != 0;
+}
+
+void SystemCache::clear() {
+    std::list<Entry> entries;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entries.swap(m_entries);
+    m_index.clear();
+    m_usedBytes = 0;
+}
+
+void SystemCache::setBudget(size_t bytes) {
+    std::vector<CachedSystem> evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = bytes;
+    evictLocked(evicted);
+}
+
+size_t SystemCache::getBudget() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+}
+
+size_t SystemCache::getUsedBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_usedBytes;
+}
+
+size_t SystemCache::getEntryCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+uint64_t SystemCache::getHits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+uint64_t SystemCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+size_t SystemCache::estimateBytes(const SystemData& data) {
+    size_t bytes = sizeof(SystemData) + data.name.size();
+    
+    // Bodies, names and child arrays all live in the arena
+    bytes += data.bodies.capacity() * sizeof(BodyPtr);
+    if (data.arena) {
+        bytes += sizeof(BodyArena) + data.arena->getReservedBytes();
+    }
+    
+    for (const auto& population : data.populations) {
+        bytes += sizeof(ParticlePopulation) + population.name.size() + population.parentName.size();
+        bytes += population.elements.capacity() * sizeof(ParticleElements);   // Mapped elements are page cache
+    }
+    for (const auto& swarm : data.testParticles) {
+        bytes += sizeof(TestParticleSwarm) + swarm.name.size() + swarm.parentName.size();
+    }
+    if (data.derived) {
+        bytes += data.derived->getHeapBytes();   // Mapped blobs are backed by the page cache
+    }
+    return bytes;
+}
+
+} // namespace Simulation
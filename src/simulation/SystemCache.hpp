@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SystemLoader.hpp"
+
+namespace Simulation {
+
+/// A parsed system parked outside SolarSystem
+struct CachedSystem {
+    std::unique_ptr<SystemData> data;
+    bool hasPhysicsState = false;   // Bodies hold the N-body state from when the system was live
+};
+
+/// Bounded LRU of parsed systems that are not currently live, so switching
+/// back to a recently used system skips the file entirely. Entries are moved
+/// in and out (a system is either live or cached, never both), and the least
+/// recently used ones are dropped once the estimated size exceeds the budget.
+/// Thread-safe: the cache may be filled from a background warming thread.
+class SystemCache {
+public:
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 512ull * 1024 * 1024;
+
+    explicit SystemCache(size_t budgetBytes = DEFAULT_BUDGET_BYTES);
+    ~SystemCache();
+
+    // Non-copyable
+    SystemCache(const SystemCache&) = delete;
+    SystemCache& operator=(const SystemCache&) = delete;
+
+    /// Remove and return the entry for `systemName` (data is nullptr on a miss)
+    CachedSystem take(const std::string& systemName);
+
+    /// Insert as most recently used, replacing any entry of the same name.
+    /// Systems larger than the whole budget are not cached.
+    void put(const std::string& systemName, CachedSystem entry);
+
+    /// Like put(), but keeps an existing entry (which may hold physics state)
+    void putIfAbsent(const std::string& systemName, CachedSystem entry);
+
+    bool contains(const std::string& systemName) const;
+    void clear();
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+    size_t getUsedBytes() const;
+    size_t getEntryCount() const;
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+
+    /// Approximate heap footprint of a system (bodies, names, particle elements)
+    static size_t estimateBytes(const SystemData& data);
+
+private:
+    struct Entry {
+        std::string systemName;
+        CachedSystem system;
+        size_t bytes = 0;
+    };
+
+    void insertLocked(const std::string& systemName, CachedSystem entry, size_t bytes,
+                      std::vector<CachedSystem>& evicted);
+    void evictLocked(std::vector<CachedSystem>& evicted);
+
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_entries;     // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+    size_t m_budget;
+    size_t m_usedBytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+};
+
+} // namespace Simulation
@@ -0,0 +1,398 @@
+#include "SystemGenerator.hpp"
+#include "CompiledSystem.hpp"
+#include "third_party/json.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace Simulation {
+
+namespace {
+
+constexpr double EARTH_RADIUS_AU = 4.2635e-5;
+constexpr double EARTH_MASS_SOLAR = 3.003e-6;
+constexpr double SUN_RADIUS_EARTH = 109.1;
+constexpr double MIN_PLANET_AXIS = 0.05;   // AU
+constexpr double MAX_PLANET_AXIS = 40.0;
+constexpr float SYSTEM_SCALE = 1000.0f;     // Same framing as the Solar System
+constexpr float PLANET_SCALE = 0.1f;
+constexpr uint32_t BELT_SEED_STRIDE = 7919u;
+constexpr uint32_t SWARM_SEED_OFFSET = 104729u;
+constexpr const char* STAR_NAME = "Star";
+
+/// One body in file units (angles in degrees), before it becomes a CelestialBody or JSON
+struct GeneratedBody {
+    std::string name;
+    BodyType type = BodyType::Planet;
+    double radius = 1.0;
+    glm::vec3 color{1.0f};
+    double semiMajorAxis = 0.0;
+    double eccentricity = 0.0;
+    double inclination = 0.0;
+    double period = 1.0;
+    double meanAnomaly = 0.0;
+    double longitudeAscendingNode = 0.0;
+    double argumentPeriapsis = 0.0;
+};
+
+struct BeltSpec {
+    std::string name;
+    ParticleDistribution distribution;
+    size_t count = 0;
+    uint32_t seed = 1;
+    glm::vec3 color{0.55f, 0.5f, 0.45f};
+    float pointSize = 1.5f;
+    float opacity = 0.35f;
+};
+
+class Sampler {
+public:
+    explicit Sampler(uint32_t seed) : m_rng(seed) {}
+    
+    double uniform(double min, double max) {
+        return std::uniform_real_distribution<double>(min, max)(m_rng);
+    }
+    
+    double logUniform(double min, double max) {
+        return std::exp(uniform(std::log(min), std::log(max)));
+    }
+    
+    /// Rayleigh-distributed with scale `sigma`, clipped to `max`
+    double rayleigh(double sigma, double max) {
+        return std::min(sigma * std::sqrt(-2.0 * std::log1p(-uniform(0.0, 1.0))), max);
+    }
+    
+    double angle() { return uniform(0.0, 360.0); }
+    
+    glm::vec3 tint(const glm::vec3& base, float amount) {
+        glm::vec3 color;
+        for (int i = 0; i < 3; ++i) {
+            color[i] = std::clamp(base[i] + static_cast<float>(uniform(-amount, amount)), 0.0f, 1.0f);
+        }
+        return color;
+    }
+    
+private:
+    std::mt19937 m_rng;
+};
+
+std::string systemName(const GeneratorOptions& options) {
+    return options.name.empty() ? "Generated " + std::to_string(options.seed) : options.name;
+}
+
+size_t moonTotal(const GeneratorOptions& options) {
+    if (options.planetCount == 0) return 0;
+    return static_cast<size_t>(std::llround(static_cast<double>(options.planetCount) *
+                                            std::max(options.moonsPerPlanet, 0.0)));
+}
+
+/// Earth radii from Earth masses: rocky below 2, growing to Jupiter size and flat beyond
+double radiusFromMass(double mass) {
+    return mass < 2.0 ? std::pow(mass, 0.28) : std::min(std::pow(mass, 0.59), 11.2);
+}
+
+/// Visit the star, then each planet (depth 0) followed by its moons (depth 1)
+template <typename Visitor>
+void forEachBody(const GeneratorOptions& options, Visitor&& visit) {
+    Sampler sampler(options.seed);
+    
+    GeneratedBody star;
+    star.name = STAR_NAME;
+    star.type = BodyType::Star;
+    star.radius = SUN_RADIUS_EARTH * std::pow(options.starMass, 0.8);
+    star.color = glm::vec3(1.0f, 0.95f, 0.75f);
+    visit(star, 0);
+    
+    // Axes drawn up front and sorted, so planets are numbered outward
+    std::vector<double> axes(options.planetCount);
+    for (double& axis : axes) {
+        axis = sampler.logUniform(MIN_PLANET_AXIS, MAX_PLANET_AXIS);
+    }
+    std::sort(axes.begin(), axes.end());
+    
+    size_t moons = moonTotal(options);
+    size_t moonsEach = options.planetCount ? moons / options.planetCount : 0;
+    size_t moonsExtra = options.planetCount ? moons % options.planetCount : 0;
+    
+    GeneratedBody planet;
+    planet.type = BodyType::Planet;
+    GeneratedBody moon;
+    moon.type = BodyType::Moon;
+    std::vector<double> moonAxes;
+    for (size_t i = 0; i < options.planetCount; ++i) {
+        double mass = sampler.logUniform(0.1, 4000.0);     // Earth masses
+        planet.name = "P" + std::to_string(i + 1);
+        planet.radius = radiusFromMass(mass);
+        planet.semiMajorAxis = axes[i];
+        planet.eccentricity = sampler.rayleigh(0.05, 0.6);
+        planet.inclination = sampler.rayleigh(1.5, 30.0);
+        planet.period = std::sqrt(axes[i] * axes[i] * axes[i] / options.starMass);
+        planet.meanAnomaly = sampler.angle();
+        planet.longitudeAscendingNode = sampler.angle();
+        planet.argumentPeriapsis = sampler.angle();
+        if (planet.radius < 2.0) {
+            planet.color = sampler.tint(glm::vec3(0.6f, 0.5f, 0.4f), 0.15f);
+        } else if (axes[i] > 5.0) {
+            planet.color = sampler.tint(glm::vec3(0.55f, 0.7f, 0.9f), 0.1f);
+        } else {
+            planet.color = sampler.tint(glm::vec3(0.85f, 0.75f, 0.55f), 0.1f);
+        }
+        visit(planet, 0);
+        
+        // Moons between 3 and 100 planet radii; periods from the loader's
+        // mass estimate (radius cubed, in Earth masses)
+        double planetMass = planet.radius * planet.radius * planet.radius * EARTH_MASS_SOLAR;
+        double planetRadiusAu = planet.radius * EARTH_RADIUS_AU;
+        moonAxes.resize(moonsEach + (i < moonsExtra ? 1 : 0));
+        for (double& axis : moonAxes) {
+            axis = sampler.logUniform(3.0, 100.0) * planetRadiusAu;
+        }
+        std::sort(moonAxes.begin(), moonAxes.end());
+        for (size_t j = 0; j < moonAxes.size(); ++j) {
+            double a = moonAxes[j];
+            moon.name = planet.name + " M" + std::to_string(j + 1);
+            moon.radius = std::min(sampler.logUniform(0.02, 0.4), planet.radius * 0.5);
+            moon.semiMajorAxis = a;
+            moon.eccentricity = sampler.rayleigh(0.01, 0.3);
+            moon.inclination = sampler.rayleigh(1.0, 20.0);
+            moon.period = std::sqrt(a * a * a / planetMass);
+            moon.meanAnomaly = sampler.angle();
+            moon.longitudeAscendingNode = sampler.angle();
+            moon.argumentPeriapsis = sampler.angle();
+            moon.color = glm::vec3(static_cast<float>(sampler.uniform(0.45, 0.75)));
+            visit(moon, 1);
+        }
+    }
+}
+
+/// Belts use their own stream, so they don't change with the body counts
+std::vector<BeltSpec> planBelts(const GeneratorOptions& options) {
+    Sampler sampler(options.seed ^ 0x5EEDB17Fu);
+    std::vector<BeltSpec> belts(options.beltCount);
+    for (size_t i = 0; i < belts.size(); ++i) {
+        BeltSpec& belt = belts[i];
+        double center = sampler.logUniform(1.5, 30.0);
+        double halfWidth = center * sampler.uniform(0.05, 0.2);
+        belt.name = "Belt " + std::to_string(i + 1);
+        belt.count = options.particlesPerBelt;
+        belt.seed = options.seed + BELT_SEED_STRIDE * static_cast<uint32_t>(i + 1);
+        belt.distribution.semiMajorAxis = {static_cast<float>(center - halfWidth), static_cast<float>(center + halfWidth)};
+        belt.distribution.eccentricity = {0.0f, static_cast<float>(sampler.uniform(0.05, 0.2))};
+        belt.distribution.inclination = {0.0f, static_cast<float>(sampler.uniform(3.0, 15.0))};
+        belt.distribution.size = {0.5f, 1.5f};
+        belt.distribution.centralMass = options.starMass;
+        belt.color = sampler.tint(glm::vec3(0.55f, 0.5f, 0.45f), 0.1f);
+    }
+    return belts;
+}
+
+TestParticleSwarm planSwarm(const GeneratorOptions& options) {
+    TestParticleSwarm swarm;
+    swarm.name = "Swarm";
+    swarm.parentName = STAR_NAME;
+    swarm.count = options.testParticleCount;
+    swarm.seed = options.seed + SWARM_SEED_OFFSET;
+    swarm.innerRadius = 0.5f;
+    swarm.outerRadius = 5.0f;
+    swarm.thickness = 0.05f;
+    swarm.captureRadius = 0.05f;
+    swarm.color = glm::vec3(0.9f, 0.6f, 0.3f);
+    swarm.pointSize = 1.0f;
+    swarm.opacity = 0.3f;
+    return swarm;
+}
+
+const char* typeName(BodyType type) {
+    switch (type) {
+        case BodyType::Star: return "star";
+        case BodyType::Moon: return "moon";
+        default: return "planet";
+    }
+}
+
+/// Minimal streaming JSON output. Numbers use the shortest representation that
+/// parses back to the same value, so a written system loads bit-identically.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out) : m_out(out) {}
+    
+    JsonWriter& raw(const char* text) { m_out << text; return *this; }
+    JsonWriter& string(const std::string& value) { m_out << nlohmann::json(value).dump(); return *this; }
+    
+    template <typename T>
+    JsonWriter& number(T value) {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        m_out.write(buffer, result.ptr - buffer);
+        return *this;
+    }
+    
+    JsonWriter& key(const char* name) { m_out << '"' << name << "\": "; return *this; }
+    
+    JsonWriter& vec3(const glm::vec3& value) {
+        return raw("[").number(value.x).raw(", ").number(value.y).raw(", ").number(value.z).raw("]");
+    }
+    
+    JsonWriter& range(const ParticleRange& value) {
+        return raw("[").number(value.min).raw(", ").number(value.max).raw("]");
+    }
+    
+private:
+    std::ostream& m_out;
+};
+
+void writeBody(JsonWriter& json, const GeneratedBody& body) {
+    json.raw("{").key("name").string(body.name).raw(", ").key("type").raw("\"").raw(typeName(body.type)).raw("\", ");
+    json.key("radius").number(body.radius).raw(", ").key("color").vec3(body.color).raw(", ");
+    json.key("orbit").raw("{").key("semiMajorAxis").number(body.semiMajorAxis);
+    json.raw(", ").key("eccentricity").number(body.eccentricity);
+    json.raw(", ").key("inclination").number(body.inclination);
+    json.raw(", ").key("period").number(body.period);
+    json.raw(", ").key("meanAnomaly").number(body.meanAnomaly);
+    json.raw(", ").key("longitudeAscendingNode").number(body.longitudeAscendingNode);
+    json.raw(", ").key("argumentPeriapsis").number(body.argumentPeriapsis).raw("}");
+}
+
+} // namespace
+
+size_t SystemGenerator::getBodyCount(const GeneratorOptions& options) {
+    return 1 + options.planetCount + moonTotal(options);
+}
+
+GeneratorOptions SystemGenerator::forBodyCount(size_t bodyCount, uint32_t seed) {
+    GeneratorOptions options;
+    options.seed = seed;
+    size_t orbiting = bodyCount > 1 ? bodyCount - 1 : 0;
+    options.planetCount = std::clamp<size_t>(static_cast<size_t>(std::llround(std::sqrt(static_cast<double>(orbiting)))),
+                                             orbiting ? 1 : 0, orbiting);
+    options.moonsPerPlanet = options.planetCount
+        ? static_cast<double>(orbiting - options.planetCount) / static_cast<double>(options.planetCount)
+        : 0.0;
+    return options;
+}
+
+std::unique_ptr<SystemData> SystemGenerator::generate(const GeneratorOptions& options) {
+    auto data = std::make_unique<SystemData>();
+    data->name = systemName(options);
+    data->systemScale = SYSTEM_SCALE;
+    data->planetScale = PLANET_SCALE;
+    data->bodies.reserve(options.planetCount + 1);
+    
+    // Same construction as the loader: angles converted with glm::radians, mass from radius
+    CelestialBody* planet = nullptr;
+    forEachBody(options, [&](const GeneratedBody& spec, int depth) {
+        OrbitalParams orbit{spec.semiMajorAxis, spec.eccentricity, glm::radians(spec.inclination), spec.period,
+                            glm::radians(spec.meanAnomaly), glm::radians(spec.longitudeAscendingNode),
+                            glm::radians(spec.argumentPeriapsis)};
+        auto body = data->arena->create(spec.name, spec.radius, spec.color, orbit, spec.type);
+        body->setMass(spec.radius * spec.radius * spec.radius);
+        if (depth == 0) {
+            planet = body.get();
+            data->bodies.push_back(std::move(body));
+        } else {
+            planet->addChild(std::move(body));
+        }
+    });
+    
+    for (const BeltSpec& belt : planBelts(options)) {
+        ParticlePopulation population;
+        population.name = belt.name;
+        population.color = belt.color;
+        population.pointSize = belt.pointSize;
+        population.opacity = belt.opacity;
+        population.elements = ParticleGenerator::generate(belt.distribution, belt.count, belt.seed);
+        data->populations.push_back(std::move(population));
+    }
+    
+    if (options.testParticleCount > 0) {
+        TestParticleSwarm swarm = planSwarm(options);
+        swarm.parent = data->bodies.front().get();
+        data->testParticles.push_back(std::move(swarm));
+    }
+    
+    size_t particles = options.beltCount * options.particlesPerBelt;
+    LOG_INFO("SystemGenerator", "Generated '", data->name, "': ", getBodyCount(options), " bodies, ",
+             options.beltCount, " belts (", particles, " particles), ", options.testParticleCount, " test particles");
+    return data;
+}
+
+bool SystemGenerator::writeJson(const GeneratorOptions& options, const std::string& filePath) {
+    std::ofstream file(filePath, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("SystemGenerator", "Failed to open ", filePath, " for writing");
+        return false;
+    }
+    
+    JsonWriter json(file);
+    json.raw("{\n  ").key("name").string(systemName(options)).raw(",\n  ");
+    json.key("category").string(CATEGORY).raw(",\n  ");
+    json.key("scale").raw("{").key("system").number(SYSTEM_SCALE).raw(", ").key("planet").number(PLANET_SCALE).raw("},\n  ");
+    
+    // Planets are written when their successor (or the end) arrives, so their moons can be nested
+    json.key("bodies").raw("[");
+    bool first = true;
+    bool openChildren = false;
+    forEachBody(options, [&](const GeneratedBody& spec, int depth) {
+        if (depth == 0) {
+            json.raw(openChildren ? "\n    ]}" : (first ? "" : "}"));
+            json.raw(first ? "\n    " : ",\n    ");
+            writeBody(json, spec);
+            openChildren = false;
+        } else {
+            json.raw(openChildren ? ",\n      " : ", \"children\": [\n      ");
+            writeBody(json, spec);
+            json.raw("}");
+            openChildren = true;
+        }
+        first = false;
+    });
+    json.raw(openChildren ? "\n    ]}" : "}").raw("\n  ]");
+    
+    std::vector<BeltSpec> belts = planBelts(options);
+    if (!belts.empty()) {
+        json.raw(",\n  ").key("populations").raw("[");
+        for (size_t i = 0; i < belts.size(); ++i) {
+            const BeltSpec& belt = belts[i];
+            json.raw(i ? ",\n    {" : "\n    {").key("name").string(belt.name);
+            json.raw(", ").key("count").number(belt.count).raw(", ").key("seed").number(belt.seed);
+            json.raw(", ").key("color").vec3(belt.color).raw(", ").key("pointSize").number(belt.pointSize);
+            json.raw(", ").key("opacity").number(belt.opacity).raw(", ").key("distribution").raw("{");
+            json.key("semiMajorAxis").range(belt.distribution.semiMajorAxis);
+            json.raw(", ").key("eccentricity").range(belt.distribution.eccentricity);
+            json.raw(", ").key("inclination").range(belt.distribution.inclination);
+            json.raw(", ").key("size").range(belt.distribution.size);
+            json.raw(", ").key("centralMass").number(belt.distribution.centralMass).raw("}}");
+        }
+        json.raw("\n  ]");
+    }
+    
+    if (options.testParticleCount > 0) {
+        TestParticleSwarm swarm = planSwarm(options);
+        json.raw(",\n  ").key("testParticles").raw("[\n    {").key("name").string(swarm.name);
+        json.raw(", ").key("parent").string(swarm.parentName).raw(", ").key("count").number(swarm.count);
+        json.raw(", ").key("seed").number(swarm.seed).raw(", ").key("innerRadius").number(swarm.innerRadius);
+        json.raw(", ").key("outerRadius").number(swarm.outerRadius).raw(", ").key("thickness").number(swarm.thickness);
+        json.raw(", ").key("captureRadius").number(swarm.captureRadius).raw(", ").key("color").vec3(swarm.color);
+        json.raw(", ").key("pointSize").number(swarm.pointSize).raw(", ").key("opacity").number(swarm.opacity);
+        json.raw("}\n  ]");
+    }
+    json.raw("\n}\n");
+    
+    if (!file) {
+        LOG_ERROR("SystemGenerator", "Failed to write ", filePath);
+        return false;
+    }
+    LOG_INFO("SystemGenerator", "Wrote ", filePath, " (", getBodyCount(options), " bodies)");
+    return true;
+}
+
+bool SystemGenerator::writeCompiled(const GeneratorOptions& options, const std::string& filePath) {
+    auto data = generate(options);
+    return CompiledSystem::write(*data, filePath);
+}
+
+} // namespace Simulation
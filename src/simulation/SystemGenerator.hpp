@@ -0,0 +1,51 @@
+#pragma once
+
+#include "SystemLoader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Simulation {
+
+/// Shape of a procedurally generated system
+struct GeneratorOptions {
+    uint32_t seed = 1;
+    std::string name;                 // Empty: "Generated <seed>"
+    size_t planetCount = 8;
+    double moonsPerPlanet = 2.0;      // Average: round(planets * this) moons, spread evenly
+    size_t beltCount = 1;
+    size_t particlesPerBelt = 100000;
+    size_t testParticleCount = 0;     // One swarm around the star (N-body mode)
+    double starMass = 1.0;            // Solar masses
+};
+
+/// Seeded generator of synthetic systems for stress and scaling tests.
+///
+/// A star with planets and moons on Kepler orbits, drawn from observed
+/// element distributions (log-uniform semi-major axes and masses, Rayleigh
+/// eccentricities and inclinations, mass-radius relation), plus particle
+/// belts and an optional test-particle swarm. Output depends only on the
+/// options: the same seed gives the same system in memory, as JSON (which
+/// loads back bit-identically) or as a compiled file.
+class SystemGenerator {
+public:
+    static constexpr const char* CATEGORY = "Generated";
+
+    static std::unique_ptr<SystemData> generate(const GeneratorOptions& options);
+
+    /// Stream the system as JSON (belts as seeded distributions, not element lists)
+    static bool writeJson(const GeneratorOptions& options, const std::string& filePath);
+
+    /// Generate and write a compiled (.ssb) system
+    static bool writeCompiled(const GeneratorOptions& options, const std::string& filePath);
+
+    /// Planet and moon counts giving exactly `bodyCount` bodies (star included),
+    /// about sqrt(bodyCount) planets with the rest as moons
+    static GeneratorOptions forBodyCount(size_t bodyCount, uint32_t seed = 1);
+
+    /// Bodies the options produce, star included
+    static size_t getBodyCount(const GeneratorOptions& options);
+};
+
+} // namespace Simulation
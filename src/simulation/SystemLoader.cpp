@@ -1,142 +1,124 @@
 #include "SystemLoader.hpp"
-#include "third_party/json.hpp"
+#include "CompiledSystem.hpp"
+#include "DerivedData.hpp"
+#include "SystemStreamParser.hpp"
+#include "core/AllocationTracker.hpp"
 #include "core/Logger.hpp"
-#include <fstream>
-#include <filesystem>
+#include "core/MappedFile.hpp"
+#include "core/MemoryStats.hpp"
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
 
 namespace Simulation {
 
-using json = nlohmann::json;
-
-// Helper function to parse BodyType from string
-BodyType parseBodyType(const std::string& typeStr) {
-    static const std::unordered_map<std::string, BodyType> typeMap = {
-        {"star", BodyType::Star},
-        {"planet", BodyType::Planet},
-        {"moon", BodyType::Moon},
-        {"dwarf_planet", BodyType::DwarfPlanet},
-        {"asteroid", BodyType::Asteroid},
-        {"comet", BodyType::Comet},
-        {"black_hole", BodyType::BlackHole},
-        {"other", BodyType::Other}
-    };
+std::unique_ptr<SystemData> SystemLoader::loadFromFile(const std::string& filePath, LoadControl* control) {
+    Core::AllocationScope allocationScope(Core::AllocationTag::Loader);
+    namespace fs = std::filesystem;
+    if (fs::path(filePath).extension() == CompiledSystem::FILE_EXTENSION) {
+        return loadCompiled(filePath, control, true);
+    }
     
-    auto it = typeMap.find(typeStr);
-    return (it != typeMap.end()) ? it->second : BodyType::Planet;
+    // Prefer the compiled file unless the JSON was edited after it was built
+    std::string compiledPath = getCompiledPath(filePath);
+    std::error_code error;
+    if (fs::exists(compiledPath, error)) {
+        auto jsonTime = fs::last_write_time(filePath, error);
+        bool jsonMissing = static_cast<bool>(error);
+        auto compiledTime = fs::last_write_time(compiledPath, error);
+        if (!error && (jsonMissing || compiledTime > jsonTime)) {
+            if (auto data = loadCompiled(compiledPath, control, true)) {
+                return data;
+            }
+            if (control && control->isCancelled()) {
+                return nullptr;
+            }
+            LOG_WARN("SystemLoader", "Falling back to JSON for ", filePath);
+        } else if (!error) {
+            LOG_INFO("SystemLoader", compiledPath, " is older than ", filePath, ", parsing JSON");
+        }
+    }
+    
+    return loadFromJson(filePath, control, true);
 }
 
-std::unique_ptr<CelestialBody> parseBody(const json& bodyJson, bool isChild = false) {
-    std::string name = bodyJson.at("name").get<std::string>();
-    double radius = bodyJson.at("radius").get<double>();
-    
-    auto colorArr = bodyJson.at("color");
-    glm::vec3 color(
-        colorArr[0].get<float>(),
-        colorArr[1].get<float>(),
-        colorArr[2].get<float>()
-    );
-    
-    auto orbitJson = bodyJson.at("orbit");
-    OrbitalParams orbit{
-        orbitJson.at("semiMajorAxis").get<double>(),
-        orbitJson.at("eccentricity").get<double>(),
-        glm::radians(orbitJson.at("inclination").get<double>()),
-        orbitJson.at("period").get<double>(),
-        glm::radians(orbitJson.at("meanAnomaly").get<double>()),
-        glm::radians(orbitJson.at("longitudeAscendingNode").get<double>()),
-        glm::radians(orbitJson.at("argumentPeriapsis").get<double>())
-    };
-    
-    // Determine body type
-    BodyType bodyType = BodyType::Planet;
-    if (bodyJson.contains("type")) {
-        bodyType = parseBodyType(bodyJson.at("type").get<std::string>());
-    } else if (isChild) {
-        bodyType = BodyType::Moon;  // Default children to moons
+std::unique_ptr<SystemData> SystemLoader::loadCompiled(const std::string& filePath, LoadControl* control,
+                                                      bool useDerivedCache) {
+    auto compiled = std::make_shared<CompiledSystem>();
+    if (!compiled->open(filePath)) {
+        return nullptr;
     }
     
-    auto body = std::make_unique<CelestialBody>(name, radius, color, orbit, bodyType);
-    
-    // Parse mass if provided, else estimate from radius
-    if (bodyJson.contains("mass")) {
-        body->setMass(bodyJson.at("mass").get<double>());
-    } else {
-        body->setMass(radius * radius * radius);
+    auto data = compiled->instantiate(control);
+    if (!data) {
+        LOG_INFO("SystemLoader", "Load of ", filePath, " cancelled");
+        return nullptr;
     }
-    
-    // Parse children (moons)
-    if (bodyJson.contains("children")) {
-        for (const auto& childJson : bodyJson.at("children")) {
-            body->addChild(parseBody(childJson, true));
-        }
+    data->compiled = compiled;
+    if (useDerivedCache) {
+        // Particle elements are already stored in the compiled file; only orbit paths are derived
+        uint64_t hash = DerivedDataCache::hashContent(compiled->getData(), compiled->getSize());
+        DerivedDataCache::attach(filePath, hash, DerivedDataCache::load(filePath, hash), *data, false, control);
     }
-    
-    return body;
+    LOG_INFO("SystemLoader", "Loaded compiled system '", data->name, "' with ", data->bodies.size(),
+             " bodies from ", filePath);
+    return data;
+}
+
+std::string SystemLoader::getCompiledPath(const std::string& jsonPath) {
+    return std::filesystem::path(jsonPath).replace_extension(CompiledSystem::FILE_EXTENSION).string();
 }
 
-std::unique_ptr<SystemData> SystemLoader::loadFromFile(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+std::unique_ptr<SystemData> SystemLoader::loadFromJson(const std::string& filePath, LoadControl* control,
+                                                      bool useDerivedCache) {
+    // Parse straight from the mapped file: no stream buffering and no DOM
+    Core::MappedFile file;
+    if (!file.open(filePath)) {
         LOG_ERROR("SystemLoader", "Failed to open file: ", filePath);
         return nullptr;
     }
     
-    try {
-        json j = json::parse(file);
-        
-        auto data = std::make_unique<SystemData>();
-        data->name = j.at("name").get<std::string>();
-        data->systemScale = j.at("scale").at("system").get<float>();
-        data->planetScale = j.at("scale").at("planet").get<float>();
-        
-        for (const auto& bodyJson : j.at("bodies")) {
-            data->bodies.push_back(parseBody(bodyJson));
-        }
-        
-        LOG_INFO("SystemLoader", "Loaded system '", data->name, "' with ", data->bodies.size(), " bodies");
-        
-        return data;
-    } catch (const json::exception& e) {
-        LOG_ERROR("SystemLoader", "JSON parse error in ", filePath, ": ", e.what());
+    auto start = std::chrono::steady_clock::now();
+    
+    // Derived data is keyed by the file's bytes, so any edit invalidates it
+    uint64_t hash = 0;
+    std::shared_ptr<const DerivedData> cached;
+    if (useDerivedCache) {
+        hash = DerivedDataCache::hashContent(file.data(), file.size());
+        cached = DerivedDataCache::load(filePath, hash);
+    }
+    
+    const char* text = reinterpret_cast<const char*>(file.data());
+    std::string error;
+    auto data = SystemStreamParser::parse(text, text + file.size(), error, control, cached.get());
+    if (!data && control && control->isCancelled()) {
+        LOG_INFO("SystemLoader", "Load of ", filePath, " cancelled");
         return nullptr;
     }
-}
-
-std::string SystemLoader::getSystemFilePath(const std::string& systemName) {
-    // Map display names to file names
-    static const std::unordered_map<std::string, std::string> nameToFile = {
-        {"Solar System", "solar_system.json"},
-        {"TRAPPIST-1", "trappist1.json"},
-        {"Kepler-90", "kepler90.json"},
-        {"HR 8799", "hr8799.json"},
-        {"Kepler-11", "kepler11.json"},
-        {"55 Cancri", "55cancri.json"}
-    };
+    if (!data) {
+        LOG_ERROR("SystemLoader", "JSON parse error in ", filePath, ": ", error);
+        return nullptr;
+    }
+    if (useDerivedCache) {
+        DerivedDataCache::attach(filePath, hash, std::move(cached), *data, true, control);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     
-    auto it = nameToFile.find(systemName);
-    if (it != nameToFile.end()) {
-        return "assets/systems/" + it->second;
+    constexpr double MB = 1024.0 * 1024.0;
+    double fileMb = static_cast<double>(file.size()) / MB;
+    LOG_INFO("SystemLoader", "Loaded system '", data->name, "' with ", data->bodies.size(), " bodies (",
+             fileMb, " MB in ", seconds * 1000.0, " ms, ", fileMb / std::max(seconds, 1e-9), " MB/s, peak RSS ",
+             static_cast<double>(Core::MemoryStats::getPeakRss()) / MB, " MB)");
+    if (!data->populations.empty()) {
+        size_t particleCount = 0;
+        for (const auto& population : data->populations) {
+            particleCount += population.getElements().size();
+        }
+        LOG_INFO("SystemLoader", "  plus ", data->populations.size(), " particle populations (",
+                 particleCount, " particles)");
     }
     
-    // Fallback: convert name to lowercase, replace spaces with underscores
-    std::string fileName = systemName;
-    std::transform(fileName.begin(), fileName.end(), fileName.begin(), ::tolower);
-    std::replace(fileName.begin(), fileName.end(), ' ', '_');
-    return "assets/systems/" + fileName + ".json";
-}
-
-std::vector<std::string> SystemLoader::getAvailableSystems() {
-    return {
-        "Solar System",
-        "TRAPPIST-1",
-        "Kepler-90",
-        "Kepler-11",
-        "55 Cancri",
-        "HR 8799",
-        "Black Hole",
-        "Binary Star"
-    };
+    return data;
 }
 
 } // namespace Simulation
@@ -1,31 +1,62 @@
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <stop_token>
 #include <vector>
 #include <memory>
+#include "BodyArena.hpp"
 #include "CelestialBody.hpp"
+#include "ParticlePopulation.hpp"
 
 namespace Simulation {
 
+class CompiledSystem;
+class DerivedData;
+
 struct SystemData {
     std::string name;
     float systemScale = 10.0f;
     float planetScale = 1.0f;
-    std::vector<std::unique_ptr<CelestialBody>> bodies;
+    std::unique_ptr<BodyArena> arena = std::make_unique<BodyArena>();   // Owns the bodies (destroyed after them)
+    std::vector<BodyPtr> bodies;
+    std::vector<ParticlePopulation> populations;
+    std::vector<TestParticleSwarm> testParticles;
+    std::shared_ptr<const DerivedData> derived;   // Orbit paths the bodies point into
+    std::shared_ptr<const CompiledSystem> compiled; // Mapping the populations' elements point into
+};
+
+/// Progress reporting and cooperative cancellation for loads on a background
+/// thread. Loaders poll isCancelled() between units of work and give up with
+/// nullptr once it is set.
+struct LoadControl {
+    std::stop_token stopToken;
+    std::atomic<float> progress{0.0f};     // 0..1
+    
+    bool isCancelled() const { return stopToken.stop_requested(); }
+    void report(float fraction) { progress.store(fraction, std::memory_order_relaxed); }
 };
 
 class SystemLoader {
 public:
-    // Load system from JSON file
-    // Returns nullptr if file not found or parse error
-    static std::unique_ptr<SystemData> loadFromFile(const std::string& filePath);
+    // Load system from a JSON or compiled (.ssb) file. For JSON, a sibling .ssb
+    // that is newer than the JSON is mapped instead of parsing the JSON.
+    // Derived data (orbit paths, generated particles) comes from the on-disk cache.
+    // Returns nullptr if file not found, parse error or cancelled through `control`
+    static std::unique_ptr<SystemData> loadFromFile(const std::string& filePath, LoadControl* control = nullptr);
     
-    // Get the file path for a system name
-    static std::string getSystemFilePath(const std::string& systemName);
+    // Always parse the JSON description (used by the systemc compiler). With
+    // `useDerivedCache`, derived data is read from / written to DerivedDataCache.
+    static std::unique_ptr<SystemData> loadFromJson(const std::string& filePath, LoadControl* control = nullptr,
+                                                    bool useDerivedCache = false);
+    
+    // Map a compiled system file and build its bodies from the mapped arrays
+    static std::unique_ptr<SystemData> loadCompiled(const std::string& filePath, LoadControl* control = nullptr,
+                                                    bool useDerivedCache = false);
+    
+    // Path of the compiled file that belongs to a JSON system file
+    static std::string getCompiledPath(const std::string& jsonPath);
     
-    // List available system names
-    static std::vector<std::string> getAvailableSystems();
-
 };
 
 } // namespace Simulation
@@ -0,0 +1,423 @@
+#include "SystemRegistry.hpp"
+#include "CompiledSystem.hpp"
+#include "third_party/json.hpp"
+#include "core/Logger.hpp"
+#include "core/MappedFile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+namespace Simulation {
+
+namespace {
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+constexpr const char* APP_DIRECTORY = "space_sim";
+
+/// Collects the name, category, scale and body count of a system JSON without
+/// building anything. Top-level keys may come in any order, so the parse only
+/// stops early once name, category and scale have all been seen: after the
+/// top-level body list, or at its key when the body count comes from a compiled
+/// file instead.
+class HeaderSaxHandler : public json::json_sax_t {
+public:
+    HeaderSaxHandler(SystemInfo& info, bool stopAtBodies)
+        : m_info(info), m_stopAtBodies(stopAtBodies) {}
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(json::number_integer_t value) override { return number(static_cast<double>(value)); }
+    bool number_unsigned(json::number_unsigned_t value) override { return number(static_cast<double>(value)); }
+    bool number_float(json::number_float_t value, const json::string_t&) override { return number(value); }
+    bool binary(json::binary_t&) override { return true; }
+
+    bool string(json::string_t& value) override {
+        if (m_frames.size() == 1) {
+            if (m_key == "name") m_info.name = value;
+            else if (m_key == "category") {
+                m_info.category = value;
+                m_hasCategory = true;
+            }
+        }
+        return true;
+    }
+
+    bool key(json::string_t& value) override {
+        m_key.assign(value);
+        if (m_stopAtBodies && m_frames.size() == 1 && m_key == "bodies" && hasHeader()) {
+            return stop();
+        }
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        Frame frame = Frame::Other;
+        if (m_frames.empty()) {
+            frame = Frame::Root;
+        } else if (m_frames.back() == Frame::BodyArray) {
+            frame = Frame::Body;
+            ++m_info.bodyCount;
+        } else if (m_frames.back() == Frame::Root && m_key == "scale") {
+            frame = Frame::Scale;
+            m_hasScale = true;
+        }
+        m_frames.push_back(frame);
+        return true;
+    }
+
+    bool end_object() override {
+        m_frames.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        bool bodies = !m_frames.empty() &&
+            ((m_frames.back() == Frame::Root && m_key == "bodies") ||
+             (m_frames.back() == Frame::Body && m_key == "children"));
+        m_frames.push_back(bodies ? Frame::BodyArray : Frame::Other);
+        return true;
+    }
+
+    bool end_array() override {
+        bool topLevelBodies = m_frames.size() == 2 && m_frames.back() == Frame::BodyArray;
+        m_frames.pop_back();
+        // Everything after the body list (populations, swarms, catalogs) is irrelevant
+        if (topLevelBodies && hasHeader()) {
+            return stop();
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+        return false;
+    }
+
+    bool isStopped() const { return m_stopped; }
+
+private:
+    enum class Frame { Root, Scale, BodyArray, Body, Other };
+
+    bool number(double value) {
+        if (!m_frames.empty() && m_frames.back() == Frame::Scale) {
+            if (m_key == "system") m_info.systemScale = static_cast<float>(value);
+            else if (m_key == "planet") m_info.planetScale = static_cast<float>(value);
+        }
+        return true;
+    }
+
+    bool hasHeader() const {
+        return !m_info.name.empty() && m_hasCategory && m_hasScale;
+    }
+
+    bool stop() {
+        m_stopped = true;
+        return false;
+    }
+
+    SystemInfo& m_info;
+    bool m_stopAtBodies;
+    bool m_stopped = false;
+    bool m_hasCategory = false;
+    bool m_hasScale = false;
+    std::string m_key;
+    std::vector<Frame> m_frames;
+};
+
+bool readJsonHeader(const std::string& filePath, SystemInfo& info, bool stopAtBodies) {
+    Core::MappedFile file;
+    if (!file.open(filePath)) {
+        return false;
+    }
+    const char* begin = reinterpret_cast<const char*>(file.data());
+    HeaderSaxHandler handler(info, stopAtBodies);
+    bool parsed = json::sax_parse(begin, begin + file.size(), &handler);
+    return (parsed || handler.isStopped()) && !info.name.empty();
+}
+
+std::string environmentPath(const char* variable, const char* homeFallback) {
+    if (const char* value = std::getenv(variable); value && *value) {
+        return (fs::path(value) / APP_DIRECTORY).string();
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return (fs::path(home) / homeFallback / APP_DIRECTORY).string();
+    }
+    return {};
+}
+
+} // namespace
+
+SystemRegistry::SystemRegistry()
+    : m_indexPath(getDefaultIndexPath()) {
+    m_directories.push_back(DEFAULT_DIRECTORY);
+    std::string userDirectory = getUserDirectory();
+    if (!userDirectory.empty()) {
+        m_directories.push_back(userDirectory);
+    }
+}
+
+std::string SystemRegistry::getUserDirectory() {
+    std::string base = environmentPath("XDG_DATA_HOME", ".local/share");
+    return base.empty() ? base : (fs::path(base) / "systems").string();
+}
+
+std::string SystemRegistry::getDefaultIndexPath() {
+    std::string base = environmentPath("XDG_CACHE_HOME", ".cache");
+    return base.empty() ? base : (fs::path(base) / "system_index.json").string();
+}
+
+void SystemRegistry::addDirectory(const std::string& directory) {
+    if (std::find(m_directories.begin(), m_directories.end(), directory) == m_directories.end()) {
+        m_directories.push_back(directory);
+    }
+}
+
+bool SystemRegistry::readHeader(const std::string& filePath, SystemInfo& info) {
+    info.name.clear();
+    info.category.clear();
+    info.bodyCount = 0;
+    
+    if (fs::path(filePath).extension() == CompiledSystem::FILE_EXTENSION) {
+        CompiledSystemHeader header;
+        if (!CompiledSystem::readHeader(filePath, header, info.name)) {
+            return false;
+        }
+        info.bodyCount = header.bodyCount;
+        info.systemScale = header.systemScale;
+        info.planetScale = header.planetScale;
+        info.category = DEFAULT_CATEGORY;
+        return !info.name.empty();
+    }
+    
+    // An up-to-date compiled sibling has the body count (catalogs included), so
+    // the JSON is only read up to its body list
+    std::string compiledPath = SystemLoader::getCompiledPath(filePath);
+    CompiledSystemHeader header;
+    std::string compiledName;
+    bool compiledCurrent = false;
+    std::error_code error;
+    if (fs::exists(compiledPath, error)) {
+        std::error_code jsonError;
+        auto compiledTime = fs::last_write_time(compiledPath, error);
+        auto jsonTime = fs::last_write_time(filePath, jsonError);
+        compiledCurrent = !error && !jsonError && compiledTime > jsonTime &&
+                          CompiledSystem::readHeader(compiledPath, header, compiledName);
+    }
+    
+    if (!readJsonHeader(filePath, info, compiledCurrent)) {
+        return false;
+    }
+    if (compiledCurrent) {
+        info.bodyCount = header.bodyCount;
+    }
+    if (info.category.empty()) {
+        info.category = DEFAULT_CATEGORY;
+    }
+    return true;
+}
+
+void SystemRegistry::scan() {
+    auto start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, SystemInfo> index = loadIndex();
+    
+    std::vector<SystemInfo> entries;    // Every file seen, for the index
+    std::vector<SystemInfo> systems;
+    std::unordered_set<std::string> names;
+    m_headerReads = 0;
+    bool indexChanged = false;
+    
+    for (const auto& directory : m_directories) {
+        std::error_code error;
+        if (!fs::is_directory(directory, error)) continue;
+        
+        // A JSON and its compiled sibling are one system (the loader picks the file)
+        std::vector<fs::path> files;
+        for (const auto& entry : fs::directory_iterator(directory, error)) {
+            const fs::path& path = entry.path();
+            if (!entry.is_regular_file(error)) continue;
+            if (path.extension() == ".json") {
+                files.push_back(path);
+            } else if (path.extension() == CompiledSystem::FILE_EXTENSION &&
+                       !fs::exists(fs::path(path).replace_extension(".json"), error)) {
+                files.push_back(path);
+            }
+        }
+        std::sort(files.begin(), files.end());
+        
+        for (const auto& path : files) {
+            SystemInfo info;
+            info.filePath = path.string();
+            info.fileSize = fs::file_size(path, error);
+            if (error) continue;
+            info.modifiedTime = fs::last_write_time(path, error).time_since_epoch().count();
+            if (error) continue;
+            if (path.extension() == ".json") {
+                fs::path compiledPath = SystemLoader::getCompiledPath(info.filePath);
+                std::error_code sizeError, timeError;
+                uint64_t compiledSize = fs::file_size(compiledPath, sizeError);
+                auto compiledTime = fs::last_write_time(compiledPath, timeError);
+                if (!sizeError && !timeError) {
+                    info.compiledSize = compiledSize;
+                    info.compiledModifiedTime = compiledTime.time_since_epoch().count();
+                }
+            }
+            
+            auto cached = index.find(info.filePath);
+            if (cached != index.end() && cached->second.fileSize == info.fileSize &&
+                cached->second.modifiedTime == info.modifiedTime &&
+                cached->second.compiledSize == info.compiledSize &&
+                cached->second.compiledModifiedTime == info.compiledModifiedTime) {
+                info = cached->second;
+            } else {
+                // Unreadable files are indexed too (with no name) so they aren't re-read every scan
+                if (!readHeader(info.filePath, info)) {
+                    LOG_WARN("SystemRegistry", "Skipping ", info.filePath, ": not a system file");
+                    info.name.clear();
+                }
+                ++m_headerReads;
+                indexChanged = true;
+            }
+            entries.push_back(info);
+            
+            if (info.name.empty()) continue;
+            if (!names.insert(info.name).second) {
+                LOG_WARN("SystemRegistry", "Ignoring ", info.filePath, ": system '", info.name, "' already found");
+                continue;
+            }
+            systems.push_back(std::move(info));
+        }
+    }
+    if (entries.size() != index.size()) {
+        indexChanged = true;    // Files were removed
+    }
+    
+    std::sort(systems.begin(), systems.end(), [](const SystemInfo& a, const SystemInfo& b) {
+        bool aDefault = a.category == DEFAULT_CATEGORY;
+        bool bDefault = b.category == DEFAULT_CATEGORY;
+        if (aDefault != bDefault) return aDefault;
+        if (a.category != b.category) return a.category < b.category;
+        return a.name < b.name;
+    });
+    
+    m_systems = std::move(systems);
+    m_categories.clear();
+    m_byName.clear();
+    for (size_t i = 0; i < m_systems.size(); ++i) {
+        if (m_categories.empty() || m_categories.back() != m_systems[i].category) {
+            m_categories.push_back(m_systems[i].category);
+        }
+        m_byName.emplace(m_systems[i].name, i);
+    }
+    
+    if (indexChanged) {
+        saveIndex(entries);
+    }
+    
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO("SystemRegistry", "Found ", m_systems.size(), " systems in ", m_directories.size(),
+             " directories (", m_headerReads, " headers read, ", ms, " ms)");
+}
+
+std::vector<std::string> SystemRegistry::getSystemNames() const {
+    std::vector<std::string> names;
+    names.reserve(m_systems.size());
+    for (const auto& info : m_systems) {
+        names.push_back(info.name);
+    }
+    return names;
+}
+
+const SystemInfo* SystemRegistry::find(const std::string& systemName) const {
+    auto it = m_byName.find(systemName);
+    return it != m_byName.end() ? &m_systems[it->second] : nullptr;
+}
+
+std::string SystemRegistry::getFilePath(const std::string& systemName) const {
+    const SystemInfo* info = find(systemName);
+    return info ? info->filePath : std::string();
+}
+
+std::unordered_map<std::string, SystemInfo> SystemRegistry::loadIndex() const {
+    std::unordered_map<std::string, SystemInfo> index;
+    if (m_indexPath.empty()) return index;
+    
+    std::ifstream file(m_indexPath);
+    if (!file.is_open()) return index;
+    
+    json root = json::parse(file, nullptr, false);
+    auto version = root.is_object() ? root.find("version") : root.end();
+    auto entries = root.is_object() ? root.find("entries") : root.end();
+    if (version == root.end() || *version != INDEX_VERSION ||
+        entries == root.end() || !entries->is_array()) {
+        LOG_WARN("SystemRegistry", "Ignoring outdated or corrupt index ", m_indexPath);
+        return index;
+    }
+    
+    for (const auto& entry : *entries) {
+        if (!entry.is_object()) continue;
+        // A mistyped field only costs that entry; its file is re-read by scan()
+        try {
+            SystemInfo info;
+            info.filePath = entry.value("path", "");
+            info.name = entry.value("name", "");
+            info.category = entry.value("category", DEFAULT_CATEGORY);
+            info.bodyCount = entry.value("bodies", 0u);
+            info.systemScale = entry.value("systemScale", 10.0f);
+            info.planetScale = entry.value("planetScale", 1.0f);
+            info.fileSize = entry.value("size", uint64_t{0});
+            info.modifiedTime = entry.value("mtime", int64_t{0});
+            info.compiledSize = entry.value("compiledSize", uint64_t{0});
+            info.compiledModifiedTime = entry.value("compiledMtime", int64_t{0});
+            if (!info.filePath.empty()) {
+                index.emplace(info.filePath, std::move(info));
+            }
+        } catch (const json::exception&) {
+            continue;
+        }
+    }
+    return index;
+}
+
+void SystemRegistry::saveIndex(const std::vector<SystemInfo>& entries) const {
+    if (m_indexPath.empty()) return;
+    
+    json list = json::array();
+    for (const auto& info : entries) {
+        list.push_back({
+            {"path", info.filePath},
+            {"name", info.name},
+            {"category", info.category},
+            {"bodies", info.bodyCount},
+            {"systemScale", info.systemScale},
+            {"planetScale", info.planetScale},
+            {"size", info.fileSize},
+            {"mtime", info.modifiedTime},
+            {"compiledSize", info.compiledSize},
+            {"compiledMtime", info.compiledModifiedTime}
+        });
+    }
+    json root = {{"version", INDEX_VERSION}, {"entries", std::move(list)}};
+    
+    // Written beside the index and renamed, so a concurrent reader never sees half a file
+    std::error_code error;
+    fs::create_directories(fs::path(m_indexPath).parent_path(), error);
+    std::string tempPath = m_indexPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!(file << root.dump(1))) {
+            LOG_WARN("SystemRegistry", "Could not write index ", m_indexPath);
+            return;
+        }
+    }
+    fs::rename(tempPath, m_indexPath, error);
+    if (error) {
+        LOG_WARN("SystemRegistry", "Could not write index ", m_indexPath, ": ", error.message());
+        fs::remove(tempPath, error);
+    }
+}
+
+} // namespace Simulation
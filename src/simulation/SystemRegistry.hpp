@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Simulation {
+
+/// What the selection list needs to know about a system file, read from its
+/// header without loading the bodies
+struct SystemInfo {
+    std::string name;               // Display name from the file (empty: unreadable file)
+    std::string category;
+    std::string filePath;
+    uint32_t bodyCount = 0;         // Bodies declared in the file (plus imported catalogs when compiled)
+    float systemScale = 10.0f;
+    float planetScale = 1.0f;
+    uint64_t fileSize = 0;
+    int64_t modifiedTime = 0;       // Filesystem clock ticks
+    uint64_t compiledSize = 0;      // Compiled sibling of a JSON file (0: none)
+    int64_t compiledModifiedTime = 0;
+};
+
+/// Systems found by scanning directories for .json and .ssb files.
+///
+/// Only each file's header is read: the JSON is parsed up to the end of its
+/// body list with nothing built, and compiled files are read just for their
+/// header. The results are kept in an index file keyed by path, size and
+/// modification time (plus those of a JSON file's compiled sibling, which
+/// supplies its body count), so later scans only stat the files and re-read
+/// the ones that changed.
+class SystemRegistry {
+public:
+    static constexpr const char* DEFAULT_DIRECTORY = "assets/systems";
+    static constexpr const char* DEFAULT_CATEGORY = "Planetary Systems";
+    static constexpr int INDEX_VERSION = 2;
+
+    /// Scans the bundled assets and the user's data directory, with the index
+    /// in the user's cache directory
+    SystemRegistry();
+
+    /// Additional directory to scan; earlier directories win on duplicate names
+    void addDirectory(const std::string& directory);
+    const std::vector<std::string>& getDirectories() const { return m_directories; }
+
+    /// Where the metadata index is kept (empty: always read every header)
+    void setIndexPath(const std::string& indexPath) { m_indexPath = indexPath; }
+    const std::string& getIndexPath() const { return m_indexPath; }
+
+    /// Rebuild the system list from the directories (main thread only)
+    void scan();
+
+    /// Sorted by category (default category first), then name
+    const std::vector<SystemInfo>& getSystems() const { return m_systems; }
+    const std::vector<std::string>& getCategories() const { return m_categories; }
+    std::vector<std::string> getSystemNames() const;
+
+    const SystemInfo* find(const std::string& systemName) const;
+
+    /// File for a system name, or empty if no scanned file declares it
+    std::string getFilePath(const std::string& systemName) const;
+
+    /// Files whose header had to be read during the last scan (index misses)
+    size_t getHeaderReads() const { return m_headerReads; }
+
+    /// Read the metadata of one system file. Returns false if it isn't a system.
+    static bool readHeader(const std::string& filePath, SystemInfo& info);
+
+    static std::string getUserDirectory();
+    static std::string getDefaultIndexPath();
+
+private:
+    std::unordered_map<std::string, SystemInfo> loadIndex() const;
+    void saveIndex(const std::vector<SystemInfo>& entries) const;
+
+    std::vector<std::string> m_directories;
+    std::string m_indexPath;
+    std::vector<SystemInfo> m_systems;
+    std::vector<std::string> m_categories;
+    std::unordered_map<std::string, size_t> m_byName;
+    size_t m_headerReads = 0;
+};
+
+} // namespace Simulation
@@ -0,0 +1,579 @@
+#include "SystemStreamParser.hpp"
+#include "CatalogImporter.hpp"
+#include "DerivedData.hpp"
+#include "third_party/json.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <unordered_map>
+
+namespace Simulation {
+
+namespace {
+
+using json = nlohmann::json;
+
+constexpr float PARSE_PROGRESS_SHARE = 0.8f;    // Rest is population generation and catalogs
+constexpr std::ptrdiff_t PROGRESS_MASK = 0xFFFF; // Report every 64 KiB
+
+/// Character iterator that reports how far the parser has read. Only used for
+/// background loads; foreground parses iterate the raw pointers.
+struct ProgressIterator {
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = char;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const char*;
+    using reference = const char&;
+    
+    const char* current = nullptr;
+    const char* begin = nullptr;
+    float scale = 0.0f;             // Progress per byte
+    LoadControl* control = nullptr;
+    
+    reference operator*() const { return *current; }
+    ProgressIterator& operator++() {
+        ++current;
+        if (((current - begin) & PROGRESS_MASK) == 0) {
+            control->report(static_cast<float>(current - begin) * scale);
+        }
+        return *this;
+    }
+    ProgressIterator operator++(int) {
+        ProgressIterator previous = *this;
+        ++*this;
+        return previous;
+    }
+    bool operator==(const ProgressIterator& other) const { return current == other.current; }
+};
+
+// Helper function to parse BodyType from string
+BodyType parseBodyType(const std::string& typeStr) {
+    static const std::unordered_map<std::string, BodyType> typeMap = {
+        {"star", BodyType::Star},
+        {"planet", BodyType::Planet},
+        {"moon", BodyType::Moon},
+        {"dwarf_planet", BodyType::DwarfPlanet},
+        {"asteroid", BodyType::Asteroid},
+        {"comet", BodyType::Comet},
+        {"black_hole", BodyType::BlackHole},
+        {"other", BodyType::Other}
+    };
+    
+    auto it = typeMap.find(typeStr);
+    return (it != typeMap.end()) ? it->second : BodyType::Planet;
+}
+
+const CelestialBody* findBodyByName(std::span<const BodyPtr> bodies, std::string_view name) {
+    for (const auto& body : bodies) {
+        if (body->getName() == name) return body.get();
+        if (const CelestialBody* found = findBodyByName(body->getChildren(), name)) return found;
+    }
+    return nullptr;
+}
+
+/// What the innermost open object or array describes
+enum class Context {
+    Root, Scale, Bodies, Body, Orbit, Numbers,
+    Populations, Population, Distribution, Swarms, Swarm, Catalogs, Catalog,
+    Skip        // Unknown key: consume the subtree without looking at it
+};
+
+struct Frame {
+    Context context;
+    std::array<float*, 3> targets{};   // Numbers: destinations of the array elements
+    size_t count = 0;
+    size_t index = 0;
+};
+
+// Required body fields, tracked as bits while the body's object is open
+constexpr const char* BODY_FIELDS[] = {
+    "name", "radius", "color", "orbit.semiMajorAxis", "orbit.eccentricity", "orbit.inclination",
+    "orbit.period", "orbit.meanAnomaly", "orbit.longitudeAscendingNode", "orbit.argumentPeriapsis"
+};
+enum BodyField : uint32_t {
+    FIELD_NAME = 1u << 0,
+    FIELD_RADIUS = 1u << 1,
+    FIELD_COLOR = 1u << 2,
+    FIELD_ORBIT = 1u << 3,      // First of the seven orbit fields, in BODY_FIELDS order
+    BODY_REQUIRED = (1u << std::size(BODY_FIELDS)) - 1
+};
+
+struct BodySpec {
+    std::string name;
+    double radius = 0.0;
+    glm::vec3 color{0.0f};
+    OrbitalParams orbit{};
+    BodyType type = BodyType::Planet;
+    bool hasType = false;
+    double mass = 0.0;
+    bool hasMass = false;
+    uint32_t fields = 0;
+    std::vector<BodyPtr> children;
+};
+
+struct PopulationSpec {
+    ParticlePopulation population;
+    std::string file;
+    ParticleDistribution distribution;
+    size_t count = 0;
+    bool hasCount = false;
+    bool hasDistribution = false;
+    uint32_t seed = 1;
+};
+
+struct SwarmSpec {
+    TestParticleSwarm swarm;
+    bool hasCount = false;
+};
+
+struct CatalogSpec {
+    std::string file;
+    CatalogImportOptions options;
+};
+
+/// Builds SystemData from SAX events. Open bodies form a stack, so children are
+/// complete (and owned by their parent's spec) before the parent is constructed.
+class SystemSaxHandler : public json::json_sax_t {
+public:
+    SystemSaxHandler(LoadControl* control, const DerivedData* derived)
+        : m_data(std::make_unique<SystemData>()), m_control(control), m_derived(derived) {}
+
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(json::number_integer_t value) override { return number(static_cast<double>(value)); }
+    bool number_unsigned(json::number_unsigned_t value) override { return number(static_cast<double>(value)); }
+    bool number_float(json::number_float_t value, const json::string_t&) override { return number(value); }
+    bool string(json::string_t& value) override;
+    bool binary(json::binary_t&) override { return true; }
+    bool key(json::string_t& value) override {
+        m_key.assign(value);
+        return true;
+    }
+    bool start_object(std::size_t) override;
+    bool end_object() override;
+    bool start_array(std::size_t) override;
+    bool end_array() override;
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        return fail(ex.what());
+    }
+
+    /// Resolve references and generate populations once the whole file is read
+    std::unique_ptr<SystemData> finish(std::string& error);
+    const std::string& getError() const { return m_error; }
+
+private:
+    bool fail(const std::string& message) {
+        if (m_error.empty()) m_error = message;
+        return false;
+    }
+    bool cancelled() const { return m_control && m_control->isCancelled(); }
+    Context top() const { return m_stack.back().context; }
+    bool is(const char* key) const { return m_key == key; }
+    void push(Context context) { m_stack.push_back(Frame{context}); }
+    void pushNumbers(std::initializer_list<float*> targets) {
+        Frame frame{Context::Numbers};
+        std::copy(targets.begin(), targets.end(), frame.targets.begin());
+        frame.count = targets.size();
+        m_stack.push_back(frame);
+    }
+    bool number(double value);
+    bool finishBody();
+
+    std::unique_ptr<SystemData> m_data;
+    LoadControl* m_control;
+    const DerivedData* m_derived;
+    std::vector<Frame> m_stack;
+    std::string m_key;
+    std::string m_error;
+    std::vector<BodySpec> m_bodies;
+    std::vector<PopulationSpec> m_populations;
+    std::vector<SwarmSpec> m_swarms;
+    std::vector<CatalogSpec> m_catalogs;
+    bool m_hasName = false;
+    bool m_hasSystemScale = false;
+    bool m_hasPlanetScale = false;
+    bool m_hasBodies = false;
+};
+
+bool SystemSaxHandler::number(double value) {
+    if (m_stack.empty()) return fail("System file must contain a JSON object");
+    
+    switch (top()) {
+        case Context::Numbers: {
+            Frame& frame = m_stack.back();
+            if (frame.index >= frame.count) return fail("Too many components in '" + m_key + "'");
+            *frame.targets[frame.index++] = static_cast<float>(value);
+            break;
+        }
+        case Context::Scale:
+            if (is("system")) { m_data->systemScale = static_cast<float>(value); m_hasSystemScale = true; }
+            else if (is("planet")) { m_data->planetScale = static_cast<float>(value); m_hasPlanetScale = true; }
+            break;
+        case Context::Body: {
+            BodySpec& body = m_bodies.back();
+            if (is("radius")) { body.radius = value; body.fields |= FIELD_RADIUS; }
+            else if (is("mass")) { body.mass = value; body.hasMass = true; }
+            break;
+        }
+        case Context::Orbit: {
+            BodySpec& body = m_bodies.back();
+            OrbitalParams& orbit = body.orbit;
+            uint32_t field = FIELD_ORBIT;
+            if (is("semiMajorAxis")) orbit.semiMajorAxis = value;
+            else if (is("eccentricity")) { orbit.eccentricity = value; field <<= 1; }
+            else if (is("inclination")) { orbit.inclination = glm::radians(value); field <<= 2; }
+            else if (is("period")) { orbit.orbitalPeriod = value; field <<= 3; }
+            else if (is("meanAnomaly")) { orbit.meanAnomaly0 = glm::radians(value); field <<= 4; }
+            else if (is("longitudeAscendingNode")) { orbit.longitudeAscendingNode = glm::radians(value); field <<= 5; }
+            else if (is("argumentPeriapsis")) { orbit.argumentPeriapsis = glm::radians(value); field <<= 6; }
+            else field = 0;
+            body.fields |= field;
+            break;
+        }
+        case Context::Population: {
+            PopulationSpec& spec = m_populations.back();
+            if (is("pointSize")) spec.population.pointSize = static_cast<float>(value);
+            else if (is("opacity")) spec.population.opacity = static_cast<float>(value);
+            else if (is("count")) { spec.count = static_cast<size_t>(value); spec.hasCount = true; }
+            else if (is("seed")) spec.seed = static_cast<uint32_t>(value);
+            break;
+        }
+        case Context::Distribution:
+            if (is("centralMass")) m_populations.back().distribution.centralMass = value;
+            break;
+        case Context::Catalog:
+            if (is("maxBodies")) m_catalogs.back().options.maxBodies = static_cast<size_t>(value);
+            break;
+        case Context::Swarm: {
+            SwarmSpec& spec = m_swarms.back();
+            TestParticleSwarm& swarm = spec.swarm;
+            if (is("count")) { swarm.count = static_cast<size_t>(value); spec.hasCount = true; }
+            else if (is("seed")) swarm.seed = static_cast<uint32_t>(value);
+            else if (is("innerRadius")) swarm.innerRadius = static_cast<float>(value);
+            else if (is("outerRadius")) swarm.outerRadius = static_cast<float>(value);
+            else if (is("thickness")) swarm.thickness = static_cast<float>(value);
+            else if (is("captureRadius")) swarm.captureRadius = static_cast<float>(value);
+            else if (is("pointSize")) swarm.pointSize = static_cast<float>(value);
+            else if (is("opacity")) swarm.opacity = static_cast<float>(value);
+            break;
+        }
+        default:
+            break;
+    }
+    return true;
+}
+
+bool SystemSaxHandler::string(json::string_t& value) {
+    if (m_stack.empty()) return fail("System file must contain a JSON object");
+    
+    switch (top()) {
+        case Context::Numbers:
+            return fail("Expected a number in '" + m_key + "'");
+        case Context::Root:
+            if (is("name")) { m_data->name = std::move(value); m_hasName = true; }
+            break;
+        case Context::Body: {
+            BodySpec& body = m_bodies.back();
+            if (is("name")) { body.name = std::move(value); body.fields |= FIELD_NAME; }
+            else if (is("type")) { body.type = parseBodyType(value); body.hasType = true; }
+            break;
+        }
+        case Context::Population: {
+            PopulationSpec& spec = m_populations.back();
+            if (is("name")) spec.population.name = std::move(value);
+            else if (is("parent")) spec.population.parentName = std::move(value);
+            else if (is("file")) spec.file = std::move(value);
+            break;
+        }
+        case Context::Swarm: {
+            TestParticleSwarm& swarm = m_swarms.back().swarm;
+            if (is("name")) swarm.name = std::move(value);
+            else if (is("parent")) swarm.parentName = std::move(value);
+            break;
+        }
+        case Context::Catalog: {
+            CatalogSpec& spec = m_catalogs.back();
+            if (is("file")) {
+                spec.file = std::move(value);
+            } else if (is("format") && !CatalogImporter::parseFormat(value, spec.options.format)) {
+                return fail("Unknown catalog format '" + value + "'");
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return true;
+}
+
+bool SystemSaxHandler::start_object(std::size_t) {
+    if (m_stack.empty()) {
+        push(Context::Root);
+        return true;
+    }
+    
+    switch (top()) {
+        case Context::Root:
+            push(is("scale") ? Context::Scale : Context::Skip);
+            break;
+        case Context::Bodies:
+            push(Context::Body);
+            m_bodies.emplace_back();
+            break;
+        case Context::Body:
+            push(is("orbit") ? Context::Orbit : Context::Skip);
+            break;
+        case Context::Populations:
+            push(Context::Population);
+            m_populations.emplace_back();
+            break;
+        case Context::Population:
+            if (is("distribution")) {
+                push(Context::Distribution);
+                m_populations.back().hasDistribution = true;
+            } else {
+                push(Context::Skip);
+            }
+            break;
+        case Context::Swarms:
+            push(Context::Swarm);
+            m_swarms.emplace_back();
+            break;
+        case Context::Catalogs:
+            push(Context::Catalog);
+            m_catalogs.emplace_back();
+            break;
+        case Context::Numbers:
+            return fail("Expected a number in '" + m_key + "'");
+        default:
+            push(Context::Skip);
+            break;
+    }
+    return true;
+}
+
+bool SystemSaxHandler::end_object() {
+    if (cancelled()) return fail("Cancelled");
+    Context context = top();
+    m_stack.pop_back();
+    
+    switch (context) {
+        case Context::Body:
+            return finishBody();
+        case Context::Population: {
+            const PopulationSpec& spec = m_populations.back();
+            if (spec.population.name.empty()) return fail("Population is missing 'name'");
+            if (spec.file.empty() && (!spec.hasDistribution || !spec.hasCount)) {
+                return fail("Population '" + spec.population.name + "' needs a 'file' or a 'distribution' and 'count'");
+            }
+            break;
+        }
+        case Context::Swarm: {
+            const SwarmSpec& spec = m_swarms.back();
+            if (spec.swarm.name.empty() || !spec.hasCount) {
+                return fail("Test particle swarm '" + spec.swarm.name + "' needs a 'name' and 'count'");
+            }
+            break;
+        }
+        case Context::Catalog:
+            if (m_catalogs.back().file.empty()) return fail("Catalog is missing 'file'");
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+bool SystemSaxHandler::start_array(std::size_t) {
+    if (m_stack.empty()) return fail("System file must contain a JSON object");
+    
+    switch (top()) {
+        case Context::Root:
+            if (is("bodies")) { push(Context::Bodies); m_hasBodies = true; }
+            else if (is("populations")) push(Context::Populations);
+            else if (is("testParticles")) push(Context::Swarms);
+            else if (is("catalogs")) push(Context::Catalogs);
+            else push(Context::Skip);
+            break;
+        case Context::Body: {
+            BodySpec& body = m_bodies.back();
+            if (is("children")) {
+                push(Context::Bodies);
+            } else if (is("color")) {
+                pushNumbers({&body.color.x, &body.color.y, &body.color.z});
+                body.fields |= FIELD_COLOR;
+            } else {
+                push(Context::Skip);
+            }
+            break;
+        }
+        case Context::Population: {
+            glm::vec3& color = m_populations.back().population.color;
+            if (is("color")) pushNumbers({&color.x, &color.y, &color.z});
+            else push(Context::Skip);
+            break;
+        }
+        case Context::Distribution: {
+            ParticleDistribution& dist = m_populations.back().distribution;
+            ParticleRange* range = nullptr;
+            if (is("semiMajorAxis")) range = &dist.semiMajorAxis;
+            else if (is("eccentricity")) range = &dist.eccentricity;
+            else if (is("inclination")) range = &dist.inclination;
+            else if (is("longitudeAscendingNode")) range = &dist.longitudeAscendingNode;
+            else if (is("argumentPeriapsis")) range = &dist.argumentPeriapsis;
+            else if (is("meanAnomaly")) range = &dist.meanAnomaly;
+            else if (is("size")) range = &dist.size;
+            if (range) pushNumbers({&range->min, &range->max});
+            else push(Context::Skip);
+            break;
+        }
+        case Context::Swarm: {
+            glm::vec3& color = m_swarms.back().swarm.color;
+            if (is("color")) pushNumbers({&color.x, &color.y, &color.z});
+            else push(Context::Skip);
+            break;
+        }
+        case Context::Numbers:
+            return fail("Expected a number in '" + m_key + "'");
+        default:
+            push(Context::Skip);
+            break;
+    }
+    return true;
+}
+
+bool SystemSaxHandler::end_array() {
+    Frame frame = m_stack.back();
+    m_stack.pop_back();
+    if (frame.context == Context::Numbers && frame.index != frame.count) {
+        return fail("Expected " + std::to_string(frame.count) + " numbers in '" + m_key + "'");
+    }
+    return true;
+}
+
+bool SystemSaxHandler::finishBody() {
+    BodySpec spec = std::move(m_bodies.back());
+    m_bodies.pop_back();
+    
+    if ((spec.fields & BODY_REQUIRED) != BODY_REQUIRED) {
+        for (uint32_t i = 0; i < std::size(BODY_FIELDS); ++i) {
+            if (!(spec.fields & (1u << i))) {
+                return fail("Body '" + spec.name + "' is missing '" + BODY_FIELDS[i] + "'");
+            }
+        }
+    }
+    
+    // Bodies still open on the stack are this body's ancestors
+    bool isChild = !m_bodies.empty();
+    BodyType type = spec.hasType ? spec.type : (isChild ? BodyType::Moon : BodyType::Planet);
+    auto body = m_data->arena->create(spec.name, spec.radius, spec.color, spec.orbit, type);
+    // Estimate the mass from the radius if not provided
+    body->setMass(spec.hasMass ? spec.mass : spec.radius * spec.radius * spec.radius);
+    body->reserveChildren(spec.children.size());
+    for (auto& child : spec.children) {
+        body->addChild(std::move(child));
+    }
+    
+    if (isChild) {
+        m_bodies.back().children.push_back(std::move(body));
+    } else {
+        m_data->bodies.push_back(std::move(body));
+    }
+    return true;
+}
+
+std::unique_ptr<SystemData> SystemSaxHandler::finish(std::string& error) {
+    if (!m_hasName || !m_hasSystemScale || !m_hasPlanetScale || !m_hasBodies) {
+        error = "System file needs 'name', 'scale.system', 'scale.planet' and 'bodies'";
+        return nullptr;
+    }
+    const auto& bodies = m_data->bodies;
+    
+    // Small-body catalogs become children of the star
+    for (CatalogSpec& spec : m_catalogs) {
+        spec.options.control = m_control;
+        if (!CatalogImporter::import(spec.file, *m_data, spec.options)) {
+            if (cancelled()) {
+                error = "Cancelled";
+                return nullptr;
+            }
+            LOG_WARN("SystemLoader", "Skipping catalog ", spec.file);
+        }
+    }
+    
+    // Lightweight particle groups (asteroid belts, rings)
+    for (size_t i = 0; i < m_populations.size(); ++i) {
+        if (cancelled()) {
+            error = "Cancelled";
+            return nullptr;
+        }
+        if (m_control) {
+            float fraction = static_cast<float>(i) / static_cast<float>(m_populations.size());
+            m_control->report(PARSE_PROGRESS_SHARE + (1.0f - PARSE_PROGRESS_SHARE) * fraction);
+        }
+        PopulationSpec& spec = m_populations[i];
+        ParticlePopulation& population = spec.population;
+        if (!population.parentName.empty()) {
+            population.parent = findBodyByName(bodies, population.parentName);
+            if (!population.parent) {
+                LOG_WARN("SystemLoader", "Population '", population.name, "' parent '",
+                         population.parentName, "' not found, orbiting the origin");
+            }
+        }
+        if (!spec.file.empty()) {
+            // Precomputed elements (e.g. converted from a survey catalog)
+            ParticleGenerator::loadFile(spec.file, population.elements);
+        } else if (m_derived && m_derived->hasPopulation(i) &&
+                   m_derived->getPopulationElements(i).size() == spec.count) {
+            auto cached = m_derived->getPopulationElements(i);
+            population.elements.assign(cached.begin(), cached.end());
+            population.generated = true;
+        } else {
+            population.elements = ParticleGenerator::generate(spec.distribution, spec.count, spec.seed);
+            population.generated = true;
+        }
+        m_data->populations.push_back(std::move(population));
+    }
+    
+    // Massless swarms integrated on the GPU in N-body mode
+    for (SwarmSpec& spec : m_swarms) {
+        TestParticleSwarm& swarm = spec.swarm;
+        if (!swarm.parentName.empty()) {
+            swarm.parent = findBodyByName(bodies, swarm.parentName);
+        }
+        if (!swarm.parent && !bodies.empty()) {
+            swarm.parent = bodies[0].get();
+        }
+        m_data->testParticles.push_back(std::move(swarm));
+    }
+    
+    return std::move(m_data);
+}
+
+} // namespace
+
+std::unique_ptr<SystemData> SystemStreamParser::parse(const char* begin, const char* end, std::string& error,
+                                                      LoadControl* control, const DerivedData* derived) {
+    SystemSaxHandler handler(control, derived);
+    try {
+        bool parsed = false;
+        if (control) {
+            float scale = PARSE_PROGRESS_SHARE / static_cast<float>(std::max<std::ptrdiff_t>(end - begin, 1));
+            parsed = json::sax_parse(ProgressIterator{begin, begin, scale, control},
+                                     ProgressIterator{end, begin, scale, control}, &handler);
+        } else {
+            parsed = json::sax_parse(begin, end, &handler);
+        }
+        if (!parsed) {
+            error = handler.getError().empty() ? "Malformed system file" : handler.getError();
+            return nullptr;
+        }
+    } catch (const json::exception& e) {
+        error = e.what();
+        return nullptr;
+    }
+    return handler.finish(error);
+}
+
+} // namespace Simulation
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "SystemLoader.hpp"
+#include <memory>
+#include <string>
+
+namespace Simulation {
+
+class DerivedData;
+
+/// Event-driven (SAX) parser for system JSON.
+///
+/// Bodies are built directly from the token stream: no JSON DOM is created and
+/// no subtrees are copied, so peak memory stays proportional to the resulting
+/// SystemData rather than a multiple of the file size. Unknown keys are skipped.
+/// Populations and catalogs are resolved once the whole file has been read,
+/// so they may reference bodies declared anywhere in the file.
+class SystemStreamParser {
+public:
+    /// Parse [begin, end). Returns nullptr and sets `error` on malformed input,
+    /// missing required fields or cancellation through `control`.
+    /// Generated populations are copied from `derived` when it holds them.
+    static std::unique_ptr<SystemData> parse(const char* begin, const char* end, std::string& error,
+                                             LoadControl* control = nullptr,
+                                             const DerivedData* derived = nullptr);
+};
+
+} // namespace Simulation
@@ -0,0 +1,81 @@
+// sysgen - writes seeded procedural systems for stress and scaling tests
+#include "simulation/CompiledSystem.hpp"
+#include "simulation/SystemGenerator.hpp"
+#include "core/Logger.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options] -o out.json|out.ssb\n"
+                  << "  -o FILE              Output; .ssb writes a compiled system, anything else JSON\n"
+                  << "  --seed N             Random seed (default 1)\n"
+                  << "  --name NAME          System name (default \"Generated <seed>\")\n"
+                  << "  --bodies N           Exactly N bodies: ~sqrt(N) planets, the rest moons\n"
+                  << "  --planets N          Planet count (default 8)\n"
+                  << "  --moons X            Average moons per planet (default 2)\n"
+                  << "  --belts N            Particle belts (default 1)\n"
+                  << "  --belt-particles N   Particles per belt (default 100000)\n"
+                  << "  --test-particles N   Test particles in a swarm around the star (default 0)\n"
+                  << "  --star-mass M        Star mass in solar masses (default 1)\n"
+                  << "  --help               Show this message\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string outputPath;
+    Simulation::GeneratorOptions options;
+    size_t bodyCount = 0;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(arg, "-o") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--name") == 0 && hasValue) {
+            options.name = argv[++i];
+        } else if (std::strcmp(arg, "--bodies") == 0 && hasValue) {
+            bodyCount = static_cast<size_t>(std::atoll(argv[++i]));
+        } else if (std::strcmp(arg, "--planets") == 0 && hasValue) {
+            options.planetCount = static_cast<size_t>(std::atoll(argv[++i]));
+        } else if (std::strcmp(arg, "--moons") == 0 && hasValue) {
+            options.moonsPerPlanet = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--belts") == 0 && hasValue) {
+            options.beltCount = static_cast<size_t>(std::atoll(argv[++i]));
+        } else if (std::strcmp(arg, "--belt-particles") == 0 && hasValue) {
+            options.particlesPerBelt = static_cast<size_t>(std::atoll(argv[++i]));
+        } else if (std::strcmp(arg, "--test-particles") == 0 && hasValue) {
+            options.testParticleCount = static_cast<size_t>(std::atoll(argv[++i]));
+        } else if (std::strcmp(arg, "--star-mass") == 0 && hasValue) {
+            options.starMass = std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown or incomplete argument: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    if (outputPath.empty() || options.starMass <= 0.0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    
+    // --bodies sets the planet / moon split and keeps the other options
+    if (bodyCount > 0) {
+        Simulation::GeneratorOptions counts = Simulation::SystemGenerator::forBodyCount(bodyCount, options.seed);
+        options.planetCount = counts.planetCount;
+        options.moonsPerPlanet = counts.moonsPerPlanet;
+    }
+    
+    bool compiled = std::filesystem::path(outputPath).extension() == Simulation::CompiledSystem::FILE_EXTENSION;
+    bool written = compiled ? Simulation::SystemGenerator::writeCompiled(options, outputPath)
+                            : Simulation::SystemGenerator::writeJson(options, outputPath);
+    return written ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// systemc - compiles JSON system descriptions and small-body catalogs into
+// memory-mappable .ssb files
+#include "simulation/CatalogImporter.hpp"
+#include "simulation/CompiledSystem.hpp"
+#include "simulation/SystemLoader.hpp"
+#include "core/Logger.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options] system.json...\n"
+                  << "       " << program << " --catalog FILE [--catalog FILE...] [base.json] -o out.ssb\n"
+                  << "  -o FILE            Output path (single input only; default: input with .ssb)\n"
+                  << "  --catalog FILE     Import an MPC / JPL element catalog under the star\n"
+                  << "  --format F         Catalog format: auto (default), mpc, jpl or csv\n"
+                  << "  --max N            Import at most N bodies per catalog\n"
+                  << "  --threads N        Catalog parser threads (default: all cores)\n"
+                  << "  --help             Show this message\n";
+    }
+
+    bool write(const Simulation::SystemData& data, const std::string& outputPath) {
+        if (!Simulation::CompiledSystem::write(data, outputPath)) {
+            return false;
+        }
+
+        // Round-trip through the loader's validation so a bad file never ships
+        Simulation::CompiledSystem compiled;
+        if (!compiled.open(outputPath)) {
+            LOG_ERROR("systemc", "Compiled file failed validation: ", outputPath);
+            return false;
+        }
+
+        std::error_code error;
+        LOG_INFO("systemc", "Wrote ", outputPath, " (", compiled.getBodyCount(), " bodies, ",
+                 std::filesystem::file_size(outputPath, error), " bytes)");
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string outputPath;
+    std::vector<std::string> inputs;
+    std::vector<std::string> catalogs;
+    Simulation::CatalogImportOptions catalogOptions;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (std::strcmp(arg, "-o") == 0 && hasValue) {
+            outputPath = argv[++i];
+        } else if (std::strcmp(arg, "--catalog") == 0 && hasValue) {
+            catalogs.emplace_back(argv[++i]);
+        } else if (std::strcmp(arg, "--format") == 0 && hasValue) {
+            if (!Simulation::CatalogImporter::parseFormat(argv[++i], catalogOptions.format)) {
+                std::cerr << "Invalid catalog format: " << argv[i] << "\n";
+                return 1;
+            }
+        } else if (std::strcmp(arg, "--max") == 0 && hasValue) {
+            catalogOptions.maxBodies = static_cast<size_t>(std::atoll(argv[++i]));
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            catalogOptions.threadCount = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg[0] == '-') {
+            std::cerr << "Unknown or incomplete argument: " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            inputs.emplace_back(arg);
+        }
+    }
+
+    // Catalog mode: one output built from an optional base system plus the catalogs
+    if (!catalogs.empty()) {
+        if (outputPath.empty() || inputs.size() > 1) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        auto data = inputs.empty() ? std::make_unique<Simulation::SystemData>()
+                                   : Simulation::SystemLoader::loadFromJson(inputs[0]);
+        if (!data) {
+            return 1;
+        }
+        for (const std::string& catalog : catalogs) {
+            if (!Simulation::CatalogImporter::import(catalog, *data, catalogOptions)) {
+                LOG_ERROR("systemc", "Failed to import ", catalog);
+                return 1;
+            }
+        }
+        return write(*data, outputPath) ? 0 : 1;
+    }
+
+    if (inputs.empty() || (!outputPath.empty() && inputs.size() != 1)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int exitCode = 0;
+    for (const std::string& input : inputs) {
+        std::string output = outputPath.empty() ? Simulation::SystemLoader::getCompiledPath(input) : outputPath;
+        auto data = Simulation::SystemLoader::loadFromJson(input);
+        if (!data || !write(*data, output)) {
+            LOG_ERROR("systemc", "Failed to compile ", input);
+            exitCode = 1;
+        }
+    }
+    return exitCode;
+}